@@ -11,6 +11,14 @@
 // the AVL tree acts like a binary search tree (e.g., it will become
 // degenerate if elements are added in ascending order).
 //
+// Elements are ordered by a three-way comparison (see SetCompare.hpp),
+// which, by default, uses their own == and < operators.
+//
+// Each node also points to its parent, so that an Iterator can move from
+// one element to the next without keeping a stack of the nodes above it;
+// visiting k consecutive elements, starting from one found by a search,
+// takes O(log n + k) time.
+//
 // You are not permitted to use the containers in the C++ Standard Library
 // (such as std::set, std::map, or std::vector) to store the information
 // in your data structure.  Instead, you'll need to implement your AVL tree
@@ -20,14 +28,23 @@
 #ifndef AVLSET_HPP
 #define AVLSET_HPP
 
+#include <algorithm>
+#include <cstddef>
 #include <memory>
 #include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include "Set.hpp"
+#include "SetCompare.hpp"
+#include "SetLookupKey.hpp"
+#include "SetRange.hpp"
 #include <iostream>
 
 
 
-template <typename ElementType>
+template <typename ElementType, typename Compare = SetCompare<ElementType>>
 class AVLSet : public Set<ElementType>
 {
 public:
@@ -35,9 +52,15 @@ public:
     // ElementType and returns no value.
     using VisitFunction = std::function<void(const ElementType&)>;
 
+    // An Iterator visits the elements of the set in ascending order.  It
+    // can't change them, since that could change where they belong in the
+    // tree.  Iterators are valid until the set is next changed.
+    class Iterator;
+
 public:
-    // Initializes an AVLSet to be empty, with or without balancing.
-    explicit AVLSet(bool shouldBalance = true);
+    // Initializes an AVLSet to be empty, with or without balancing, and
+    // ordered by the given comparison.
+    explicit AVLSet(bool shouldBalance = true, Compare compare = Compare{});
 
     // Cleans up the AVLSet so that it leaks no memory.
     ~AVLSet() noexcept override;
@@ -56,6 +79,17 @@ public:
     AVLSet& operator=(AVLSet&& s) noexcept;
 
 
+    // fromSorted() returns a balanced AVLSet containing the elements in the
+    // range from first to last, which should be in ascending order.  Rather
+    // than adding them one at a time, it builds a perfectly balanced tree
+    // around the middle element of the range, then the middle of each
+    // half, and so on, in O(n) time, with no searches and no rotations.
+    // Elements equal to the one before them are skipped, and any that are
+    // out of order are added afterward, as add() would add them.
+    template <typename InputIterator>
+    static AVLSet fromSorted(InputIterator first, InputIterator last, Compare compare = Compare{});
+
+
     // isImplemented() should be modified to return true if you've
     // decided to implement an AVLSet, false otherwise.
     bool isImplemented() const noexcept override;
@@ -66,16 +100,83 @@ public:
     // when there are n elements in the AVL tree.
     void add(const ElementType& element) override;
 
+    // This overload of add() moves the given element into the set, rather
+    // than copying it, if it's not already there.
+    void add(ElementType&& element);
+
+    // emplace() builds an element from the given arguments, then adds it
+    // as add() does.
+    template <typename... Args>
+    void emplace(Args&&... args);
+
 
     // contains() returns true if the given element is already in the set,
     // false otherwise.  This function always runs in O(log n) time when
     // there are n elements in the AVL tree.
     bool contains(const ElementType& element) const override;
 
+    // This overload of contains() compares a lightweight view of an
+    // element (see SetLookupKey.hpp) against the tree's elements directly,
+    // without converting it to an ElementType.
+    template <typename Key, typename = std::enable_if_t<IsSetLookupKey<ElementType, Key>>>
+    bool contains(const Key& key) const;
+
+
+    // remove() removes the given element from the set, returning true if
+    // it was there and false if it wasn't.  A node with two children is
+    // replaced by the node holding the next element (the leftmost in its
+    // right subtree), which is relinked rather than copied, so Iterators
+    // to other elements stay valid.  If balancing is on, the tree is
+    // rebalanced on the way back up from the removed node, with at most
+    // one rotation per level, so this function always runs in O(log n)
+    // time.
+    bool remove(const ElementType& element);
+
+    template <typename Key, typename = std::enable_if_t<IsSetLookupKey<ElementType, Key>>>
+    bool remove(const Key& key);
+
 
     // size() returns the number of elements in the set.
     unsigned int size() const noexcept override;
 
+    // version() returns a number that changes whenever the set's elements
+    // do: when add() adds one, remove() removes one, or the set is
+    // assigned to.  Something that remembers what it found in the set,
+    // such as a SuggestionCache, can use it to tell when that's stale.
+    unsigned long long version() const noexcept;
+
+
+    // begin() returns an Iterator to the smallest element in the set, and
+    // end() returns the Iterator that follows the largest one.
+    Iterator begin() const;
+    Iterator end() const;
+
+
+    // lowerBound() returns an Iterator to the smallest element that is not
+    // less than the given one, and upperBound() an Iterator to the smallest
+    // element that is greater than it, or end() if there isn't one.  Both
+    // run in O(log n) time, and both have overloads that take a lightweight
+    // view of an element (see SetLookupKey.hpp).
+    Iterator lowerBound(const ElementType& element) const;
+
+    template <typename Key, typename = std::enable_if_t<IsSetLookupKey<ElementType, Key>>>
+    Iterator lowerBound(const Key& key) const;
+
+    Iterator upperBound(const ElementType& element) const;
+
+    template <typename Key, typename = std::enable_if_t<IsSetLookupKey<ElementType, Key>>>
+    Iterator upperBound(const Key& key) const;
+
+
+    // range() returns the elements that are at least lo but less than hi,
+    // in ascending order (or none, if hi isn't greater than lo).  Finding
+    // the first of them takes O(log n) time, and visiting all k of them
+    // takes O(k) more.
+    SetRange<Iterator> range(const ElementType& lo, const ElementType& hi) const;
+
+    template <typename Key, typename = std::enable_if_t<IsSetLookupKey<ElementType, Key>>>
+    SetRange<Iterator> range(const Key& lo, const Key& hi) const;
+
 
     // height() returns the height of the AVL tree.  Note that, by definition,
     // the height of an empty tree is -1.
@@ -110,11 +211,14 @@ private:
         Node* left = nullptr;
         Node* right = nullptr;
         int height;
+        Node* parent = nullptr;
     };
 
     int tree_height;
     int count;
+    unsigned long long version_number = 0;
     bool balanced;
+    Compare compare;
 
     Node* root; 
 
@@ -144,15 +248,46 @@ private:
 
     void m_inorder(Node* base, VisitFunction visit) const;
 
-    bool search(const ElementType& element, Node* base) const;
+    template <typename Key>
+    bool search(const Key& key, Node* base) const;
+
+    template <typename Key>
+    const Node* lower_bound_node(const Key& key) const;
+
+    template <typename Key>
+    const Node* upper_bound_node(const Key& key) const;
+
+    static const Node* successor(const Node* node) noexcept;
+
+    static void adopt_children(Node* node) noexcept;
+
+    template <typename E>
+    void add_element(E&& element);
 
-    int add_node(const ElementType& element, Node*& base);
+    template <typename E>
+    int add_node(E&& element, Node*& base);
 
     int get_balanced_factor(Node* base);
 
     int get_height(Node* base);
 
-    int reset_heights(Node* base);
+
+    void build_balanced(Node*& base, Node* parent, ElementType* first, ElementType* last);
+
+    template <typename Key>
+    bool remove_node(const Key& key, Node*& base);
+
+    Node* detach_min(Node*& base);
+
+    int height_of(const Node* base) const noexcept;
+
+    void update_height(Node* base) noexcept;
+
+    void update_rotated_heights(Node* base) noexcept;
+
+    void rebalance(Node*& base) noexcept;
+
+    void update_tree_height() noexcept;
 
 //inline functions
 //gives error when I try to write definition outside of class
@@ -164,6 +299,9 @@ private:
         Node* lr = r->left;
         r->left = lr->right;
         lr->right = r;
+        lr->parent = r->parent;
+        adopt_children(r);
+        adopt_children(lr);
         return lr;
     }
 
@@ -173,6 +311,9 @@ private:
         Node* rr = r->right;
         r->right = rr->left;
         rr->left = r;
+        rr->parent = r->parent;
+        adopt_children(r);
+        adopt_children(rr);
         return rr; 
     }
 
@@ -185,6 +326,10 @@ private:
         rr->left = rrl->right;
         rrl->left = r;
         rrl->right = rr;
+        rrl->parent = r->parent;
+        adopt_children(r);
+        adopt_children(rr);
+        adopt_children(rrl);
         return rrl; 
     }
 
@@ -197,45 +342,60 @@ private:
         rl->right = rlr->left;
         rlr->right = r;
         rlr->left = rl;
+        rlr->parent = r->parent;
+        adopt_children(r);
+        adopt_children(rl);
+        adopt_children(rlr);
         return rlr; 
     }
 
-    Node* balanced_add(const ElementType& element, Node*& base)
+    template <typename E>
+    Node* balanced_add(E&& element, Node*& base)
     {
         if(base == nullptr)
         {
-            base = new Node{element, nullptr, nullptr, 1};
+            base = new Node{std::forward<E>(element), nullptr, nullptr, 1};
+            count++;
+            version_number++;
             return base;
         }
-        else if(element > base->value) //right
+
+        int order = compare(element, base->value);
+        if(order > 0) //right
         {
-            base->right = balanced_add(element, base->right);
+            base->right = balanced_add(std::forward<E>(element), base->right);
+            base->right->parent = base;
         }
-        else //left
+        else if(order < 0) //left
         {
-            base->left = balanced_add(element, base->left);
+            base->left = balanced_add(std::forward<E>(element), base->left);
+            base->left->parent = base;
+        }
+        else //already in the set
+        {
+            return base;
         }
         base->height = get_height(base);
 
         if((get_balanced_factor(base) == 2) && (get_balanced_factor(base->left)==1))
         {
             base = LLrotation(base);
-            base->height = reset_heights(base);
+            update_rotated_heights(base);
         }
         else if((get_balanced_factor(base) == -2) && (get_balanced_factor(base->right) == -1))
         {
             base = RRrotation(base);
-            base->height = reset_heights(base);
+            update_rotated_heights(base);
         }
         else if((get_balanced_factor(base) == -2) && (get_balanced_factor(base->right) == 1))
         {
             base = RLrotation(base);
-            base->height = reset_heights(base);
+            update_rotated_heights(base);
         }
         else if((get_balanced_factor(base)) == 2 && (get_balanced_factor(base->left) == -1))
         {
             base = LRrotation(base);
-            base->height = reset_heights(base);
+            update_rotated_heights(base);
         }        
 
         return base;
@@ -249,6 +409,7 @@ private:
             writer = new_node;
             writer->left = copy_tree(writer->left, reader->left);
             writer->right = copy_tree(writer->right, reader->right);
+            adopt_children(writer);
         }
         else
         {
@@ -259,25 +420,86 @@ private:
 
 };
 
+
+
+template <typename ElementType, typename Compare>
+class AVLSet<ElementType, Compare>::Iterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = ElementType;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const ElementType*;
+    using reference = const ElementType&;
+
+    Iterator() noexcept
+        : node{nullptr}
+    {
+    }
+
+    reference operator*() const
+    {
+        return node->value;
+    }
+
+    pointer operator->() const
+    {
+        return &node->value;
+    }
+
+    Iterator& operator++() noexcept
+    {
+        node = successor(node);
+        return *this;
+    }
+
+    Iterator operator++(int) noexcept
+    {
+        Iterator old = *this;
+        node = successor(node);
+        return old;
+    }
+
+    bool operator==(const Iterator& other) const noexcept
+    {
+        return node == other.node;
+    }
+
+    bool operator!=(const Iterator& other) const noexcept
+    {
+        return node != other.node;
+    }
+
+private:
+    friend class AVLSet;
+
+    explicit Iterator(const Node* node) noexcept
+        : node{node}
+    {
+    }
+
+    const Node* node;
+};
+
 //tree code
 
-template <typename ElementType>
-AVLSet<ElementType>::AVLSet(bool shouldBalance)
-    : tree_height{-1}, count{0}, balanced{shouldBalance}, root{nullptr}
+template <typename ElementType, typename Compare>
+AVLSet<ElementType, Compare>::AVLSet(bool shouldBalance, Compare compare)
+    : tree_height{-1}, count{0}, balanced{shouldBalance}, compare{std::move(compare)}, root{nullptr}
 {
 }
 
 
-template <typename ElementType>
-AVLSet<ElementType>::~AVLSet() noexcept
+template <typename ElementType, typename Compare>
+AVLSet<ElementType, Compare>::~AVLSet() noexcept
 {
     clear_all(root);
 }
 
 
-template <typename ElementType>
-AVLSet<ElementType>::AVLSet(const AVLSet& s)
-    : tree_height{s.tree_height}, count{s.count}, balanced{s.balanced}
+template <typename ElementType, typename Compare>
+AVLSet<ElementType, Compare>::AVLSet(const AVLSet& s)
+    : tree_height{s.tree_height}, count{s.count}, balanced{s.balanced}, compare{s.compare}
 {
     Node* copy_root = nullptr;
     copy_root = copy_tree(copy_root, s.root); 
@@ -285,110 +507,254 @@ AVLSet<ElementType>::AVLSet(const AVLSet& s)
 }
 
 
-template <typename ElementType>
-AVLSet<ElementType>::AVLSet(AVLSet&& s) noexcept
-    : tree_height{0}, count{0}, balanced{0}, root{nullptr}
+template <typename ElementType, typename Compare>
+AVLSet<ElementType, Compare>::AVLSet(AVLSet&& s) noexcept
+    : tree_height{0}, count{0}, balanced{0}, compare{s.compare}, root{nullptr}
 {
     std::swap(tree_height, s.tree_height);
     std::swap(count, s.count);
     std::swap(root, s.root);
     std::swap(balanced, s.balanced);
+    s.version_number++;
 }
 
 
-template <typename ElementType>
-AVLSet<ElementType>& AVLSet<ElementType>::operator=(const AVLSet& s)
+template <typename ElementType, typename Compare>
+AVLSet<ElementType, Compare>& AVLSet<ElementType, Compare>::operator=(const AVLSet& s)
 {
-    if(this == &s)
+    if(this != &s)
     {
-        tree_height = s.tree_height;
-        count = s.count;
         Node* copy_root = nullptr;
         copy_root = copy_tree(copy_root, s.root); 
+        tree_height = s.tree_height;
+        count = s.count;
         clear_all(root);
         root = copy_root;
         balanced = s.balanced;
+        compare = s.compare;
+        version_number++;
     }
     return *this;
 }
 
 
-template <typename ElementType>
-AVLSet<ElementType>& AVLSet<ElementType>::operator=(AVLSet&& s) noexcept
+template <typename ElementType, typename Compare>
+AVLSet<ElementType, Compare>& AVLSet<ElementType, Compare>::operator=(AVLSet&& s) noexcept
 {
     std::swap(tree_height, s.tree_height);
     std::swap(count, s.count);
     std::swap(root, s.root);
     std::swap(balanced, s.balanced);
+    std::swap(compare, s.compare);
+    version_number++;
+    s.version_number++;
     return *this;
 }
 
 
-template <typename ElementType>
-bool AVLSet<ElementType>::isImplemented() const noexcept
+template <typename ElementType, typename Compare>
+template <typename InputIterator>
+AVLSet<ElementType, Compare> AVLSet<ElementType, Compare>::fromSorted(
+    InputIterator first, InputIterator last, Compare compare)
 {
-    return true;
-}
-
+    AVLSet s{true, std::move(compare)};
 
-template <typename ElementType>
-void AVLSet<ElementType>::add(const ElementType& element)
-{
-    if(balanced)
+    std::vector<ElementType> sorted;
+    std::vector<ElementType> unsorted;
+    for(; first != last; ++first)
     {
-        root = balanced_add(element, root);
-        tree_height = root->height - 1;
+        int order = sorted.empty() ? 1 : s.compare(*first, sorted.back());
+        if(order > 0)
+            sorted.push_back(*first);
+        else if(order < 0)
+            unsorted.push_back(*first);
     }
-    else
+
+    s.build_balanced(s.root, nullptr, sorted.data(), sorted.data() + sorted.size());
+    if(s.root != nullptr)
+        s.tree_height = s.root->height - 1;
+
+    for(ElementType& element : unsorted)
     {
-        int new_height = add_node(element, root);
-        if(root->height < new_height)
-        {
-            root->height = new_height;
-        }
-        tree_height = root->height;
+        s.add_element(std::move(element));
     }
-    count++;
+
+    return s;
+}
+
+
+template <typename ElementType, typename Compare>
+bool AVLSet<ElementType, Compare>::isImplemented() const noexcept
+{
+    return true;
+}
+
+
+template <typename ElementType, typename Compare>
+void AVLSet<ElementType, Compare>::add(const ElementType& element)
+{
+    add_element(element);
+}
+
+
+template <typename ElementType, typename Compare>
+void AVLSet<ElementType, Compare>::add(ElementType&& element)
+{
+    add_element(std::move(element));
+}
+
+
+template <typename ElementType, typename Compare>
+template <typename... Args>
+void AVLSet<ElementType, Compare>::emplace(Args&&... args)
+{
+    add_element(ElementType(std::forward<Args>(args)...));
 }
 
 
-template <typename ElementType>
-bool AVLSet<ElementType>::contains(const ElementType& element) const
+template <typename ElementType, typename Compare>
+bool AVLSet<ElementType, Compare>::contains(const ElementType& element) const
 {
     return search(element, root);
 }
 
 
-template <typename ElementType>
-unsigned int AVLSet<ElementType>::size() const noexcept
+template <typename ElementType, typename Compare>
+template <typename Key, typename>
+bool AVLSet<ElementType, Compare>::contains(const Key& key) const
+{
+    return search(key, root);
+}
+
+
+template <typename ElementType, typename Compare>
+bool AVLSet<ElementType, Compare>::remove(const ElementType& element)
+{
+    bool removed = remove_node(element, root);
+    update_tree_height();
+    return removed;
+}
+
+
+template <typename ElementType, typename Compare>
+template <typename Key, typename>
+bool AVLSet<ElementType, Compare>::remove(const Key& key)
+{
+    bool removed = remove_node(key, root);
+    update_tree_height();
+    return removed;
+}
+
+
+template <typename ElementType, typename Compare>
+unsigned int AVLSet<ElementType, Compare>::size() const noexcept
 {
     return count;
 }
 
 
-template <typename ElementType>
-int AVLSet<ElementType>::height() const noexcept
+template <typename ElementType, typename Compare>
+unsigned long long AVLSet<ElementType, Compare>::version() const noexcept
+{
+    return version_number;
+}
+
+
+template <typename ElementType, typename Compare>
+typename AVLSet<ElementType, Compare>::Iterator AVLSet<ElementType, Compare>::begin() const
+{
+    const Node* node = root;
+    while(node != nullptr && node->left != nullptr)
+        node = node->left;
+    return Iterator{node};
+}
+
+
+template <typename ElementType, typename Compare>
+typename AVLSet<ElementType, Compare>::Iterator AVLSet<ElementType, Compare>::end() const
+{
+    return Iterator{};
+}
+
+
+template <typename ElementType, typename Compare>
+typename AVLSet<ElementType, Compare>::Iterator AVLSet<ElementType, Compare>::lowerBound(
+    const ElementType& element) const
+{
+    return Iterator{lower_bound_node(element)};
+}
+
+
+template <typename ElementType, typename Compare>
+template <typename Key, typename>
+typename AVLSet<ElementType, Compare>::Iterator AVLSet<ElementType, Compare>::lowerBound(
+    const Key& key) const
+{
+    return Iterator{lower_bound_node(key)};
+}
+
+
+template <typename ElementType, typename Compare>
+typename AVLSet<ElementType, Compare>::Iterator AVLSet<ElementType, Compare>::upperBound(
+    const ElementType& element) const
+{
+    return Iterator{upper_bound_node(element)};
+}
+
+
+template <typename ElementType, typename Compare>
+template <typename Key, typename>
+typename AVLSet<ElementType, Compare>::Iterator AVLSet<ElementType, Compare>::upperBound(
+    const Key& key) const
+{
+    return Iterator{upper_bound_node(key)};
+}
+
+
+template <typename ElementType, typename Compare>
+SetRange<typename AVLSet<ElementType, Compare>::Iterator> AVLSet<ElementType, Compare>::range(
+    const ElementType& lo, const ElementType& hi) const
+{
+    if(compare(lo, hi) >= 0)
+        return SetRange<Iterator>{end(), end()};
+    return SetRange<Iterator>{lowerBound(lo), lowerBound(hi)};
+}
+
+
+template <typename ElementType, typename Compare>
+template <typename Key, typename>
+SetRange<typename AVLSet<ElementType, Compare>::Iterator> AVLSet<ElementType, Compare>::range(
+    const Key& lo, const Key& hi) const
+{
+    if(compare(lo, hi) >= 0)
+        return SetRange<Iterator>{end(), end()};
+    return SetRange<Iterator>{lowerBound(lo), lowerBound(hi)};
+}
+
+
+template <typename ElementType, typename Compare>
+int AVLSet<ElementType, Compare>::height() const noexcept
 {
     return tree_height;
 }
 
 
-template <typename ElementType>
-void AVLSet<ElementType>::preorder(VisitFunction visit) const
+template <typename ElementType, typename Compare>
+void AVLSet<ElementType, Compare>::preorder(VisitFunction visit) const
 {
     m_preorder(root, visit);
 }
 
 
-template <typename ElementType>
-void AVLSet<ElementType>::inorder(VisitFunction visit) const
+template <typename ElementType, typename Compare>
+void AVLSet<ElementType, Compare>::inorder(VisitFunction visit) const
 {
     m_inorder(root, visit);
 }
 
 
-template <typename ElementType>
-void AVLSet<ElementType>::postorder(VisitFunction visit) const
+template <typename ElementType, typename Compare>
+void AVLSet<ElementType, Compare>::postorder(VisitFunction visit) const
 {
     m_postorder(root, visit);
 }
@@ -396,16 +762,16 @@ void AVLSet<ElementType>::postorder(VisitFunction visit) const
 
 //private functions
 
-template <typename ElementType>
-bool AVLSet<ElementType>::isLeaf(Node* node)
+template <typename ElementType, typename Compare>
+bool AVLSet<ElementType, Compare>::isLeaf(Node* node)
 {
     if((node->left == nullptr) && (node->right == nullptr))
         return true;
     return false; 
 }
 
-template <typename ElementType>
-void AVLSet<ElementType>::clear_all(Node* node)
+template <typename ElementType, typename Compare>
+void AVLSet<ElementType, Compare>::clear_all(Node* node)
 {
     if(node != nullptr)
     {
@@ -415,8 +781,8 @@ void AVLSet<ElementType>::clear_all(Node* node)
     }
 }
 
-template <typename ElementType>
-void AVLSet<ElementType>::m_preorder(Node* base, VisitFunction visit) const
+template <typename ElementType, typename Compare>
+void AVLSet<ElementType, Compare>::m_preorder(Node* base, VisitFunction visit) const
 {
     if(base != nullptr)
     {
@@ -426,8 +792,8 @@ void AVLSet<ElementType>::m_preorder(Node* base, VisitFunction visit) const
     }
 }
 
-template <typename ElementType>
-void AVLSet<ElementType>::m_postorder(Node* base, VisitFunction visit) const
+template <typename ElementType, typename Compare>
+void AVLSet<ElementType, Compare>::m_postorder(Node* base, VisitFunction visit) const
 {
     if(base != nullptr)
     {
@@ -437,8 +803,8 @@ void AVLSet<ElementType>::m_postorder(Node* base, VisitFunction visit) const
     }
 }
 
-template <typename ElementType>
-void AVLSet<ElementType>::m_inorder(Node* base, VisitFunction visit) const
+template <typename ElementType, typename Compare>
+void AVLSet<ElementType, Compare>::m_inorder(Node* base, VisitFunction visit) const
 {
     if(base != nullptr)
     {
@@ -448,38 +814,326 @@ void AVLSet<ElementType>::m_inorder(Node* base, VisitFunction visit) const
     }
 }
 
-template <typename ElementType>
-bool AVLSet<ElementType>::search(const ElementType& element, Node* base) const
+template <typename ElementType, typename Compare>
+template <typename Key>
+bool AVLSet<ElementType, Compare>::search(const Key& key, Node* base) const
 {
     if(base == nullptr)
         return false;
-    else if(base->value == element)
+
+    int order = compare(key, base->value);
+    if(order == 0)
         return true;
-    else if(element > base->value)
-        return search(element, base->right);
+    else if(order > 0)
+        return search(key, base->right);
     else
-        return search(element, base->left);
+        return search(key, base->left);
 }
 
-template <typename ElementType>
-int AVLSet<ElementType>::add_node(const ElementType& element, Node*& base)
+// lower_bound_node() returns the node with the smallest element that is
+// not less than the given key, or nullptr if there isn't one: the last
+// node on the path down from the root at which the search turned left.
+template <typename ElementType, typename Compare>
+template <typename Key>
+const typename AVLSet<ElementType, Compare>::Node* AVLSet<ElementType, Compare>::lower_bound_node(
+    const Key& key) const
+{
+    const Node* bound = nullptr;
+    for(const Node* node = root; node != nullptr; )
+    {
+        if(compare(node->value, key) >= 0)
+        {
+            bound = node;
+            node = node->left;
+        }
+        else
+        {
+            node = node->right;
+        }
+    }
+    return bound;
+}
+
+// upper_bound_node() is like lower_bound_node(), except that it skips
+// past an element equal to the key.
+template <typename ElementType, typename Compare>
+template <typename Key>
+const typename AVLSet<ElementType, Compare>::Node* AVLSet<ElementType, Compare>::upper_bound_node(
+    const Key& key) const
+{
+    const Node* bound = nullptr;
+    for(const Node* node = root; node != nullptr; )
+    {
+        if(compare(node->value, key) > 0)
+        {
+            bound = node;
+            node = node->left;
+        }
+        else
+        {
+            node = node->right;
+        }
+    }
+    return bound;
+}
+
+// successor() returns the node whose element follows the given node's,
+// or nullptr if there isn't one: the leftmost node in its right subtree,
+// if it has one, or else the nearest ancestor of which it's in the left
+// subtree.  Each edge is crossed at most twice during a full traversal,
+// so each step takes O(1) time on average.
+template <typename ElementType, typename Compare>
+const typename AVLSet<ElementType, Compare>::Node* AVLSet<ElementType, Compare>::successor(
+    const Node* node) noexcept
+{
+    if(node->right != nullptr)
+    {
+        node = node->right;
+        while(node->left != nullptr)
+            node = node->left;
+        return node;
+    }
+
+    while(node->parent != nullptr && node->parent->right == node)
+        node = node->parent;
+    return node->parent;
+}
+
+// adopt_children() points a node's children back at it, after it's been
+// given new ones.
+template <typename ElementType, typename Compare>
+void AVLSet<ElementType, Compare>::adopt_children(Node* node) noexcept
+{
+    if(node->left != nullptr)
+        node->left->parent = node;
+    if(node->right != nullptr)
+        node->right->parent = node;
+}
+
+// build_balanced() makes the middle of the given elements the root of a
+// subtree, stored in base, then builds its left and right subtrees from
+// the elements on either side of it.  Each node is linked into the tree as
+// soon as it's created, so if an allocation fails, the destructor cleans
+// up whatever has been built so far.  Heights are counted as balanced_add()
+// counts them, with a leaf's height being 1.
+template <typename ElementType, typename Compare>
+void AVLSet<ElementType, Compare>::build_balanced(
+    Node*& base, Node* parent, ElementType* first, ElementType* last)
+{
+    if(first == last)
+        return;
+
+    ElementType* middle = first + (last - first) / 2;
+    base = new Node{std::move(*middle), nullptr, nullptr, 1, parent};
+    count++;
+    version_number++;
+
+    build_balanced(base->left, base, first, middle);
+    build_balanced(base->right, base, middle + 1, last);
+    base->height = isLeaf(base) ? 1 : get_height(base);
+}
+
+// remove_node() removes the node holding the given key from the subtree
+// whose root is stored in base, storing the subtree's new root there, and
+// rebalances every subtree on the way back up that it removed a node from.
+template <typename ElementType, typename Compare>
+template <typename Key>
+bool AVLSet<ElementType, Compare>::remove_node(const Key& key, Node*& base)
+{
+    if(base == nullptr)
+        return false;
+
+    int order = compare(key, base->value);
+    if(order < 0) //left
+    {
+        if(!remove_node(key, base->left))
+            return false;
+        adopt_children(base);
+    }
+    else if(order > 0) //right
+    {
+        if(!remove_node(key, base->right))
+            return false;
+        adopt_children(base);
+    }
+    else
+    {
+        Node* removed = base;
+        if(removed->left == nullptr || removed->right == nullptr)
+        {
+            base = removed->left != nullptr ? removed->left : removed->right;
+            if(base != nullptr)
+                base->parent = removed->parent;
+        }
+        else
+        {
+            Node* next = detach_min(removed->right);
+            next->left = removed->left;
+            next->right = removed->right;
+            next->parent = removed->parent;
+            adopt_children(next);
+            base = next;
+        }
+
+        delete removed;
+        count--;
+        version_number++;
+
+        if(base == nullptr)
+            return true;
+    }
+
+    rebalance(base);
+    return true;
+}
+
+// detach_min() unlinks the leftmost node from the subtree whose root is
+// stored in base, rebalancing on the way back up, and returns it.
+template <typename ElementType, typename Compare>
+typename AVLSet<ElementType, Compare>::Node* AVLSet<ElementType, Compare>::detach_min(Node*& base)
+{
+    if(base->left == nullptr)
+    {
+        Node* min = base;
+        base = min->right;
+        if(base != nullptr)
+            base->parent = min->parent;
+        return min;
+    }
+
+    Node* min = detach_min(base->left);
+    adopt_children(base);
+    rebalance(base);
+    return min;
+}
+
+// height_of() returns the height of a subtree as this tree counts heights:
+// with balancing on, as balanced_add() counts them, an empty subtree's
+// height is 0 and a leaf's is 1; with balancing off, as add_node() counts
+// them, an empty subtree's height is -1 and a leaf's is 0.
+template <typename ElementType, typename Compare>
+int AVLSet<ElementType, Compare>::height_of(const Node* base) const noexcept
+{
+    if(base == nullptr)
+        return balanced ? 0 : -1;
+    return base->height;
+}
+
+// update_height() recalculates a node's height from its children's, which
+// must already be right.
+template <typename ElementType, typename Compare>
+void AVLSet<ElementType, Compare>::update_height(Node* base) noexcept
+{
+    base->height = 1 + std::max(height_of(base->left), height_of(base->right));
+}
+
+// update_rotated_heights() recalculates the heights of the nodes a
+// rotation has moved: the new root of the subtree and its two children.
+// The subtrees below them keep their places, so their heights are still
+// right, and this takes constant time.
+template <typename ElementType, typename Compare>
+void AVLSet<ElementType, Compare>::update_rotated_heights(Node* base) noexcept
+{
+    update_height(base->left);
+    update_height(base->right);
+    update_height(base);
+}
+
+// rebalance() updates the height of the root of a subtree that has lost a
+// node and, if balancing is on and the subtree is now out of balance,
+// rotates it.  Unlike after an add, the taller child can itself be
+// balanced after a removal, in which case a single rotation suffices.
+// Only the rotated nodes' heights change, so only theirs are updated.
+template <typename ElementType, typename Compare>
+void AVLSet<ElementType, Compare>::rebalance(Node*& base) noexcept
+{
+    update_height(base);
+    if(!balanced)
+        return;
+
+    int factor = height_of(base->left) - height_of(base->right);
+    if(factor == 2)
+    {
+        if(height_of(base->left->left) >= height_of(base->left->right))
+            base = LLrotation(base);
+        else
+            base = LRrotation(base);
+    }
+    else if(factor == -2)
+    {
+        if(height_of(base->right->right) >= height_of(base->right->left))
+            base = RRrotation(base);
+        else
+            base = RLrotation(base);
+    }
+    else
+    {
+        return;
+    }
+
+    update_rotated_heights(base);
+}
+
+// update_tree_height() sets tree_height from the root's height, which the
+// two ways of counting heights (see height_of()) store differently.
+template <typename ElementType, typename Compare>
+void AVLSet<ElementType, Compare>::update_tree_height() noexcept
+{
+    if(root == nullptr)
+        tree_height = -1;
+    else
+        tree_height = balanced ? root->height - 1 : root->height;
+}
+
+// add_element() is shared by both overloads of add(); balanced_add() and
+// add_node() only count a node when they actually create one.
+template <typename ElementType, typename Compare>
+template <typename E>
+void AVLSet<ElementType, Compare>::add_element(E&& element)
+{
+    if(balanced)
+    {
+        root = balanced_add(std::forward<E>(element), root);
+        root->parent = nullptr;
+        tree_height = root->height - 1;
+    }
+    else
+    {
+        int new_height = add_node(std::forward<E>(element), root);
+        if(root->height < new_height)
+        {
+            root->height = new_height;
+        }
+        tree_height = root->height;
+    }
+}
+
+template <typename ElementType, typename Compare>
+template <typename E>
+int AVLSet<ElementType, Compare>::add_node(E&& element, Node*& base)
 {
     int new_height;
     if(base == nullptr)
     {
-        base = new Node{element, nullptr, nullptr, 0};
+        base = new Node{std::forward<E>(element), nullptr, nullptr, 0};
+        count++;
+        version_number++;
         return 0;
     }
-    else if(element > base->value) //right
+
+    int order = compare(element, base->value);
+    if(order > 0) //right
     {
-        new_height = 1 + add_node(element, base->right);
+        new_height = 1 + add_node(std::forward<E>(element), base->right);
+        base->right->parent = base;
         if(new_height > base->height)
             base->height = new_height;
         return new_height;
     }
-    else if(element < base->value) //left
+    else if(order < 0) //left
     {
-        new_height = 1 + add_node(element, base->left);
+        new_height = 1 + add_node(std::forward<E>(element), base->left);
+        base->left->parent = base;
         if(new_height > base->height)
             base->height = new_height;
         return new_height;
@@ -487,8 +1141,8 @@ int AVLSet<ElementType>::add_node(const ElementType& element, Node*& base)
     return 0;
 }
 
-template <typename ElementType>
-int AVLSet<ElementType>::get_balanced_factor(Node* base)
+template <typename ElementType, typename Compare>
+int AVLSet<ElementType, Compare>::get_balanced_factor(Node* base)
 {
     if(base->left && base->right)
     {
@@ -505,8 +1159,8 @@ int AVLSet<ElementType>::get_balanced_factor(Node* base)
     return 0;
 }
 
-template <typename ElementType>
-int AVLSet<ElementType>::get_height(Node* base)
+template <typename ElementType, typename Compare>
+int AVLSet<ElementType, Compare>::get_height(Node* base)
 {
     if((base->left != nullptr) && (base->right != nullptr))
     {
@@ -526,16 +1180,6 @@ int AVLSet<ElementType>::get_height(Node* base)
     return 0;
 }
 
-template <typename ElementType>
-int AVLSet<ElementType>::reset_heights(Node* base)
-{
-    if(base == nullptr)
-        return 0;
-    int new_height = std::max(1 + reset_heights(base->left), 1 + reset_heights(base->right));
-    base->height = new_height;
-    return new_height;
-}
-
 
 #endif
 
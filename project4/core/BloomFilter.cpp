@@ -0,0 +1,82 @@
+// BloomFilter.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include "BloomFilter.hpp"
+#include <algorithm>
+#include <cmath>
+#include "HashFunctions.hpp"
+
+
+
+namespace
+{
+    // Both the block and the bits within it come from one 64-bit hash: the
+    // block from its upper half, and the bits from 9-bit pieces of a
+    // scrambled copy of it (HASH_COUNT * 9 being no more than 64).
+    std::uint64_t bitsOf(std::uint64_t hash)
+    {
+        return hash * 0x9e3779b97f4a7c15ull;
+    }
+
+    std::size_t blockOf(std::uint64_t hash, std::size_t blockCount)
+    {
+        return static_cast<std::size_t>(((hash >> 32) * blockCount) >> 32);
+    }
+}
+
+
+
+BloomFilter::BloomFilter(unsigned int expectedCount, double bitsPerString)
+    : blocks(std::max<std::size_t>(1, static_cast<std::size_t>(std::ceil(expectedCount * bitsPerString / 512))), Block{})
+{
+}
+
+
+BloomFilter::BloomFilter(const std::vector<std::string>& strings, double bitsPerString)
+    : BloomFilter{static_cast<unsigned int>(strings.size()), bitsPerString}
+{
+    for (const std::string& s : strings)
+    {
+        add(s);
+    }
+}
+
+
+void BloomFilter::add(std::string_view s) noexcept
+{
+    std::uint64_t hash = hashing::wyhash64(s, 0);
+    Block& block = blocks[blockOf(hash, blocks.size())];
+    std::uint64_t bits = bitsOf(hash);
+
+    for (unsigned int i = 0; i < HASH_COUNT; ++i, bits >>= 9)
+    {
+        unsigned int bit = bits & 511;
+        block.words[bit / 64] |= std::uint64_t{1} << (bit % 64);
+    }
+}
+
+
+bool BloomFilter::mightContain(std::string_view s) const noexcept
+{
+    std::uint64_t hash = hashing::wyhash64(s, 0);
+    const Block& block = blocks[blockOf(hash, blocks.size())];
+    std::uint64_t bits = bitsOf(hash);
+
+    for (unsigned int i = 0; i < HASH_COUNT; ++i, bits >>= 9)
+    {
+        unsigned int bit = bits & 511;
+        if ((block.words[bit / 64] & (std::uint64_t{1} << (bit % 64))) == 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+std::size_t BloomFilter::sizeInBytes() const noexcept
+{
+    return blocks.size() * sizeof(Block);
+}
@@ -0,0 +1,71 @@
+// BloomFilter.hpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A BloomFilter is a compact, approximate set of strings that answers
+// "might this string be in the set?"  If the answer is no, the string is
+// definitely not in the set; if it's yes, it probably is, but there's a
+// small chance (the "false positive rate") that it isn't.  It's meant to
+// sit in front of a real Set, rejecting most lookups of strings that
+// aren't there without touching the Set at all.
+//
+// This is a "blocked" Bloom filter: its bits are divided into 512-bit
+// blocks, each the size of a typical cache line, and each string sets (or
+// checks) HASH_COUNT bits within a single block chosen by its hash.  So a
+// lookup reads one cache line, where an ordinary Bloom filter would read
+// HASH_COUNT of them, at the cost of a slightly higher false positive
+// rate for the same number of bits.  At the default of 10 bits per
+// string, the false positive rate is about 1%.
+
+#ifndef BLOOMFILTER_HPP
+#define BLOOMFILTER_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+
+class BloomFilter
+{
+public:
+    // The number of bits each string sets within its block.
+    static constexpr unsigned int HASH_COUNT = 7;
+
+public:
+    // Initializes an empty BloomFilter with room for the given number of
+    // strings at the given number of bits per string.  More strings can
+    // be added than that, but the false positive rate rises with each.
+    explicit BloomFilter(unsigned int expectedCount, double bitsPerString = 10.0);
+
+    // Initializes a BloomFilter containing the given strings, sized for
+    // them.
+    explicit BloomFilter(const std::vector<std::string>& strings, double bitsPerString = 10.0);
+
+
+    // add() adds a string to the filter.
+    void add(std::string_view s) noexcept;
+
+    // mightContain() returns false if the given string was definitely
+    // never added, true if it probably was.
+    bool mightContain(std::string_view s) const noexcept;
+
+
+    // sizeInBytes() returns the size of the filter's bits.
+    std::size_t sizeInBytes() const noexcept;
+
+
+private:
+    struct alignas(64) Block
+    {
+        std::uint64_t words[8];
+    };
+
+    std::vector<Block> blocks;
+};
+
+
+
+#endif
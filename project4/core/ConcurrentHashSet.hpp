@@ -0,0 +1,364 @@
+// ConcurrentHashSet.hpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A ConcurrentHashSet is a separately-chained hash table, like HashSet,
+// that any number of threads can use at once: many threads can call
+// contains() while others call add().
+//
+// Lookups take no locks and never wait for anything.  Once a node is
+// linked into a list, it never changes, and add() links new nodes in at
+// the front of a list with a single atomic compare-and-swap, so a lookup
+// only has to load the array and walk a list.
+//
+// Calls to add() lock one of STRIPE_COUNT "stripes", chosen by the new
+// element's hash value, so only adds of elements in the same stripe wait
+// for one another.  (Equal elements hash to the same stripe, which is
+// what keeps two threads from adding the same element at once.)  Each
+// stripe has its own NodePools, so allocation needs no further locking.
+//
+// When the proportion of size to capacity exceeds 0.8, the add() that
+// pushed it there locks every stripe and builds a new array, with new
+// list nodes that refer to the same elements, leaving the old array and
+// its lists intact.  Lookups that started before the new array is
+// published keep walking the old one, which is still correct, since no
+// add() can change it in the meantime.  Old arrays and their list nodes
+// are kept until the ConcurrentHashSet is destroyed, because there's no
+// telling when the last lookup using them will finish; that costs about
+// as much memory as the current array and its list nodes, but not a
+// second copy of any element.
+
+#ifndef CONCURRENTHASHSET_HPP
+#define CONCURRENTHASHSET_HPP
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include "NodePool.hpp"
+#include "Set.hpp"
+#include "SetLookupKey.hpp"
+
+
+
+template <typename ElementType, typename HashKeyType = ElementType>
+class ConcurrentHashSet : public Set<ElementType>
+{
+public:
+    // The default capacity of the ConcurrentHashSet before anything has
+    // been added to it.
+    static constexpr unsigned int DEFAULT_CAPACITY = 10;
+
+    // The number of locks that calls to add() are spread across.
+    static constexpr unsigned int STRIPE_COUNT = 64;
+
+    // As in HashSet, HashKeyType is normally just ElementType, but it can
+    // be a lightweight view of it instead (see SetLookupKey.hpp).
+    using HashFunction = std::function<unsigned int(const HashKeyType&)>;
+
+public:
+    // Initializes a ConcurrentHashSet to be empty, so that it will use the
+    // given hash function whenever it needs to hash an element.  The hash
+    // function is called from many threads at once.
+    explicit ConcurrentHashSet(HashFunction hashFunction);
+
+    // Cleans up the ConcurrentHashSet so that it leaks no memory.  No
+    // other thread can be using it at the time.
+    ~ConcurrentHashSet() noexcept override;
+
+    // A ConcurrentHashSet can't be copied or moved, since other threads
+    // may be using it.
+    ConcurrentHashSet(const ConcurrentHashSet& s) = delete;
+    ConcurrentHashSet& operator=(const ConcurrentHashSet& s) = delete;
+
+
+    bool isImplemented() const noexcept override;
+
+
+    // add() adds an element to the set, if it's not already there.  It
+    // locks one stripe, or every stripe if it resizes the array.
+    void add(const ElementType& element) override;
+
+    // This overload of add() moves the given element into the set, rather
+    // than copying it, if it's not already there.
+    void add(ElementType&& element);
+
+
+    // contains() returns true if the given element is in the set, false
+    // otherwise.  It takes no locks, and runs in constant time (with
+    // respect to the number of elements, assuming a good hash function)
+    // even while other threads are adding elements.  An element that
+    // another thread is adding at the same time may or may not be found.
+    bool contains(const ElementType& element) const override;
+
+    // This overload of contains() looks up a key of the HashKeyType, when
+    // that's a lightweight view of ElementType, without converting it to
+    // an ElementType.
+    template <typename Key, typename = std::enable_if_t<
+        std::is_same_v<Key, HashKeyType> && IsSetLookupKey<ElementType, Key>>>
+    bool contains(const Key& key) const;
+
+
+    // size() returns the number of elements in the set.  While other
+    // threads are adding elements, it may be out of date by the time
+    // it returns.
+    unsigned int size() const noexcept override;
+
+
+    // capacity() returns the size of the current array.
+    unsigned int capacity() const noexcept;
+
+
+private:
+    // A node refers to its element, rather than holding it, so that an
+    // element is shared by the lists of every array it's been in.  Nodes
+    // never change once they've been linked into a list.
+    struct Node
+    {
+        unsigned int hash;
+        const ElementType* element;
+        const Node* next;
+    };
+
+    struct Table
+    {
+        unsigned int capacity;
+        std::unique_ptr<std::atomic<const Node*>[]> lists;
+
+        // The array this one replaced, kept for lookups that may still be
+        // using it.
+        std::unique_ptr<Table> previous;
+    };
+
+    struct alignas(64) Stripe
+    {
+        std::mutex mutex;
+        NodePool<ElementType> elements;
+        NodePool<Node> nodes;
+    };
+
+    HashFunction hashFunction;
+    std::unique_ptr<Stripe[]> stripes;
+    std::atomic<Table*> table;
+    std::atomic<unsigned int> element_count;
+
+    template <typename Key>
+    bool contains_key(const Key& key) const;
+
+    template <typename E>
+    void add_element(E&& element);
+
+    static bool list_contains(const Node* node, unsigned int hash, const ElementType& element);
+
+    void grow(const Table* full);
+
+    static std::unique_ptr<Table> make_table(unsigned int capacity);
+};
+
+
+
+template <typename ElementType, typename HashKeyType>
+ConcurrentHashSet<ElementType, HashKeyType>::ConcurrentHashSet(HashFunction hashFunction)
+    : hashFunction{hashFunction}, stripes{new Stripe[STRIPE_COUNT]},
+      table{make_table(DEFAULT_CAPACITY).release()}, element_count{0}
+{
+}
+
+
+template <typename ElementType, typename HashKeyType>
+ConcurrentHashSet<ElementType, HashKeyType>::~ConcurrentHashSet() noexcept
+{
+    std::unique_ptr<Table> current{table.load()};
+
+    if constexpr (!std::is_trivially_destructible_v<ElementType>)
+    {
+        // Every element is in the current array's lists exactly once.
+        for (unsigned int i = 0; i < current->capacity; ++i)
+        {
+            for (const Node* node = current->lists[i].load(); node != nullptr; node = node->next)
+            {
+                Stripe& stripe = stripes[node->hash % STRIPE_COUNT];
+                stripe.elements.destroy(const_cast<ElementType*>(node->element));
+            }
+        }
+    }
+}
+
+
+template <typename ElementType, typename HashKeyType>
+bool ConcurrentHashSet<ElementType, HashKeyType>::isImplemented() const noexcept
+{
+    return true;
+}
+
+
+template <typename ElementType, typename HashKeyType>
+void ConcurrentHashSet<ElementType, HashKeyType>::add(const ElementType& element)
+{
+    add_element(element);
+}
+
+
+template <typename ElementType, typename HashKeyType>
+void ConcurrentHashSet<ElementType, HashKeyType>::add(ElementType&& element)
+{
+    add_element(std::move(element));
+}
+
+
+template <typename ElementType, typename HashKeyType>
+bool ConcurrentHashSet<ElementType, HashKeyType>::contains(const ElementType& element) const
+{
+    return contains_key(element);
+}
+
+
+template <typename ElementType, typename HashKeyType>
+template <typename Key, typename>
+bool ConcurrentHashSet<ElementType, HashKeyType>::contains(const Key& key) const
+{
+    return contains_key(key);
+}
+
+
+template <typename ElementType, typename HashKeyType>
+unsigned int ConcurrentHashSet<ElementType, HashKeyType>::size() const noexcept
+{
+    return element_count.load(std::memory_order_relaxed);
+}
+
+
+template <typename ElementType, typename HashKeyType>
+unsigned int ConcurrentHashSet<ElementType, HashKeyType>::capacity() const noexcept
+{
+    return table.load(std::memory_order_acquire)->capacity;
+}
+
+
+template <typename ElementType, typename HashKeyType>
+template <typename Key>
+bool ConcurrentHashSet<ElementType, HashKeyType>::contains_key(const Key& key) const
+{
+    unsigned int hash = hashFunction(key);
+    const Table* current = table.load(std::memory_order_acquire);
+
+    const Node* node = current->lists[hash % current->capacity].load(std::memory_order_acquire);
+    for (; node != nullptr; node = node->next)
+    {
+        if (node->hash == hash && *node->element == key)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+template <typename ElementType, typename HashKeyType>
+template <typename E>
+void ConcurrentHashSet<ElementType, HashKeyType>::add_element(E&& element)
+{
+    unsigned int hash = hashFunction(element);
+    Stripe& stripe = stripes[hash % STRIPE_COUNT];
+    Table* current;
+
+    {
+        std::lock_guard<std::mutex> lock{stripe.mutex};
+
+        // The array can't be replaced while any stripe is locked.
+        current = table.load(std::memory_order_acquire);
+        std::atomic<const Node*>& list = current->lists[hash % current->capacity];
+        if (list_contains(list.load(std::memory_order_acquire), hash, element))
+        {
+            return;
+        }
+
+        const ElementType* stored = stripe.elements.create(std::forward<E>(element));
+        Node* node = stripe.nodes.create(Node{hash, stored, list.load(std::memory_order_relaxed)});
+
+        // Adds of elements in other stripes may be adding to the same
+        // list at the same time.
+        while (!list.compare_exchange_weak(node->next, node,
+            std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    if (element_count.fetch_add(1, std::memory_order_relaxed) + 1 > current->capacity * 0.8)
+    {
+        grow(current);
+    }
+}
+
+
+template <typename ElementType, typename HashKeyType>
+bool ConcurrentHashSet<ElementType, HashKeyType>::list_contains(
+    const Node* node, unsigned int hash, const ElementType& element)
+{
+    for (; node != nullptr; node = node->next)
+    {
+        if (node->hash == hash && *node->element == element)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+// Replaces the full array with one that's twice as large, unless another
+// thread got there first.
+template <typename ElementType, typename HashKeyType>
+void ConcurrentHashSet<ElementType, HashKeyType>::grow(const Table* full)
+{
+    for (unsigned int i = 0; i < STRIPE_COUNT; ++i)
+    {
+        stripes[i].mutex.lock();
+    }
+
+    Table* current = table.load(std::memory_order_relaxed);
+    if (current == full)
+    {
+        std::unique_ptr<Table> bigger = make_table(current->capacity * 2 + 1);
+        for (unsigned int i = 0; i < current->capacity; ++i)
+        {
+            const Node* node = current->lists[i].load(std::memory_order_relaxed);
+            for (; node != nullptr; node = node->next)
+            {
+                std::atomic<const Node*>& list = bigger->lists[node->hash % bigger->capacity];
+                NodePool<Node>& nodes = stripes[node->hash % STRIPE_COUNT].nodes;
+                list.store(nodes.create(Node{node->hash, node->element, list.load(std::memory_order_relaxed)}),
+                    std::memory_order_relaxed);
+            }
+        }
+
+        bigger->previous.reset(current);
+        table.store(bigger.release(), std::memory_order_release);
+    }
+
+    for (unsigned int i = STRIPE_COUNT; i > 0; --i)
+    {
+        stripes[i - 1].mutex.unlock();
+    }
+}
+
+
+template <typename ElementType, typename HashKeyType>
+std::unique_ptr<typename ConcurrentHashSet<ElementType, HashKeyType>::Table>
+ConcurrentHashSet<ElementType, HashKeyType>::make_table(unsigned int capacity)
+{
+    std::unique_ptr<Table> t{new Table{capacity, std::unique_ptr<std::atomic<const Node*>[]>{
+        new std::atomic<const Node*>[capacity]}, nullptr}};
+    for (unsigned int i = 0; i < capacity; ++i)
+    {
+        t->lists[i].store(nullptr, std::memory_order_relaxed);
+    }
+    return t;
+}
+
+
+
+#endif
@@ -0,0 +1,605 @@
+// ConcurrentSkipListSet.hpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A ConcurrentSkipListSet is a skip list, laid out like SkipListSet (each
+// element stored once, in a node followed by its tower of links), that
+// any number of threads can use at once, without locks.  It's the
+// lock-free skip list of Fraser, and of Herlihy and Shavit's "The Art of
+// Multiprocessor Programming."
+//
+// Each link holds a pointer to the next node on its level, with its low
+// bit used as a "mark".  A node is removed by marking each of its own
+// links, from the top of its tower down; the thread whose compare-and-
+// swap marks the bottom one is the thread that removed it.  A marked link
+// never changes again, so no node can be linked in after a removed one,
+// and searches "snip" removed nodes out of the lists as they pass them,
+// by swinging the previous node's link past them.  A node is added by
+// linking it into the bottom level with a compare-and-swap, after which
+// it's in the set, and then into each level above, one at a time.
+//
+// contains() never writes anything, and never waits: it skips removed
+// nodes rather than snipping them.
+//
+// A removed node can't be deleted while another thread might still be
+// looking at it, so removed nodes are handed to epochs::retire() (see
+// EpochReclamation.hpp), which deletes them once every thread that could
+// have reached them has finished the operation it was in the middle of.
+// Both the thread that added a node and the thread that removed it may
+// still be linking it in or snipping it out, so a node is retired by
+// whichever of the two finishes with it last.
+//
+// Unlike SkipListSet, there's no SkipListLevelTester: every thread flips
+// its own coins, with its own random engine, so that no two threads ever
+// share one.
+
+#ifndef CONCURRENTSKIPLISTSET_HPP
+#define CONCURRENTSKIPLISTSET_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include "EpochReclamation.hpp"
+#include "Set.hpp"
+#include "SetCompare.hpp"
+#include "SetLookupKey.hpp"
+
+
+
+template <typename ElementType, typename Compare = SetCompare<ElementType>>
+class ConcurrentSkipListSet : public Set<ElementType>
+{
+public:
+    // The most levels a ConcurrentSkipListSet can have.
+    static constexpr unsigned int MAX_LEVELS = 32;
+
+public:
+    // Initializes a ConcurrentSkipListSet to be empty, with its keys
+    // ordered by the given three-way comparison (see SetCompare.hpp),
+    // which is called from many threads at once.
+    explicit ConcurrentSkipListSet(Compare compare = Compare{});
+
+    // Cleans up the ConcurrentSkipListSet so that it leaks no memory.  No
+    // other thread can be using it at the time.  (Nodes it has already
+    // retired are deleted by the epochs, in their own time.)
+    ~ConcurrentSkipListSet() noexcept override;
+
+    // A ConcurrentSkipListSet can't be copied or moved, since other
+    // threads may be using it.
+    ConcurrentSkipListSet(const ConcurrentSkipListSet& s) = delete;
+    ConcurrentSkipListSet& operator=(const ConcurrentSkipListSet& s) = delete;
+
+
+    bool isImplemented() const noexcept override;
+
+
+    // add() adds an element to the set, if it's not already there.  It
+    // runs in an expected time of O(log n), plus whatever time it spends
+    // retrying when other threads change the same part of the skip list.
+    void add(const ElementType& element) override;
+
+    // This overload of add() moves the given element into the set, rather
+    // than copying it, if it's not already there.
+    void add(ElementType&& element);
+
+
+    // contains() returns true if the given element is in the set, false
+    // otherwise.  It runs in an expected time of O(log n) no matter what
+    // other threads are doing.  An element that another thread is adding
+    // or removing at the same time may or may not be found.
+    bool contains(const ElementType& element) const override;
+
+    // This overload of contains() compares a lightweight view of an
+    // element (see SetLookupKey.hpp) against the skip list's keys
+    // directly, without converting it to an ElementType.
+    template <typename Key, typename = std::enable_if_t<IsSetLookupKey<ElementType, Key>>>
+    bool contains(const Key& key) const;
+
+
+    // remove() removes the given element from the set, returning true if
+    // this call removed it, or false if it wasn't there (or another
+    // thread removed it first).
+    bool remove(const ElementType& element);
+
+    template <typename Key, typename = std::enable_if_t<IsSetLookupKey<ElementType, Key>>>
+    bool remove(const Key& key);
+
+
+    // size() returns the number of elements in the set.  While other
+    // threads are adding or removing elements, it may be out of date by
+    // the time it returns.
+    unsigned int size() const noexcept override;
+
+
+    // levelCount() returns the number of levels in the skip list, which
+    // is the height of the tallest tower that has ever been in it, or 1
+    // if nothing ever has.
+    unsigned int levelCount() const noexcept;
+
+
+private:
+    // A link is a Node* whose low bit is set when the node that the link
+    // belongs to has been removed.
+    using Link = std::atomic<std::uintptr_t>;
+
+    // A Node's tower of links, one for each of its height levels, starts
+    // TOWER_OFFSET bytes after the Node itself.  owners counts the threads
+    // (its adder and its remover) that may still link or unlink it.
+    struct Node
+    {
+        ElementType element;
+        unsigned int height;
+        std::atomic<unsigned int> owners;
+    };
+
+    static constexpr std::size_t TOWER_OFFSET =
+        (sizeof(Node) + alignof(Link) - 1) / alignof(Link) * alignof(Link);
+
+    static constexpr std::size_t NODE_ALIGNMENT =
+        alignof(Node) > alignof(Link) ? alignof(Node) : alignof(Link);
+
+    Compare compare;
+
+    // head is the tower of -INF; nullptr is +INF.
+    Link head[MAX_LEVELS];
+    std::atomic<unsigned int> level_count;
+    std::atomic<unsigned int> count;
+
+    static Link* tower(Node* node) noexcept;
+    static bool is_marked(std::uintptr_t link) noexcept;
+    static Node* node_of(std::uintptr_t link) noexcept;
+    static std::uintptr_t link_to(Node* node) noexcept;
+
+    static unsigned int random_height();
+
+    template <typename E>
+    static Node* create_node(E&& element, unsigned int height);
+
+    static void destroy_node(void* node) noexcept;
+
+    static void release_node(Node* node);
+
+    void raise_level_count(unsigned int height) noexcept;
+
+    template <typename Key>
+    bool find(const Key& key, Link** predecessors, Node** successors);
+
+    template <typename Key>
+    bool try_find(const Key& key, Link** predecessors, Node** successors);
+
+    template <typename E>
+    void add_element(E&& element);
+
+    template <typename Key>
+    bool contains_key(const Key& key) const;
+
+    template <typename Key>
+    bool remove_key(const Key& key);
+};
+
+
+
+template <typename ElementType, typename Compare>
+ConcurrentSkipListSet<ElementType, Compare>::ConcurrentSkipListSet(Compare compare)
+    : compare{std::move(compare)}, level_count{1}, count{0}
+{
+    for (Link& link : head)
+    {
+        link.store(0, std::memory_order_relaxed);
+    }
+}
+
+
+template <typename ElementType, typename Compare>
+ConcurrentSkipListSet<ElementType, Compare>::~ConcurrentSkipListSet() noexcept
+{
+    // Every node that hasn't been retired is still on the bottom level.
+    for (std::uintptr_t link = head[0].load(); node_of(link) != nullptr; )
+    {
+        Node* node = node_of(link);
+        link = tower(node)[0].load(std::memory_order_relaxed);
+        destroy_node(node);
+    }
+}
+
+
+template <typename ElementType, typename Compare>
+bool ConcurrentSkipListSet<ElementType, Compare>::isImplemented() const noexcept
+{
+    return true;
+}
+
+
+template <typename ElementType, typename Compare>
+void ConcurrentSkipListSet<ElementType, Compare>::add(const ElementType& element)
+{
+    add_element(element);
+}
+
+
+template <typename ElementType, typename Compare>
+void ConcurrentSkipListSet<ElementType, Compare>::add(ElementType&& element)
+{
+    add_element(std::move(element));
+}
+
+
+template <typename ElementType, typename Compare>
+bool ConcurrentSkipListSet<ElementType, Compare>::contains(const ElementType& element) const
+{
+    return contains_key(element);
+}
+
+
+template <typename ElementType, typename Compare>
+template <typename Key, typename>
+bool ConcurrentSkipListSet<ElementType, Compare>::contains(const Key& key) const
+{
+    return contains_key(key);
+}
+
+
+template <typename ElementType, typename Compare>
+bool ConcurrentSkipListSet<ElementType, Compare>::remove(const ElementType& element)
+{
+    return remove_key(element);
+}
+
+
+template <typename ElementType, typename Compare>
+template <typename Key, typename>
+bool ConcurrentSkipListSet<ElementType, Compare>::remove(const Key& key)
+{
+    return remove_key(key);
+}
+
+
+template <typename ElementType, typename Compare>
+unsigned int ConcurrentSkipListSet<ElementType, Compare>::size() const noexcept
+{
+    return count.load(std::memory_order_relaxed);
+}
+
+
+template <typename ElementType, typename Compare>
+unsigned int ConcurrentSkipListSet<ElementType, Compare>::levelCount() const noexcept
+{
+    return level_count.load(std::memory_order_relaxed);
+}
+
+
+template <typename ElementType, typename Compare>
+typename ConcurrentSkipListSet<ElementType, Compare>::Link*
+ConcurrentSkipListSet<ElementType, Compare>::tower(Node* node) noexcept
+{
+    return reinterpret_cast<Link*>(reinterpret_cast<unsigned char*>(node) + TOWER_OFFSET);
+}
+
+
+template <typename ElementType, typename Compare>
+bool ConcurrentSkipListSet<ElementType, Compare>::is_marked(std::uintptr_t link) noexcept
+{
+    return (link & 1) != 0;
+}
+
+
+template <typename ElementType, typename Compare>
+typename ConcurrentSkipListSet<ElementType, Compare>::Node*
+ConcurrentSkipListSet<ElementType, Compare>::node_of(std::uintptr_t link) noexcept
+{
+    return reinterpret_cast<Node*>(link & ~std::uintptr_t{1});
+}
+
+
+template <typename ElementType, typename Compare>
+std::uintptr_t ConcurrentSkipListSet<ElementType, Compare>::link_to(Node* node) noexcept
+{
+    return reinterpret_cast<std::uintptr_t>(node);
+}
+
+
+// random_height() flips coins with the calling thread's own engine: one
+// random bit per flip, so one draw is enough for a whole tower.
+template <typename ElementType, typename Compare>
+unsigned int ConcurrentSkipListSet<ElementType, Compare>::random_height()
+{
+    static thread_local std::mt19937_64 engine{std::random_device{}()};
+
+    unsigned int height = 1;
+    for (std::uint64_t coins = engine(); height < MAX_LEVELS && (coins & 1) != 0; coins >>= 1)
+    {
+        height++;
+    }
+    return height;
+}
+
+
+// create_node() leaves the new node's tower for its caller to fill in.
+template <typename ElementType, typename Compare>
+template <typename E>
+typename ConcurrentSkipListSet<ElementType, Compare>::Node*
+ConcurrentSkipListSet<ElementType, Compare>::create_node(E&& element, unsigned int height)
+{
+    void* block = ::operator new(TOWER_OFFSET + sizeof(Link) * height, std::align_val_t{NODE_ALIGNMENT});
+
+    try
+    {
+        Node* node = new (block) Node{std::forward<E>(element), height, {2}};
+        for (unsigned int level = 0; level < height; ++level)
+        {
+            new (&tower(node)[level]) Link{0};
+        }
+        return node;
+    }
+    catch (...)
+    {
+        ::operator delete(block, std::align_val_t{NODE_ALIGNMENT});
+        throw;
+    }
+}
+
+
+// destroy_node() is an epochs::Deleter, so it takes its node as a void*.
+template <typename ElementType, typename Compare>
+void ConcurrentSkipListSet<ElementType, Compare>::destroy_node(void* node) noexcept
+{
+    static_cast<Node*>(node)->~Node();
+    ::operator delete(node, std::align_val_t{NODE_ALIGNMENT});
+}
+
+
+// release_node() is called by a removed node's adder and its remover once
+// each has finished with it, by which point the node is unreachable, so
+// the second of them to call it retires the node.
+template <typename ElementType, typename Compare>
+void ConcurrentSkipListSet<ElementType, Compare>::release_node(Node* node)
+{
+    if (node->owners.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        epochs::retire(node, &destroy_node);
+    }
+}
+
+
+template <typename ElementType, typename Compare>
+void ConcurrentSkipListSet<ElementType, Compare>::raise_level_count(unsigned int height) noexcept
+{
+    unsigned int current = level_count.load(std::memory_order_relaxed);
+    while (current < height && not level_count.compare_exchange_weak(current, height))
+    {
+    }
+}
+
+
+// find() finds, on every level, the last node whose element is less than
+// the given key (or head, if there isn't one) and the node after it,
+// snipping out any removed nodes in between, so that neither is marked
+// when it's found.  It returns true if the node after it on the bottom
+// level has an element equal to the key.
+template <typename ElementType, typename Compare>
+template <typename Key>
+bool ConcurrentSkipListSet<ElementType, Compare>::find(
+    const Key& key, Link** predecessors, Node** successors)
+{
+    while (not try_find(key, predecessors, successors))
+    {
+    }
+
+    return successors[0] != nullptr && compare(successors[0]->element, key) == 0;
+}
+
+
+// try_find() makes one attempt at find(), starting over from the top
+// whenever it fails to snip out a removed node, because the node before
+// it has been removed, too, or has had something linked in after it.
+template <typename ElementType, typename Compare>
+template <typename Key>
+bool ConcurrentSkipListSet<ElementType, Compare>::try_find(
+    const Key& key, Link** predecessors, Node** successors)
+{
+    Link* links = head;
+    for (unsigned int level = level_count.load(); level-- > 0; )
+    {
+        Node* current = node_of(links[level].load());
+        while (current != nullptr)
+        {
+            std::uintptr_t next = tower(current)[level].load();
+            if (is_marked(next))
+            {
+                std::uintptr_t expected = link_to(current);
+                if (not links[level].compare_exchange_strong(expected, next & ~std::uintptr_t{1}))
+                {
+                    return false;
+                }
+                current = node_of(next);
+            }
+            else if (compare(current->element, key) < 0)
+            {
+                links = tower(current);
+                current = node_of(next);
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        predecessors[level] = links;
+        successors[level] = current;
+    }
+
+    return true;
+}
+
+
+// add_element() is shared by both overloads of add().  Once the new node
+// is linked into the bottom level, it links it into each level above, up
+// to the top of its tower, unless it's removed in the meantime, finding
+// the nodes around it again whenever another thread gets in the way.
+template <typename ElementType, typename Compare>
+template <typename E>
+void ConcurrentSkipListSet<ElementType, Compare>::add_element(E&& element)
+{
+    epochs::Guard guard;
+
+    unsigned int height = random_height();
+    raise_level_count(height);
+
+    Link* predecessors[MAX_LEVELS];
+    Node* successors[MAX_LEVELS];
+    if (find(element, predecessors, successors))
+    {
+        return;
+    }
+
+    Node* node = create_node(std::forward<E>(element), height);
+    const ElementType& key = node->element;
+    Link* nodeTower = tower(node);
+
+    while (true)
+    {
+        std::uintptr_t expected = link_to(successors[0]);
+        nodeTower[0].store(expected, std::memory_order_relaxed);
+        if (predecessors[0][0].compare_exchange_strong(expected, link_to(node)))
+        {
+            break;
+        }
+        else if (find(key, predecessors, successors))
+        {
+            // Another thread added an equal element first, so no other
+            // thread has ever seen this node.
+            destroy_node(node);
+            return;
+        }
+    }
+
+    count.fetch_add(1, std::memory_order_relaxed);
+
+    for (unsigned int level = 1; level < height; )
+    {
+        // Once the node's link on this level is marked, it's been
+        // removed, and it mustn't be linked in any further.
+        std::uintptr_t next = nodeTower[level].load();
+        std::uintptr_t successor = link_to(successors[level]);
+        if (is_marked(next))
+        {
+            break;
+        }
+        else if (next != successor && not nodeTower[level].compare_exchange_strong(next, successor))
+        {
+            continue;
+        }
+
+        if (predecessors[level][level].compare_exchange_strong(successor, link_to(node)))
+        {
+            level++;
+        }
+        else
+        {
+            find(key, predecessors, successors);
+        }
+    }
+
+    // If the node was removed while it was being linked in, its remover
+    // may have finished snipping it out before it was linked into some
+    // of the levels above, so it has to be snipped out of those, too.
+    if (is_marked(nodeTower[0].load()))
+    {
+        find(key, predecessors, successors);
+    }
+
+    release_node(node);
+}
+
+
+template <typename ElementType, typename Compare>
+template <typename Key>
+bool ConcurrentSkipListSet<ElementType, Compare>::contains_key(const Key& key) const
+{
+    epochs::Guard guard;
+
+    // Links are marked from the top of a tower down, so a node found
+    // unmarked on any level is in the set.
+    const Link* links = head;
+    for (unsigned int level = level_count.load(std::memory_order_acquire); level-- > 0; )
+    {
+        Node* current = node_of(links[level].load(std::memory_order_acquire));
+        while (current != nullptr)
+        {
+            std::uintptr_t next = tower(current)[level].load(std::memory_order_acquire);
+            if (is_marked(next))
+            {
+                current = node_of(next);
+                continue;
+            }
+
+            int order = compare(current->element, key);
+            if (order == 0)
+            {
+                return true;
+            }
+            else if (order > 0)
+            {
+                break;
+            }
+
+            links = tower(current);
+            current = node_of(next);
+        }
+    }
+
+    return false;
+}
+
+
+// remove_key() marks the node's links from the top of its tower down, then
+// competes to mark its bottom link, which is what removes it, before
+// snipping it out of every level with one more find().
+template <typename ElementType, typename Compare>
+template <typename Key>
+bool ConcurrentSkipListSet<ElementType, Compare>::remove_key(const Key& key)
+{
+    epochs::Guard guard;
+
+    Link* predecessors[MAX_LEVELS];
+    Node* successors[MAX_LEVELS];
+    if (not find(key, predecessors, successors))
+    {
+        return false;
+    }
+
+    Node* node = successors[0];
+    Link* nodeTower = tower(node);
+    for (unsigned int level = node->height; level-- > 1; )
+    {
+        std::uintptr_t next = nodeTower[level].load();
+        while (not is_marked(next) && not nodeTower[level].compare_exchange_weak(next, next | 1))
+        {
+        }
+    }
+
+    std::uintptr_t next = nodeTower[0].load();
+    do
+    {
+        if (is_marked(next))
+        {
+            return false;
+        }
+    }
+    while (not nodeTower[0].compare_exchange_weak(next, next | 1));
+
+    count.fetch_sub(1, std::memory_order_relaxed);
+
+    find(node->element, predecessors, successors);
+    release_node(node);
+    return true;
+}
+
+
+
+#endif
@@ -0,0 +1,267 @@
+// DeletionIndex.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include "DeletionIndex.hpp"
+#include <algorithm>
+#include <utility>
+#include "HashFunctions.hpp"
+
+
+
+namespace
+{
+    const std::uint32_t EMPTY = 0xffffffffu;
+
+
+    // Calls f with every string left by deleting up to remaining letters
+    // of the one in the buffer, at or after position start.  The same
+    // string can come up more than once, when the word has a letter
+    // twice in a row.  The buffer is changed and changed back in place.
+    template <typename Function>
+    void forEachDeletion(std::string& buffer, std::size_t start, unsigned int remaining, Function& f)
+    {
+        f(std::string_view{buffer});
+        if (remaining == 0)
+        {
+            return;
+        }
+
+        for (std::size_t i = start; i < buffer.size(); ++i)
+        {
+            char deleted = buffer[i];
+            buffer.erase(i, 1);
+            forEachDeletion(buffer, i, remaining - 1, f);
+            buffer.insert(i, 1, deleted);
+        }
+    }
+
+
+    // Returns the distinct hashes of the deletions of the given string.
+    void deletionHashes(std::string_view s, unsigned int maxDistance,
+        std::string& buffer, std::vector<std::uint64_t>& hashes)
+    {
+        hashes.clear();
+        buffer.assign(s.data(), s.size());
+        auto add = [&](std::string_view deletion)
+        {
+            hashes.push_back(hashing::wyhash64(deletion, 0));
+        };
+        forEachDeletion(buffer, 0, maxDistance, add);
+
+        std::sort(hashes.begin(), hashes.end());
+        hashes.erase(std::unique(hashes.begin(), hashes.end()), hashes.end());
+    }
+
+
+    // Returns true if a and b are within maxDistance edits of each other,
+    // using the three given rows as scratch space.
+    bool withinEdits(std::string_view a, std::string_view b, unsigned int maxDistance,
+        std::vector<unsigned int> (&rows)[3])
+    {
+        if ((a.size() > b.size() ? a.size() - b.size() : b.size() - a.size()) > maxDistance)
+        {
+            return false;
+        }
+
+        for (std::vector<unsigned int>& row : rows)
+        {
+            row.resize(b.size() + 1);
+        }
+        for (std::size_t j = 0; j <= b.size(); ++j)
+        {
+            rows[1][j] = j;
+        }
+
+        for (std::size_t i = 1; i <= a.size(); ++i)
+        {
+            std::vector<unsigned int>& twoAbove = rows[0];
+            std::vector<unsigned int>& above = rows[1];
+            std::vector<unsigned int>& row = rows[2];
+
+            row[0] = i;
+            unsigned int smallest = row[0];
+            for (std::size_t j = 1; j <= b.size(); ++j)
+            {
+                row[j] = std::min({above[j] + 1, row[j - 1] + 1, above[j - 1] + (a[i - 1] == b[j - 1] ? 0 : 1)});
+                if (i >= 2 && j >= 2 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1])
+                {
+                    row[j] = std::min(row[j], twoAbove[j - 2] + 1);
+                }
+                smallest = std::min(smallest, row[j]);
+            }
+            if (smallest > maxDistance)
+            {
+                return false;
+            }
+
+            std::swap(rows[0], rows[1]);
+            std::swap(rows[1], rows[2]);
+        }
+
+        return rows[1][b.size()] <= maxDistance;
+    }
+}
+
+
+
+DeletionIndex::DeletionIndex(const std::vector<std::string>& words, unsigned int maxDistance)
+    : max_distance{maxDistance}
+{
+    std::vector<std::string_view> unique{words.begin(), words.end()};
+    std::sort(unique.begin(), unique.end());
+    unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+
+    std::size_t arenaSize = 0;
+    for (std::string_view w : unique)
+    {
+        arenaSize += w.size();
+    }
+    if (unique.size() >= EMPTY || arenaSize > 0xffffffffu)
+    {
+        throw DeletionIndexException("Too many words for a DeletionIndex");
+    }
+
+    arena.reserve(arenaSize);
+    word_starts.reserve(unique.size() + 1);
+    for (std::string_view w : unique)
+    {
+        word_starts.push_back(arena.size());
+        arena.insert(arena.end(), w.begin(), w.end());
+    }
+    word_starts.push_back(arena.size());
+
+    // Pair every deletion's hash with its word, then sort the pairs so
+    // that each hash's words are together.
+    std::vector<std::pair<std::uint64_t, std::uint32_t>> pairs;
+    std::string buffer;
+    std::vector<std::uint64_t> hashes;
+    for (std::uint32_t w = 0; w < unique.size(); ++w)
+    {
+        deletionHashes(unique[w], maxDistance, buffer, hashes);
+        for (std::uint64_t hash : hashes)
+        {
+            pairs.emplace_back(hash, w);
+        }
+    }
+    std::sort(pairs.begin(), pairs.end());
+
+    postings.reserve(pairs.size());
+    for (std::size_t i = 0; i < pairs.size(); ++i)
+    {
+        if (i == 0 || pairs[i].first != pairs[i - 1].first)
+        {
+            group_hashes.push_back(pairs[i].first);
+            group_starts.push_back(postings.size());
+        }
+        postings.push_back(pairs[i].second);
+    }
+    group_starts.push_back(postings.size());
+
+    build_table();
+}
+
+
+std::vector<std::string> DeletionIndex::withinDistance(std::string_view s, unsigned int maxDistance) const
+{
+    if (maxDistance > max_distance)
+    {
+        throw DeletionIndexException("This DeletionIndex can't search that far");
+    }
+
+    std::string buffer;
+    std::vector<std::uint64_t> hashes;
+    deletionHashes(s, maxDistance, buffer, hashes);
+
+    std::vector<std::uint32_t> candidates;
+    for (std::uint64_t hash : hashes)
+    {
+        std::uint32_t group = find_group(hash);
+        if (group != group_hashes.size())
+        {
+            candidates.insert(candidates.end(),
+                postings.begin() + group_starts[group], postings.begin() + group_starts[group + 1]);
+        }
+    }
+
+    // Words are numbered in alphabetical order, so sorting the numbers
+    // sorts the words.
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    std::vector<std::string> found;
+    std::vector<unsigned int> rows[3];
+    for (std::uint32_t candidate : candidates)
+    {
+        std::string_view w = word(candidate);
+        if (withinEdits(s, w, maxDistance, rows))
+        {
+            found.emplace_back(w);
+        }
+    }
+    return found;
+}
+
+
+unsigned int DeletionIndex::maxDistance() const noexcept
+{
+    return max_distance;
+}
+
+
+unsigned int DeletionIndex::size() const noexcept
+{
+    return word_starts.size() - 1;
+}
+
+
+std::size_t DeletionIndex::sizeInBytes() const noexcept
+{
+    return arena.capacity() + sizeof(std::uint32_t) * word_starts.capacity()
+        + sizeof(std::uint64_t) * group_hashes.capacity() + sizeof(std::uint32_t) * group_starts.capacity()
+        + sizeof(std::uint32_t) * postings.capacity() + sizeof(std::uint32_t) * table.capacity();
+}
+
+
+std::string_view DeletionIndex::word(std::uint32_t index) const noexcept
+{
+    return std::string_view{arena.data() + word_starts[index], word_starts[index + 1] - word_starts[index]};
+}
+
+
+// Sizes the table to a power of two at least twice the number of groups,
+// then places each group in the first empty slot at or after its hash.
+void DeletionIndex::build_table()
+{
+    std::size_t capacity = 16;
+    while (capacity < group_hashes.size() * 2)
+    {
+        capacity *= 2;
+    }
+    table.assign(capacity, EMPTY);
+
+    for (std::uint32_t g = 0; g < group_hashes.size(); ++g)
+    {
+        std::size_t slot = group_hashes[g] & (capacity - 1);
+        while (table[slot] != EMPTY)
+        {
+            slot = (slot + 1) & (capacity - 1);
+        }
+        table[slot] = g;
+    }
+}
+
+
+std::uint32_t DeletionIndex::find_group(std::uint64_t hash) const noexcept
+{
+    std::size_t mask = table.size() - 1;
+    for (std::size_t slot = hash & mask; table[slot] != EMPTY; slot = (slot + 1) & mask)
+    {
+        if (group_hashes[table[slot]] == hash)
+        {
+            return table[slot];
+        }
+    }
+    return group_hashes.size();
+}
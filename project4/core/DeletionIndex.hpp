@@ -0,0 +1,106 @@
+// DeletionIndex.hpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A DeletionIndex finds the words within a given edit distance of a
+// string with a handful of hash lookups, using the "symmetric delete"
+// approach (as in SymSpell).  When it's built, every word is indexed
+// under each string that deleting up to maxDistance of its letters can
+// leave, including the word itself.  Two strings within distance k of
+// each other always have such a deletion in common, so a search generates
+// the deletions of the string it's given (a few dozen, rather than the
+// 54 or so candidates per letter WordChecker otherwise tries), collects
+// the words indexed under each, and keeps those that are actually close
+// enough.
+//
+// The edits counted are the kinds WordChecker tries: inserting, deleting
+// or replacing a letter, or swapping two adjacent letters.  Any character
+// counts as a letter, though, while WordChecker only ever inserts or
+// replaces 'A' through 'Z'.
+//
+// The index trades memory and build time for lookup speed: a word of n
+// letters has about n deletions at distance 1 and n * n / 2 at distance
+// 2.  The deletions themselves aren't stored, only 64-bit hashes of them,
+// in an open-addressing table, with the words stored back to back in one
+// "arena".  sizeInBytes() says how much memory the index takes.
+
+#ifndef DELETIONINDEX_HPP
+#define DELETIONINDEX_HPP
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+
+class DeletionIndexException : public std::runtime_error
+{
+public:
+    DeletionIndexException(const std::string& reason);
+};
+
+
+inline DeletionIndexException::DeletionIndexException(const std::string& reason)
+    : std::runtime_error{reason}
+{
+}
+
+
+
+class DeletionIndex
+{
+public:
+    // Builds a DeletionIndex of the given words that can find the words
+    // within maxDistance edits of a string.  Duplicates are ignored.
+    explicit DeletionIndex(const std::vector<std::string>& words, unsigned int maxDistance = 1);
+
+
+    // withinDistance() returns every word whose edit distance from the
+    // given string is at most maxDistance (including the string itself,
+    // if it's a word), in alphabetical order.  A DeletionIndexException
+    // is thrown if maxDistance is larger than the index was built for.
+    std::vector<std::string> withinDistance(std::string_view s, unsigned int maxDistance) const;
+
+
+    // maxDistance() returns the largest distance the index can search.
+    unsigned int maxDistance() const noexcept;
+
+    // size() returns the number of words in the index.
+    unsigned int size() const noexcept;
+
+    // sizeInBytes() returns the memory used by the index's words, table
+    // and lists of words.
+    std::size_t sizeInBytes() const noexcept;
+
+
+private:
+    unsigned int max_distance;
+
+    // The words, back to back, where word i starts at word_starts[i] and
+    // ends where word i + 1 starts.
+    std::vector<char> arena;
+    std::vector<std::uint32_t> word_starts;
+
+    // Each distinct deletion hash has a group: the list of words it's
+    // indexed under, which is postings[group_starts[g]] up to where the
+    // next group starts.  The table maps a hash to its group.
+    std::vector<std::uint64_t> group_hashes;
+    std::vector<std::uint32_t> group_starts;
+    std::vector<std::uint32_t> postings;
+    std::vector<std::uint32_t> table;
+
+    std::string_view word(std::uint32_t index) const noexcept;
+
+    void build_table();
+
+    // Returns the group with the given hash, or group_hashes.size() if
+    // there isn't one.
+    std::uint32_t find_group(std::uint64_t hash) const noexcept;
+};
+
+
+
+#endif
@@ -0,0 +1,231 @@
+// EpochReclamation.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include "EpochReclamation.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+
+
+namespace
+{
+    struct Retired
+    {
+        void* node;
+        epochs::Deleter deleter;
+        std::uint64_t epoch;
+    };
+
+
+    // Each thread that has ever used a Guard or retired a node claims a
+    // ThreadRecord.  Records are never deleted; one whose thread exits
+    // is left for the next new thread to claim.
+    struct ThreadRecord
+    {
+        // The epoch the thread saw when it took its outermost Guard, or
+        // 0 when it holds none.
+        std::atomic<std::uint64_t> epoch{0};
+        std::atomic<bool> claimed{false};
+        ThreadRecord* next = nullptr;
+
+        // Only the thread that claimed the record uses these.
+        unsigned int depth = 0;
+        std::vector<Retired> retired;
+    };
+
+
+    // A thread deletes what it can whenever it has retired this many more
+    // nodes.
+    constexpr std::size_t COLLECT_INTERVAL = 128;
+
+    std::atomic<std::uint64_t> globalEpoch{1};
+    std::atomic<ThreadRecord*> records{nullptr};
+
+    // Nodes retired by threads that exited before they could be deleted.
+    std::mutex orphanMutex;
+    std::vector<Retired> orphans;
+
+
+    ThreadRecord* claimRecord()
+    {
+        for (ThreadRecord* record = records.load(); record != nullptr; record = record->next)
+        {
+            bool unclaimed = false;
+            if (record->claimed.compare_exchange_strong(unclaimed, true))
+            {
+                return record;
+            }
+        }
+
+        ThreadRecord* record = new ThreadRecord;
+        record->claimed.store(true);
+        record->next = records.load();
+        while (not records.compare_exchange_weak(record->next, record))
+        {
+        }
+        return record;
+    }
+
+
+    // Returns true if no thread holds a Guard, in which case no thread can
+    // be reading any node that has already been retired.
+    bool quiescent() noexcept
+    {
+        for (ThreadRecord* record = records.load(); record != nullptr; record = record->next)
+        {
+            if (record->epoch.load() != 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+
+    // Advances the global epoch, if every thread holding a Guard has seen
+    // its current value.
+    void tryAdvance() noexcept
+    {
+        std::uint64_t epoch = globalEpoch.load();
+        for (ThreadRecord* record = records.load(); record != nullptr; record = record->next)
+        {
+            std::uint64_t seen = record->epoch.load();
+            if (seen != 0 && seen != epoch)
+            {
+                return;
+            }
+        }
+        globalEpoch.compare_exchange_strong(epoch, epoch + 1);
+    }
+
+
+    // Deletes the nodes in the given list that are safe to delete, given
+    // the current epoch (or all of them, if everything is), and returns
+    // how many it deleted.
+    std::size_t deleteSafe(std::vector<Retired>& retired, std::uint64_t epoch, bool everything)
+    {
+        auto unsafe = [epoch, everything](const Retired& r)
+        {
+            return not everything && r.epoch + 2 > epoch;
+        };
+
+        auto safe = std::stable_partition(retired.begin(), retired.end(), unsafe);
+        std::size_t deleted = retired.end() - safe;
+        for (auto i = safe; i != retired.end(); ++i)
+        {
+            i->deleter(i->node);
+        }
+        retired.erase(safe, retired.end());
+        return deleted;
+    }
+
+
+    std::size_t collectFor(ThreadRecord& record)
+    {
+        tryAdvance();
+        bool everything = quiescent();
+        std::uint64_t epoch = globalEpoch.load();
+
+        std::size_t deleted = deleteSafe(record.retired, epoch, everything);
+
+        std::unique_lock<std::mutex> lock{orphanMutex, std::try_to_lock};
+        if (lock.owns_lock())
+        {
+            deleted += deleteSafe(orphans, epoch, everything);
+        }
+        return deleted;
+    }
+
+
+    // The calling thread's record, which it gives up when it exits.
+    class LocalRecord
+    {
+    public:
+        LocalRecord()
+            : record{claimRecord()}
+        {
+        }
+
+        ~LocalRecord()
+        {
+            collectFor(*record);
+
+            if (not record->retired.empty())
+            {
+                std::lock_guard<std::mutex> lock{orphanMutex};
+                orphans.insert(orphans.end(), record->retired.begin(), record->retired.end());
+                record->retired.clear();
+            }
+            record->retired.shrink_to_fit();
+            record->claimed.store(false);
+        }
+
+        ThreadRecord& get() noexcept
+        {
+            return *record;
+        }
+
+    private:
+        ThreadRecord* record;
+    };
+
+
+    ThreadRecord& localRecord()
+    {
+        thread_local LocalRecord local;
+        return local.get();
+    }
+}
+
+
+
+epochs::Guard::Guard() noexcept
+{
+    ThreadRecord& record = localRecord();
+    if (record.depth++ == 0)
+    {
+        // The record's epoch has to be visible to other threads before
+        // this thread reads any node, which the fence guarantees.
+        record.epoch.store(globalEpoch.load());
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+}
+
+
+epochs::Guard::~Guard() noexcept
+{
+    ThreadRecord& record = localRecord();
+    if (--record.depth == 0)
+    {
+        record.epoch.store(0, std::memory_order_release);
+    }
+}
+
+
+void epochs::retire(void* node, Deleter deleter)
+{
+    ThreadRecord& record = localRecord();
+    record.retired.push_back(Retired{node, deleter, globalEpoch.load()});
+
+    if (record.retired.size() % COLLECT_INTERVAL == 0)
+    {
+        collectFor(record);
+    }
+}
+
+
+std::size_t epochs::collect()
+{
+    return collectFor(localRecord());
+}
+
+
+std::size_t epochs::retiredCount() noexcept
+{
+    return localRecord().retired.size();
+}
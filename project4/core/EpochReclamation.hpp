@@ -0,0 +1,70 @@
+// EpochReclamation.hpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Epoch-based memory reclamation, for lock-free structures whose nodes
+// can be removed while other threads are still reading them.  A thread
+// reads a structure's nodes only while it holds an epochs::Guard.  Once
+// a node has been unlinked, so that no thread can newly reach it, it's
+// passed to epochs::retire() rather than deleted, and it's deleted later,
+// once every thread that held a Guard at the time has let go of it.
+//
+// To know when that is, there's a global epoch number, which can advance
+// only when every thread holding a Guard has seen its current value.
+// A node retired during one epoch is safe to delete two epochs later, by
+// which time every Guard that was held when it was retired is gone.
+// Each thread keeps a list of the nodes it has retired, deleting the safe
+// ones whenever the list grows long; a thread that exits hands its list
+// to whichever thread collects next.  Whenever no thread holds a Guard at
+// all, every retired node is safe to delete at once.
+//
+// One set of epochs is shared by every structure in the program, so a
+// thread may hold Guards for several structures at once, and Guards can
+// be nested.
+
+#ifndef EPOCHRECLAMATION_HPP
+#define EPOCHRECLAMATION_HPP
+
+#include <cstddef>
+
+
+
+namespace epochs
+{
+    // A Deleter deletes one retired node.
+    using Deleter = void (*)(void* node);
+
+
+    // A Guard marks the calling thread as reading shared nodes from the
+    // time it's constructed until it's destroyed, on the same thread.
+    class Guard
+    {
+    public:
+        Guard() noexcept;
+        ~Guard() noexcept;
+
+        Guard(const Guard& g) = delete;
+        Guard& operator=(const Guard& g) = delete;
+    };
+
+
+    // retire() arranges for deleter(node) to be called once no thread
+    // could still be reading the node, which must already be unreachable.
+    void retire(void* node, Deleter deleter);
+
+    // collect() deletes every node retired by the calling thread, or by
+    // threads that have exited, that is safe to delete now, advancing the
+    // epoch if it can.  It's never necessary to call it, but it's useful
+    // when a thread is about to go idle for a while.  It returns the
+    // number of nodes deleted.
+    std::size_t collect();
+
+    // retiredCount() returns the number of nodes the calling thread has
+    // retired that haven't been deleted yet.
+    std::size_t retiredCount() noexcept;
+}
+
+
+
+#endif
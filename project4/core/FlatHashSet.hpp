@@ -0,0 +1,527 @@
+// FlatHashSet.hpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A FlatHashSet is an implementation of a Set that is an open-addressing
+// hash table using Robin Hood hashing.  Unlike HashSet, which allocates a
+// separate linked list node for every element, a FlatHashSet stores its
+// elements inline in one contiguous array, alongside a parallel array of
+// one 32-bit "slot tag" per cell.  Each tag holds how far the element in
+// that cell is from the cell it hashed to (its probe distance) and an
+// 8-bit fragment of its hash, so most cells that can't hold the element
+// being searched for are ruled out without ever touching the element.
+//
+// Robin Hood hashing keeps probe sequences short: when an element being
+// added has travelled farther from its home cell than the element it
+// finds in a cell, they trade places.  As a consequence, a search can
+// stop as soon as it reaches a cell whose element is closer to home than
+// the search has travelled.
+//
+// Removing an element uses "backward shift" deletion rather than leaving
+// a tombstone in its cell: each element after it in the same run of full
+// cells that isn't already in its home cell moves back one cell, closer
+// to home, until reaching an empty cell or an element that is home.  So
+// the table never fills up with tombstones, and searches can keep
+// stopping early, exactly as if the removed element had never been added.
+//
+// The capacity is always a power of two, and the table doubles when it
+// would become more than 7/8 full.  Since the caller's hash function
+// might not spread its results evenly (e.g., hashing an int to itself),
+// every hash is scrambled before it's used.
+
+#ifndef FLATHASHSET_HPP
+#define FLATHASHSET_HPP
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "Set.hpp"
+#include "SetLookupKey.hpp"
+
+
+
+template <typename ElementType, typename HashKeyType = ElementType>
+class FlatHashSet : public Set<ElementType>
+{
+public:
+    // The default capacity of the FlatHashSet before anything has been
+    // added to it.
+    static constexpr unsigned int DEFAULT_CAPACITY = 16;
+
+    // A HashFunction is a function that takes a reference to a const
+    // HashKeyType and returns an unsigned int.  As in HashSet, HashKeyType
+    // is normally ElementType, but can be a lightweight view of it.
+    using HashFunction = std::function<unsigned int(const HashKeyType&)>;
+
+public:
+    // Initializes a FlatHashSet to be empty, so that it will use the given
+    // hash function whenever it needs to hash an element.
+    explicit FlatHashSet(HashFunction hashFunction);
+
+    // Cleans up the FlatHashSet so that it leaks no memory.
+    ~FlatHashSet() noexcept override;
+
+    // Initializes a new FlatHashSet to be a copy of an existing one.
+    FlatHashSet(const FlatHashSet& s);
+
+    // Initializes a new FlatHashSet whose contents are moved from an
+    // expiring one.
+    FlatHashSet(FlatHashSet&& s) noexcept;
+
+    // Assigns an existing FlatHashSet into another.
+    FlatHashSet& operator=(const FlatHashSet& s);
+
+    // Assigns an expiring FlatHashSet into another.
+    FlatHashSet& operator=(FlatHashSet&& s) noexcept;
+
+
+    bool isImplemented() const noexcept override;
+
+
+    // add() adds an element to the set.  If the element is already in the
+    // set, this function has no effect.  The table doubles in size when
+    // it would become more than 7/8 full, so this function runs in
+    // amortized constant time (assuming a good hash function).
+    void add(const ElementType& element) override;
+
+    // This overload of add() moves the given element into the set, rather
+    // than copying it, if it's not already there.
+    void add(ElementType&& element);
+
+    // emplace() builds an element from the given arguments, then adds it
+    // as add() does.
+    template <typename... Args>
+    void emplace(Args&&... args);
+
+
+    // contains() returns true if the given element is already in the set,
+    // false otherwise.  This function runs in constant time (assuming a
+    // good hash function).
+    bool contains(const ElementType& element) const override;
+
+    // This overload of contains() looks up a key of the HashKeyType, when
+    // that's a lightweight view of ElementType, without converting it to
+    // an ElementType.
+    template <typename Key, typename = std::enable_if_t<
+        std::is_same_v<Key, HashKeyType> && IsSetLookupKey<ElementType, Key>>>
+    bool contains(const Key& key) const;
+
+
+    // remove() removes the given element from the set, returning true if
+    // it was there and false if it wasn't.  It runs in constant time
+    // (assuming a good hash function), and the table never shrinks.
+    bool remove(const ElementType& element);
+
+    // This overload of remove() looks up a key of the HashKeyType, as the
+    // corresponding overload of contains() does.
+    template <typename Key, typename = std::enable_if_t<
+        std::is_same_v<Key, HashKeyType> && IsSetLookupKey<ElementType, Key>>>
+    bool remove(const Key& key);
+
+
+    // size() returns the number of elements in the set.
+    unsigned int size() const noexcept override;
+
+    // version() returns a number that changes whenever the set's elements
+    // do, as HashSet's does.
+    unsigned long long version() const noexcept;
+
+
+    // capacity() returns the number of cells in the table.
+    unsigned int capacity() const noexcept;
+
+
+private:
+    static constexpr std::uint32_t EMPTY = 0;
+
+    HashFunction hashFunction;
+    unsigned int cell_count;
+    unsigned int shift;
+    unsigned int element_count;
+    unsigned long long version_number = 0;
+
+    // tags[i] is EMPTY when cell i is empty; otherwise, its upper 24 bits
+    // are one more than the probe distance of the element in cell i and
+    // its lower 8 bits are a fragment of that element's hash.  Only the
+    // cells whose tags aren't EMPTY hold a constructed element.
+    std::uint32_t* tags;
+    ElementType* cells;
+
+    std::uint32_t scramble(const HashKeyType& key) const;
+
+    template <typename Key>
+    bool contains_key(const Key& key) const;
+
+    // Returns the index of the cell holding the given key, or cell_count
+    // if there isn't one.
+    template <typename Key>
+    unsigned int find_cell(const Key& key) const;
+
+    template <typename Key>
+    bool remove_key(const Key& key);
+
+    template <typename E>
+    void add_element(E&& element);
+
+    void allocate(unsigned int cap);
+    void release() noexcept;
+    void grow();
+
+    // Places an element known not to be in the set, without resizing.
+    void insert_unique(ElementType element, std::uint32_t hash);
+    void copy_from(const FlatHashSet& s);
+};
+
+
+
+template <typename ElementType, typename HashKeyType>
+FlatHashSet<ElementType, HashKeyType>::FlatHashSet(HashFunction hashFunction)
+    : hashFunction{hashFunction}, cell_count{0}, shift{32}, element_count{0}, tags{nullptr}, cells{nullptr}
+{
+    allocate(DEFAULT_CAPACITY);
+}
+
+
+template <typename ElementType, typename HashKeyType>
+FlatHashSet<ElementType, HashKeyType>::~FlatHashSet() noexcept
+{
+    release();
+}
+
+
+template <typename ElementType, typename HashKeyType>
+FlatHashSet<ElementType, HashKeyType>::FlatHashSet(const FlatHashSet& s)
+    : hashFunction{s.hashFunction}, cell_count{0}, shift{32}, element_count{0}, tags{nullptr}, cells{nullptr}
+{
+    copy_from(s);
+}
+
+
+template <typename ElementType, typename HashKeyType>
+FlatHashSet<ElementType, HashKeyType>::FlatHashSet(FlatHashSet&& s) noexcept
+    : hashFunction{s.hashFunction}, cell_count{0}, shift{32}, element_count{0}, tags{nullptr}, cells{nullptr}
+{
+    std::swap(cell_count, s.cell_count);
+    std::swap(shift, s.shift);
+    std::swap(element_count, s.element_count);
+    std::swap(tags, s.tags);
+    std::swap(cells, s.cells);
+    s.version_number++;
+}
+
+
+template <typename ElementType, typename HashKeyType>
+FlatHashSet<ElementType, HashKeyType>& FlatHashSet<ElementType, HashKeyType>::operator=(const FlatHashSet& s)
+{
+    if (this != &s)
+    {
+        release();
+        hashFunction = s.hashFunction;
+        copy_from(s);
+        version_number++;
+    }
+    return *this;
+}
+
+
+template <typename ElementType, typename HashKeyType>
+FlatHashSet<ElementType, HashKeyType>& FlatHashSet<ElementType, HashKeyType>::operator=(FlatHashSet&& s) noexcept
+{
+    std::swap(hashFunction, s.hashFunction);
+    std::swap(cell_count, s.cell_count);
+    std::swap(shift, s.shift);
+    std::swap(element_count, s.element_count);
+    std::swap(tags, s.tags);
+    std::swap(cells, s.cells);
+    version_number++;
+    s.version_number++;
+    return *this;
+}
+
+
+template <typename ElementType, typename HashKeyType>
+bool FlatHashSet<ElementType, HashKeyType>::isImplemented() const noexcept
+{
+    return true;
+}
+
+
+template <typename ElementType, typename HashKeyType>
+void FlatHashSet<ElementType, HashKeyType>::add(const ElementType& element)
+{
+    add_element(element);
+}
+
+
+template <typename ElementType, typename HashKeyType>
+void FlatHashSet<ElementType, HashKeyType>::add(ElementType&& element)
+{
+    add_element(std::move(element));
+}
+
+
+template <typename ElementType, typename HashKeyType>
+template <typename... Args>
+void FlatHashSet<ElementType, HashKeyType>::emplace(Args&&... args)
+{
+    add_element(ElementType(std::forward<Args>(args)...));
+}
+
+
+template <typename ElementType, typename HashKeyType>
+bool FlatHashSet<ElementType, HashKeyType>::contains(const ElementType& element) const
+{
+    return contains_key(element);
+}
+
+
+template <typename ElementType, typename HashKeyType>
+template <typename Key, typename>
+bool FlatHashSet<ElementType, HashKeyType>::contains(const Key& key) const
+{
+    return contains_key(key);
+}
+
+
+template <typename ElementType, typename HashKeyType>
+bool FlatHashSet<ElementType, HashKeyType>::remove(const ElementType& element)
+{
+    return remove_key(element);
+}
+
+
+template <typename ElementType, typename HashKeyType>
+template <typename Key, typename>
+bool FlatHashSet<ElementType, HashKeyType>::remove(const Key& key)
+{
+    return remove_key(key);
+}
+
+
+template <typename ElementType, typename HashKeyType>
+unsigned int FlatHashSet<ElementType, HashKeyType>::size() const noexcept
+{
+    return element_count;
+}
+
+
+template <typename ElementType, typename HashKeyType>
+unsigned long long FlatHashSet<ElementType, HashKeyType>::version() const noexcept
+{
+    return version_number;
+}
+
+
+template <typename ElementType, typename HashKeyType>
+unsigned int FlatHashSet<ElementType, HashKeyType>::capacity() const noexcept
+{
+    return cell_count;
+}
+
+
+// Fibonacci hashing: multiplying by 2^32 / phi spreads the caller's hash
+// across all 32 bits, so the top bits can pick the home cell.
+template <typename ElementType, typename HashKeyType>
+std::uint32_t FlatHashSet<ElementType, HashKeyType>::scramble(const HashKeyType& key) const
+{
+    return static_cast<std::uint32_t>(hashFunction(key)) * 2654435769u;
+}
+
+
+template <typename ElementType, typename HashKeyType>
+template <typename Key>
+bool FlatHashSet<ElementType, HashKeyType>::contains_key(const Key& key) const
+{
+    return find_cell(key) != cell_count;
+}
+
+
+template <typename ElementType, typename HashKeyType>
+template <typename Key>
+unsigned int FlatHashSet<ElementType, HashKeyType>::find_cell(const Key& key) const
+{
+    if (element_count == 0)
+    {
+        return cell_count;
+    }
+
+    std::uint32_t hash = scramble(key);
+    std::uint32_t fragment = hash & 0xff;
+    unsigned int mask = cell_count - 1;
+    unsigned int index = hash >> shift;
+
+    for (std::uint32_t distance = 1; ; distance++)
+    {
+        std::uint32_t tag = tags[index];
+        if (tag == EMPTY || (tag >> 8) < distance)
+        {
+            return cell_count;
+        }
+        if ((tag & 0xff) == fragment && (tag >> 8) == distance && cells[index] == key)
+        {
+            return index;
+        }
+        index = (index + 1) & mask;
+    }
+}
+
+
+template <typename ElementType, typename HashKeyType>
+template <typename E>
+void FlatHashSet<ElementType, HashKeyType>::add_element(E&& element)
+{
+    if (contains_key(element))
+    {
+        return;
+    }
+    if ((element_count + 1) * 8 > cell_count * 7)
+    {
+        grow();
+    }
+    std::uint32_t hash = scramble(element);
+    insert_unique(std::forward<E>(element), hash);
+    element_count++;
+    version_number++;
+}
+
+
+// Moves each element after the removed one back a cell, decreasing its
+// probe distance, until reaching an empty cell or an element with a probe
+// distance of 1 (i.e., one that's in its home cell and can't move back).
+template <typename ElementType, typename HashKeyType>
+template <typename Key>
+bool FlatHashSet<ElementType, HashKeyType>::remove_key(const Key& key)
+{
+    unsigned int index = find_cell(key);
+    if (index == cell_count)
+    {
+        return false;
+    }
+
+    unsigned int mask = cell_count - 1;
+    cells[index].~ElementType();
+    for (unsigned int next = (index + 1) & mask; (tags[next] >> 8) > 1; next = (next + 1) & mask)
+    {
+        new (&cells[index]) ElementType{std::move(cells[next])};
+        cells[next].~ElementType();
+        tags[index] = tags[next] - (1u << 8);
+        index = next;
+    }
+    tags[index] = EMPTY;
+
+    element_count--;
+    version_number++;
+    return true;
+}
+
+
+template <typename ElementType, typename HashKeyType>
+void FlatHashSet<ElementType, HashKeyType>::allocate(unsigned int cap)
+{
+    cell_count = cap;
+    shift = 32;
+    for (unsigned int c = cap; c > 1; c >>= 1)
+    {
+        shift--;
+    }
+    tags = new std::uint32_t[cap]();
+    cells = static_cast<ElementType*>(::operator new(sizeof(ElementType) * cap, std::align_val_t{alignof(ElementType)}));
+}
+
+
+template <typename ElementType, typename HashKeyType>
+void FlatHashSet<ElementType, HashKeyType>::release() noexcept
+{
+    if (tags == nullptr)
+    {
+        return;
+    }
+    for (unsigned int i = 0; i < cell_count; i++)
+    {
+        if (tags[i] != EMPTY)
+        {
+            cells[i].~ElementType();
+        }
+    }
+    delete[] tags;
+    ::operator delete(cells, std::align_val_t{alignof(ElementType)});
+    tags = nullptr;
+    cells = nullptr;
+    cell_count = 0;
+    element_count = 0;
+}
+
+
+template <typename ElementType, typename HashKeyType>
+void FlatHashSet<ElementType, HashKeyType>::grow()
+{
+    std::uint32_t* old_tags = tags;
+    ElementType* old_cells = cells;
+    unsigned int old_count = cell_count;
+
+    allocate(cell_count == 0 ? DEFAULT_CAPACITY : cell_count * 2);
+    for (unsigned int i = 0; i < old_count; i++)
+    {
+        if (old_tags[i] != EMPTY)
+        {
+            std::uint32_t hash = scramble(old_cells[i]);
+            insert_unique(std::move(old_cells[i]), hash);
+            old_cells[i].~ElementType();
+        }
+    }
+
+    delete[] old_tags;
+    ::operator delete(old_cells, std::align_val_t{alignof(ElementType)});
+}
+
+
+template <typename ElementType, typename HashKeyType>
+void FlatHashSet<ElementType, HashKeyType>::insert_unique(ElementType element, std::uint32_t hash)
+{
+    unsigned int mask = cell_count - 1;
+    unsigned int index = hash >> shift;
+    std::uint32_t tag = (1u << 8) | (hash & 0xff);
+
+    while (true)
+    {
+        if (tags[index] == EMPTY)
+        {
+            new (&cells[index]) ElementType{std::move(element)};
+            tags[index] = tag;
+            return;
+        }
+        if ((tags[index] >> 8) < (tag >> 8))
+        {
+            // The resident is closer to home than we are, so it gives up
+            // its cell and continues the search in our place.
+            std::swap(cells[index], element);
+            std::swap(tags[index], tag);
+        }
+        index = (index + 1) & mask;
+        tag += 1u << 8;
+    }
+}
+
+
+template <typename ElementType, typename HashKeyType>
+void FlatHashSet<ElementType, HashKeyType>::copy_from(const FlatHashSet& s)
+{
+    allocate(s.cell_count);
+    for (unsigned int i = 0; i < s.cell_count; i++)
+    {
+        if (s.tags[i] != EMPTY)
+        {
+            new (&cells[i]) ElementType{s.cells[i]};
+        }
+        tags[i] = s.tags[i];
+    }
+    element_count = s.element_count;
+}
+
+
+
+#endif
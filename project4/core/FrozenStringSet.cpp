@@ -0,0 +1,405 @@
+// FrozenStringSet.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include "FrozenStringSet.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "HashFunctions.hpp"
+
+
+
+namespace
+{
+    const std::uint32_t MAGIC = 0x31535346;  // "FSS1"
+
+    // The average number of words per bucket.  Larger buckets take less
+    // memory, but take longer to place.
+    const std::uint32_t WORDS_PER_BUCKET = 3;
+
+    // A displacement with this bit set is the slot of its bucket's only
+    // word, rather than a number to mix with the word's hash.
+    const std::uint32_t DIRECT_SLOT = 0x80000000u;
+
+    // If any bucket can't be placed within this many displacements, the
+    // builder starts over with a different seed.
+    const std::uint32_t MAX_DISPLACEMENT = 1u << 20;
+
+    const unsigned int MAX_SEEDS = 64;
+
+
+    // Maps a 32-bit value to the range 0 .. range - 1 without division.
+    std::uint32_t reduce(std::uint32_t value, std::uint32_t range)
+    {
+        return static_cast<std::uint32_t>((static_cast<std::uint64_t>(value) * range) >> 32);
+    }
+
+    std::uint32_t bucketOf(std::uint64_t hash, std::uint32_t bucketCount)
+    {
+        return reduce(static_cast<std::uint32_t>(hash), bucketCount);
+    }
+
+    std::uint32_t slotOf(std::uint64_t hash, std::uint32_t displacement, std::uint32_t wordCount)
+    {
+        std::uint64_t mixed = hashing::detail::multiplyFold(
+            hash ^ 0xe7037ed1a0b428dbull, (displacement * 0x9e3779b97f4a7c15ull) ^ 0x8ebc6af09c88c6dbull);
+        return reduce(static_cast<std::uint32_t>(mixed >> 32), wordCount);
+    }
+
+
+    std::size_t alignedSize(std::size_t size)
+    {
+        return (size + 7) / 8 * 8;
+    }
+
+
+    // Assigns every word a slot, filling in the displacements.  Returns
+    // false if some bucket couldn't be placed.
+    bool place(const std::vector<std::uint64_t>& hashes, std::uint32_t bucketCount,
+        std::vector<std::uint32_t>& displacements, std::vector<std::uint32_t>& slotOfWord)
+    {
+        std::uint32_t wordCount = hashes.size();
+
+        // Group the words by bucket, then order the buckets from largest
+        // to smallest, with a counting sort each time.
+        std::vector<std::uint32_t> bucketStart(bucketCount + 1, 0);
+        for (std::uint64_t hash : hashes)
+        {
+            bucketStart[bucketOf(hash, bucketCount) + 1]++;
+        }
+        std::uint32_t largest = 0;
+        for (std::uint32_t b = 0; b < bucketCount; ++b)
+        {
+            largest = std::max(largest, bucketStart[b + 1]);
+            bucketStart[b + 1] += bucketStart[b];
+        }
+        std::vector<std::uint32_t> wordsByBucket(wordCount);
+        std::vector<std::uint32_t> next(bucketStart.begin(), bucketStart.end() - 1);
+        for (std::uint32_t w = 0; w < wordCount; ++w)
+        {
+            wordsByBucket[next[bucketOf(hashes[w], bucketCount)]++] = w;
+        }
+
+        std::vector<std::vector<std::uint32_t>> bucketsBySize(largest + 1);
+        for (std::uint32_t b = 0; b < bucketCount; ++b)
+        {
+            bucketsBySize[bucketStart[b + 1] - bucketStart[b]].push_back(b);
+        }
+
+        std::vector<bool> taken(wordCount, false);
+        std::vector<std::uint32_t> candidate;
+        displacements.assign(bucketCount, 0);
+        slotOfWord.assign(wordCount, 0);
+
+        for (std::uint32_t size = largest; size >= 2; --size)
+        {
+            for (std::uint32_t b : bucketsBySize[size])
+            {
+                const std::uint32_t* words = &wordsByBucket[bucketStart[b]];
+                std::uint32_t d = 1;
+                for (; d < MAX_DISPLACEMENT; ++d)
+                {
+                    candidate.clear();
+                    for (std::uint32_t i = 0; i < size; ++i)
+                    {
+                        std::uint32_t slot = slotOf(hashes[words[i]], d, wordCount);
+                        if (taken[slot] || std::find(candidate.begin(), candidate.end(), slot) != candidate.end())
+                        {
+                            break;
+                        }
+                        candidate.push_back(slot);
+                    }
+                    if (candidate.size() == size)
+                    {
+                        break;
+                    }
+                }
+                if (d == MAX_DISPLACEMENT)
+                {
+                    return false;
+                }
+
+                displacements[b] = d;
+                for (std::uint32_t i = 0; i < size; ++i)
+                {
+                    taken[candidate[i]] = true;
+                    slotOfWord[words[i]] = candidate[i];
+                }
+            }
+        }
+
+        std::uint32_t freeSlot = 0;
+        if (largest >= 1)
+        {
+            for (std::uint32_t b : bucketsBySize[1])
+            {
+                while (taken[freeSlot])
+                {
+                    freeSlot++;
+                }
+                taken[freeSlot] = true;
+                displacements[b] = DIRECT_SLOT | freeSlot;
+                slotOfWord[wordsByBucket[bucketStart[b]]] = freeSlot;
+            }
+        }
+
+        return true;
+    }
+}
+
+
+
+FrozenStringSet::FrozenStringSet()
+    : mapping{nullptr}, mapping_length{0}, header{MAGIC, 0, 0, 0, 0},
+      displacements{nullptr}, slots{nullptr}, arena{nullptr}
+{
+}
+
+
+FrozenStringSet::FrozenStringSet(const std::vector<std::string>& words)
+    : FrozenStringSet{}
+{
+    std::vector<std::string_view> unique{words.begin(), words.end()};
+    std::sort(unique.begin(), unique.end());
+    unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+
+    std::size_t arenaSize = 0;
+    for (std::string_view word : unique)
+    {
+        arenaSize += word.size();
+    }
+    if (unique.size() >= DIRECT_SLOT || arenaSize > 0xffffffffu)
+    {
+        throw FrozenStringSetException("Too many words for a FrozenStringSet");
+    }
+
+    std::uint32_t wordCount = unique.size();
+    std::uint32_t bucketCount = std::max<std::uint32_t>(1, (wordCount + WORDS_PER_BUCKET - 1) / WORDS_PER_BUCKET);
+    std::vector<std::uint64_t> hashes(wordCount);
+    std::vector<std::uint32_t> bucketDisplacements;
+    std::vector<std::uint32_t> slotOfWord;
+
+    std::uint64_t seed = 0;
+    for (unsigned int attempt = 0; ; ++attempt)
+    {
+        if (attempt == MAX_SEEDS)
+        {
+            throw FrozenStringSetException("Cannot build a perfect hash function for these words");
+        }
+
+        seed = attempt * 0x9e3779b97f4a7c15ull;
+        for (std::uint32_t w = 0; w < wordCount; ++w)
+        {
+            hashes[w] = hashing::wyhash64(unique[w], seed);
+        }
+        if (place(hashes, bucketCount, bucketDisplacements, slotOfWord))
+        {
+            break;
+        }
+    }
+
+    std::vector<std::uint32_t> wordInSlot(wordCount);
+    for (std::uint32_t w = 0; w < wordCount; ++w)
+    {
+        wordInSlot[slotOfWord[w]] = w;
+    }
+
+    std::size_t displacementsOffset = alignedSize(sizeof(Header));
+    std::size_t slotsOffset = displacementsOffset + alignedSize(sizeof(std::uint32_t) * bucketCount);
+    std::size_t arenaOffset = slotsOffset + alignedSize(sizeof(std::uint32_t) * (wordCount + 1));
+    owned.assign(arenaOffset + arenaSize, 0);
+
+    Header built{MAGIC, wordCount, bucketCount, static_cast<std::uint32_t>(arenaSize), seed};
+    std::memcpy(owned.data(), &built, sizeof(built));
+    std::memcpy(owned.data() + displacementsOffset, bucketDisplacements.data(), sizeof(std::uint32_t) * bucketCount);
+
+    // The slots are where each slot's word starts in the arena, plus where
+    // the last one ends, so that each word's length is the difference
+    // between its slot and the next.
+    std::uint32_t* slotStarts = reinterpret_cast<std::uint32_t*>(owned.data() + slotsOffset);
+    char* arenaBytes = owned.data() + arenaOffset;
+    std::uint32_t position = 0;
+    for (std::uint32_t slot = 0; slot < wordCount; ++slot)
+    {
+        std::string_view word = unique[wordInSlot[slot]];
+        slotStarts[slot] = position;
+        std::memcpy(arenaBytes + position, word.data(), word.size());
+        position += word.size();
+    }
+    slotStarts[wordCount] = position;
+
+    attach(owned.data(), owned.size());
+}
+
+
+FrozenStringSet FrozenStringSet::load(const std::string& path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw FrozenStringSetException("Cannot open " + path);
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(Header)))
+    {
+        ::close(fd);
+        throw FrozenStringSetException("Not a FrozenStringSet file: " + path);
+    }
+
+    std::size_t length = info.st_size;
+    void* mapped = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED)
+    {
+        throw FrozenStringSetException("Cannot map " + path);
+    }
+
+    FrozenStringSet s;
+    s.mapping = mapped;
+    s.mapping_length = length;
+    try
+    {
+        s.attach(static_cast<const char*>(mapped), length);
+    }
+    catch (const FrozenStringSetException&)
+    {
+        throw FrozenStringSetException("Not a FrozenStringSet file: " + path);
+    }
+    return s;
+}
+
+
+FrozenStringSet::~FrozenStringSet() noexcept
+{
+    if (mapping != nullptr)
+    {
+        ::munmap(mapping, mapping_length);
+    }
+}
+
+
+FrozenStringSet::FrozenStringSet(FrozenStringSet&& s) noexcept
+    : FrozenStringSet{}
+{
+    *this = std::move(s);
+}
+
+
+FrozenStringSet& FrozenStringSet::operator=(FrozenStringSet&& s) noexcept
+{
+    // Moving a std::vector doesn't move its elements, so the pointers
+    // into an owned buffer stay valid as they're swapped along with it.
+    std::swap(owned, s.owned);
+    std::swap(mapping, s.mapping);
+    std::swap(mapping_length, s.mapping_length);
+    std::swap(header, s.header);
+    std::swap(displacements, s.displacements);
+    std::swap(slots, s.slots);
+    std::swap(arena, s.arena);
+    return *this;
+}
+
+
+void FrozenStringSet::save(const std::string& path) const
+{
+    std::size_t length = alignedSize(sizeof(Header)) + alignedSize(sizeof(std::uint32_t) * header.bucketCount)
+        + alignedSize(sizeof(std::uint32_t) * (header.wordCount + 1)) + header.arenaSize;
+    const char* bytes = owned.empty() ? static_cast<const char*>(mapping) : owned.data();
+
+    std::ofstream out{path, std::ios::binary | std::ios::trunc};
+    if (bytes == nullptr || not out.write(bytes, length))
+    {
+        throw FrozenStringSetException("Cannot write " + path);
+    }
+}
+
+
+bool FrozenStringSet::isImplemented() const noexcept
+{
+    return true;
+}
+
+
+void FrozenStringSet::add(const std::string&)
+{
+    throw FrozenStringSetException("Cannot add to a FrozenStringSet");
+}
+
+
+bool FrozenStringSet::contains(const std::string& element) const
+{
+    return contains_view(element);
+}
+
+
+unsigned int FrozenStringSet::size() const noexcept
+{
+    return header.wordCount;
+}
+
+
+bool FrozenStringSet::contains_view(std::string_view word) const noexcept
+{
+    if (header.wordCount == 0)
+    {
+        return false;
+    }
+
+    std::uint64_t hash = hashing::wyhash64(word, header.seed);
+    std::uint32_t displacement = displacements[bucketOf(hash, header.bucketCount)];
+    std::uint32_t slot = (displacement & DIRECT_SLOT)
+        ? displacement & ~DIRECT_SLOT
+        : slotOf(hash, displacement, header.wordCount);
+
+    std::uint32_t start = slots[slot];
+    return slots[slot + 1] - start == word.size() && std::memcmp(arena + start, word.data(), word.size()) == 0;
+}
+
+
+// Points the FrozenStringSet into the given bytes, laid out as save()
+// writes them, after checking that they're laid out that way.  Every
+// displacement and slot is checked, too, so that lookups in a corrupt
+// file can never read outside of it.
+void FrozenStringSet::attach(const char* bytes, std::size_t length)
+{
+    std::memcpy(&header, bytes, sizeof(header));
+
+    std::size_t displacementsOffset = alignedSize(sizeof(Header));
+    std::size_t slotsOffset = displacementsOffset + alignedSize(sizeof(std::uint32_t) * std::size_t{header.bucketCount});
+    std::size_t arenaOffset = slotsOffset + alignedSize(sizeof(std::uint32_t) * (std::size_t{header.wordCount} + 1));
+    if (header.magic != MAGIC || header.bucketCount == 0 || arenaOffset + header.arenaSize != length)
+    {
+        header = Header{MAGIC, 0, 0, 0, 0};
+        throw FrozenStringSetException("Not a FrozenStringSet");
+    }
+
+    displacements = reinterpret_cast<const std::uint32_t*>(bytes + displacementsOffset);
+    slots = reinterpret_cast<const std::uint32_t*>(bytes + slotsOffset);
+    arena = bytes + arenaOffset;
+
+    bool valid = slots[header.wordCount] == header.arenaSize;
+
+    for (std::uint32_t b = 0; valid && b < header.bucketCount; ++b)
+    {
+        std::uint32_t displacement = displacements[b];
+        valid = !(displacement & DIRECT_SLOT) || (displacement & ~DIRECT_SLOT) < header.wordCount;
+    }
+
+    for (std::uint32_t slot = 0; valid && slot < header.wordCount; ++slot)
+    {
+        valid = slots[slot] <= slots[slot + 1];
+    }
+
+    if (!valid)
+    {
+        header = Header{MAGIC, 0, 0, 0, 0};
+        throw FrozenStringSetException("Not a FrozenStringSet");
+    }
+}
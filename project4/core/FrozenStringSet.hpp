@@ -0,0 +1,141 @@
+// FrozenStringSet.hpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A FrozenStringSet is a Set of strings whose contents are fixed when
+// it's built, such as a dictionary that's loaded once and then only
+// searched.  Knowing every word ahead of time allows it to use a
+// "minimal perfect hash function": one that maps each of its n words to
+// a different index from 0 to n - 1.  So every word has a slot of its
+// own, there are no empty slots and no collisions, and a lookup hashes
+// the word, reads one slot and compares one string.
+//
+// The hash function follows the "hash, displace and compress" (CHD)
+// approach.  Each word hashes to one of about n / 3 buckets, and each
+// bucket stores a displacement: a number that, mixed with the hash of
+// any word in that bucket, gives that word's slot.  The builder places
+// the biggest buckets first, trying displacements until it finds one that
+// sends all of a bucket's words to empty slots, and finally assigns each
+// one-word bucket whatever empty slot is left, storing the slot itself.
+//
+// The words are stored back to back in one contiguous "arena", in slot
+// order, so a slot is just where its word starts.  The whole structure
+// (a header, the displacements, the slots and the arena) is laid out
+// exactly as save() writes it to a file, so load() can memory-map the
+// file and use it without reading or building anything.
+//
+// Calling add() on a FrozenStringSet throws a FrozenStringSetException.
+
+#ifndef FROZENSTRINGSET_HPP
+#define FROZENSTRINGSET_HPP
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "Set.hpp"
+
+
+
+class FrozenStringSetException : public std::runtime_error
+{
+public:
+    FrozenStringSetException(const std::string& reason);
+};
+
+
+inline FrozenStringSetException::FrozenStringSetException(const std::string& reason)
+    : std::runtime_error{reason}
+{
+}
+
+
+
+class FrozenStringSet : public Set<std::string>
+{
+public:
+    // Builds a FrozenStringSet containing the given words.  Duplicates are
+    // ignored.  This takes linear time on average.
+    explicit FrozenStringSet(const std::vector<std::string>& words);
+
+    // load() returns the FrozenStringSet that save() wrote to the given
+    // file, memory-mapping it rather than reading it, so the file has to
+    // stay where it is for as long as the FrozenStringSet exists.  A
+    // FrozenStringSetException is thrown if the file can't be mapped or
+    // isn't a saved FrozenStringSet.
+    static FrozenStringSet load(const std::string& path);
+
+    ~FrozenStringSet() noexcept override;
+
+    // A FrozenStringSet can be moved, but not copied.
+    FrozenStringSet(FrozenStringSet&& s) noexcept;
+    FrozenStringSet& operator=(FrozenStringSet&& s) noexcept;
+    FrozenStringSet(const FrozenStringSet& s) = delete;
+    FrozenStringSet& operator=(const FrozenStringSet& s) = delete;
+
+
+    // save() writes the FrozenStringSet to the given file, throwing a
+    // FrozenStringSetException if it can't.  The file can only be loaded
+    // on a machine with the same byte order.
+    void save(const std::string& path) const;
+
+
+    bool isImplemented() const noexcept override;
+
+    // add() throws a FrozenStringSetException, since a FrozenStringSet
+    // can't be changed.
+    void add(const std::string& element) override;
+
+    // contains() returns true if the given word is in the set, false
+    // otherwise, in constant time.
+    bool contains(const std::string& element) const override;
+
+    // This overload of contains() looks up a std::string_view.
+    template <typename Key, typename = std::enable_if_t<std::is_same_v<Key, std::string_view>>>
+    bool contains(const Key& key) const;
+
+    unsigned int size() const noexcept override;
+
+
+private:
+    struct Header
+    {
+        std::uint32_t magic;
+        std::uint32_t wordCount;
+        std::uint32_t bucketCount;
+        std::uint32_t arenaSize;
+        std::uint64_t seed;
+    };
+
+    // The owned bytes of a FrozenStringSet that was built, or the mapped
+    // bytes of one that was loaded.
+    std::vector<char> owned;
+    void* mapping;
+    std::size_t mapping_length;
+
+    Header header;
+    const std::uint32_t* displacements;
+    const std::uint32_t* slots;
+    const char* arena;
+
+    FrozenStringSet();
+
+    bool contains_view(std::string_view word) const noexcept;
+
+    void attach(const char* bytes, std::size_t length);
+};
+
+
+
+template <typename Key, typename>
+bool FrozenStringSet::contains(const Key& key) const
+{
+    return contains_view(key);
+}
+
+
+
+#endif
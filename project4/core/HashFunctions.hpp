@@ -0,0 +1,235 @@
+// HashFunctions.hpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Ready-made hash functions for strings and ints, any of which can be
+// passed to a HashSet or FlatHashSet.  Each one is fast and mixes every
+// bit of its input into every bit of its output, so that elements spread
+// out evenly no matter how alike they are, which simple hash functions
+// (such as adding up the characters, or using an int as its own hash)
+// don't achieve.
+//
+// The string hash functions take a std::string_view, so they can hash a
+// std::string or, in a HashSet<std::string, std::string_view>, a view.
+//
+//   * wyhashString() follows the design of wyhash: it reads eight bytes
+//     at a time, and mixes them with 64-bit multiplications whose 128-bit
+//     products are folded in half.  It's the fastest choice for strings,
+//     on platforms with 128-bit multiplication.
+//
+//     wyhash64() is the same function, with a seed and all 64 bits of its
+//     result, for when 32 bits aren't enough or independent hash
+//     functions are needed (as in FrozenStringSet).
+//
+//   * xxhashString() is the 32-bit xxHash (XXH32) algorithm with a seed
+//     of 0, which sticks to 32-bit arithmetic.
+//
+//   * mixInt() scrambles an int with the finalizer from MurmurHash3,
+//     which is a good replacement for using an int as its own hash.
+
+#ifndef HASHFUNCTIONS_HPP
+#define HASHFUNCTIONS_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+
+
+namespace hashing
+{
+    unsigned int wyhashString(std::string_view s) noexcept;
+    std::uint64_t wyhash64(std::string_view s, std::uint64_t seed) noexcept;
+    unsigned int xxhashString(std::string_view s) noexcept;
+    unsigned int mixInt(const int& i) noexcept;
+}
+
+
+
+namespace hashing::detail
+{
+    inline std::uint64_t read64(const unsigned char* p) noexcept
+    {
+        std::uint64_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+
+    inline std::uint32_t read32(const unsigned char* p) noexcept
+    {
+        std::uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+
+    inline std::uint32_t rotateLeft(std::uint32_t x, int bits) noexcept
+    {
+        return (x << bits) | (x >> (32 - bits));
+    }
+
+
+    // Multiplies a and b into a 128-bit product, then returns the
+    // exclusive-or of its two halves.
+    inline std::uint64_t multiplyFold(std::uint64_t a, std::uint64_t b) noexcept
+    {
+#ifdef __SIZEOF_INT128__
+        unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+        return static_cast<std::uint64_t>(product) ^ static_cast<std::uint64_t>(product >> 64);
+#else
+        std::uint64_t aHigh = a >> 32, aLow = static_cast<std::uint32_t>(a);
+        std::uint64_t bHigh = b >> 32, bLow = static_cast<std::uint32_t>(b);
+        std::uint64_t high = aHigh * bHigh, low = aLow * bLow;
+        std::uint64_t middle1 = aHigh * bLow, middle2 = aLow * bHigh;
+        std::uint64_t carry = ((low >> 32) + static_cast<std::uint32_t>(middle1) + static_cast<std::uint32_t>(middle2)) >> 32;
+        std::uint64_t productLow = low + (middle1 << 32) + (middle2 << 32);
+        std::uint64_t productHigh = high + (middle1 >> 32) + (middle2 >> 32) + carry;
+        return productLow ^ productHigh;
+#endif
+    }
+}
+
+
+
+inline unsigned int hashing::wyhashString(std::string_view s) noexcept
+{
+    std::uint64_t hash = wyhash64(s, 0);
+    return static_cast<unsigned int>(hash ^ (hash >> 32));
+}
+
+
+inline std::uint64_t hashing::wyhash64(std::string_view s, std::uint64_t seed) noexcept
+{
+    constexpr std::uint64_t P0 = 0xa0761d6478bd642full;
+    constexpr std::uint64_t P1 = 0xe7037ed1a0b428dbull;
+    constexpr std::uint64_t P2 = 0x8ebc6af09c88c6dbull;
+    constexpr std::uint64_t P3 = 0x589965cc75374cc3ull;
+
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(s.data());
+    std::size_t length = s.size();
+    seed ^= P0;
+    std::uint64_t a;
+    std::uint64_t b;
+
+    if (length <= 16)
+    {
+        if (length >= 4)
+        {
+            std::size_t middle = (length >> 3) << 2;
+            a = (static_cast<std::uint64_t>(detail::read32(p)) << 32) | detail::read32(p + middle);
+            b = (static_cast<std::uint64_t>(detail::read32(p + length - 4)) << 32)
+                | detail::read32(p + length - 4 - middle);
+        }
+        else if (length > 0)
+        {
+            a = (static_cast<std::uint64_t>(p[0]) << 16) | (static_cast<std::uint64_t>(p[length >> 1]) << 8)
+                | p[length - 1];
+            b = 0;
+        }
+        else
+        {
+            a = 0;
+            b = 0;
+        }
+    }
+    else
+    {
+        std::size_t remaining = length;
+        if (remaining > 48)
+        {
+            std::uint64_t seed1 = seed;
+            std::uint64_t seed2 = seed;
+            do
+            {
+                seed = detail::multiplyFold(detail::read64(p) ^ P1, detail::read64(p + 8) ^ seed);
+                seed1 = detail::multiplyFold(detail::read64(p + 16) ^ P2, detail::read64(p + 24) ^ seed1);
+                seed2 = detail::multiplyFold(detail::read64(p + 32) ^ P3, detail::read64(p + 40) ^ seed2);
+                p += 48;
+                remaining -= 48;
+            }
+            while (remaining > 48);
+            seed ^= seed1 ^ seed2;
+        }
+        while (remaining > 16)
+        {
+            seed = detail::multiplyFold(detail::read64(p) ^ P1, detail::read64(p + 8) ^ seed);
+            p += 16;
+            remaining -= 16;
+        }
+        a = detail::read64(p + remaining - 16);
+        b = detail::read64(p + remaining - 8);
+    }
+
+    return detail::multiplyFold(P1 ^ length, detail::multiplyFold(a ^ P1, b ^ seed));
+}
+
+
+inline unsigned int hashing::xxhashString(std::string_view s) noexcept
+{
+    constexpr std::uint32_t PRIME1 = 0x9e3779b1u;
+    constexpr std::uint32_t PRIME2 = 0x85ebca77u;
+    constexpr std::uint32_t PRIME3 = 0xc2b2ae3du;
+    constexpr std::uint32_t PRIME4 = 0x27d4eb2fu;
+    constexpr std::uint32_t PRIME5 = 0x165667b1u;
+
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(s.data());
+    const unsigned char* end = p + s.size();
+    std::uint32_t hash;
+
+    if (s.size() >= 16)
+    {
+        std::uint32_t v1 = PRIME1 + PRIME2;
+        std::uint32_t v2 = PRIME2;
+        std::uint32_t v3 = 0;
+        std::uint32_t v4 = 0 - PRIME1;
+        for (; p + 16 <= end; p += 16)
+        {
+            v1 = detail::rotateLeft(v1 + detail::read32(p) * PRIME2, 13) * PRIME1;
+            v2 = detail::rotateLeft(v2 + detail::read32(p + 4) * PRIME2, 13) * PRIME1;
+            v3 = detail::rotateLeft(v3 + detail::read32(p + 8) * PRIME2, 13) * PRIME1;
+            v4 = detail::rotateLeft(v4 + detail::read32(p + 12) * PRIME2, 13) * PRIME1;
+        }
+        hash = detail::rotateLeft(v1, 1) + detail::rotateLeft(v2, 7)
+            + detail::rotateLeft(v3, 12) + detail::rotateLeft(v4, 18);
+    }
+    else
+    {
+        hash = PRIME5;
+    }
+
+    hash += static_cast<std::uint32_t>(s.size());
+
+    for (; p + 4 <= end; p += 4)
+    {
+        hash = detail::rotateLeft(hash + detail::read32(p) * PRIME3, 17) * PRIME4;
+    }
+    for (; p < end; ++p)
+    {
+        hash = detail::rotateLeft(hash + *p * PRIME5, 11) * PRIME1;
+    }
+
+    hash ^= hash >> 15;
+    hash *= PRIME2;
+    hash ^= hash >> 13;
+    hash *= PRIME3;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+
+inline unsigned int hashing::mixInt(const int& i) noexcept
+{
+    std::uint32_t hash = static_cast<std::uint32_t>(i);
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35u;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+
+
+#endif
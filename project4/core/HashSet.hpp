@@ -19,18 +19,163 @@
 // in your data structure.  Instead, you'll need to use a dynamically-
 // allocated array and your own linked list implemenation; the linked list
 // doesn't have to be its own class, though you can do that, if you'd like.
+//
+// The linked lists' nodes come from a node allocator (see NodePool.hpp),
+// which is a NodePool unless otherwise specified, so they're allocated a
+// slab at a time rather than one at a time.
 
 #ifndef HASHSET_HPP
 #define HASHSET_HPP
 
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "NodePool.hpp"
 #include "Set.hpp"
+#include "SetLookupKey.hpp"
 #include <iostream>
 
 
 
-template <typename ElementType>
+// A HashSetStatistics describes how well a HashSet's hash function is
+// spreading its elements out, and what its lookups and resizes have cost.
+struct HashSetStatistics
+{
+    unsigned int size;
+    unsigned int capacity;
+    double loadFactor;
+
+    // chainLengthCounts[n] is the number of indices in the array whose
+    // linked lists have n elements, so chainLengthCounts has
+    // maxChainLength + 1 entries.
+    std::vector<unsigned int> chainLengthCounts;
+    unsigned int maxChainLength;
+
+    // The number of calls to contains() that found what they were looking
+    // for (hits) and that didn't (misses), along with the number of
+    // elements those calls compared against.
+    unsigned long long hits;
+    unsigned long long misses;
+    unsigned long long hitProbes;
+    unsigned long long missProbes;
+
+    // The number of resizes, and the time spent moving elements to the
+    // new arrays (including the time spent by add() on each portion of
+    // an incremental resize).
+    unsigned int resizeCount;
+    double resizeMilliseconds;
+
+    double averageProbesPerHit() const noexcept
+    {
+        return hits == 0 ? 0.0 : static_cast<double>(hitProbes) / hits;
+    }
+
+    double averageProbesPerMiss() const noexcept
+    {
+        return misses == 0 ? 0.0 : static_cast<double>(missProbes) / misses;
+    }
+};
+
+
+
+// A HashSet's LookupCounter decides whether contains() keeps count of its
+// hits, misses and probes for statistics().  Counting means writing to
+// the set's counters on every lookup, which threads reading the same set
+// would all contend for, so by default nothing is counted.
+//
+// NoLookupCounting, the default, counts nothing, so statistics() reports
+// no hits or misses.
+struct NoLookupCounting
+{
+    void countHit(unsigned int) noexcept
+    {
+    }
+
+    void countMiss(unsigned int) noexcept
+    {
+    }
+
+    void report(HashSetStatistics& stats) const noexcept
+    {
+        stats.hits = stats.misses = stats.hitProbes = stats.missProbes = 0;
+    }
+
+    void reset() noexcept
+    {
+    }
+};
+
+
+// CountLookups counts every call to contains().  The counts are atomic
+// only so that concurrent lookups don't race: they're added to with a
+// separate load and store, rather than an atomic increment, which would
+// make every lookup pay for locking the counter's cache line, so lookups
+// made at the same time as others may not all be counted.
+class CountLookups
+{
+public:
+    CountLookups() noexcept = default;
+
+    CountLookups(const CountLookups& c) noexcept
+    {
+        *this = c;
+    }
+
+    CountLookups& operator=(const CountLookups& c) noexcept
+    {
+        hits.store(c.hits.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        misses.store(c.misses.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        hit_probes.store(c.hit_probes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        miss_probes.store(c.miss_probes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return *this;
+    }
+
+    void countHit(unsigned int probes) noexcept
+    {
+        add(hits, 1);
+        add(hit_probes, probes);
+    }
+
+    void countMiss(unsigned int probes) noexcept
+    {
+        add(misses, 1);
+        add(miss_probes, probes);
+    }
+
+    void report(HashSetStatistics& stats) const noexcept
+    {
+        stats.hits = hits.load(std::memory_order_relaxed);
+        stats.misses = misses.load(std::memory_order_relaxed);
+        stats.hitProbes = hit_probes.load(std::memory_order_relaxed);
+        stats.missProbes = miss_probes.load(std::memory_order_relaxed);
+    }
+
+    void reset() noexcept
+    {
+        *this = CountLookups{};
+    }
+
+private:
+    std::atomic<unsigned long long> hits{0};
+    std::atomic<unsigned long long> misses{0};
+    std::atomic<unsigned long long> hit_probes{0};
+    std::atomic<unsigned long long> miss_probes{0};
+
+    static void add(std::atomic<unsigned long long>& counter, unsigned long long amount) noexcept
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+};
+
+
+
+template <typename ElementType, typename HashKeyType = ElementType,
+    template <typename> class NodeAllocator = NodePool, typename LookupCounter = NoLookupCounting>
 class HashSet : public Set<ElementType>
 {
 public:
@@ -38,15 +183,30 @@ public:
     // added to it.
     static constexpr unsigned int DEFAULT_CAPACITY = 10;
 
+    // When the HashSet resizes, its elements aren't all moved to the new
+    // array at once; instead, each subsequent call to add() moves this
+    // many of the old array's linked lists, so no single add() has to
+    // pay for the whole resize.
+    static constexpr unsigned int REHASH_LISTS_PER_ADD = 4;
+
     // A HashFunction is a function that takes a reference to a const
-    // ElementType and returns an unsigned int.
-    using HashFunction = std::function<unsigned int(const ElementType&)>;
+    // HashKeyType and returns an unsigned int.  HashKeyType is normally
+    // just ElementType, but it can be a lightweight view of it instead
+    // (see SetLookupKey.hpp): a HashSet<std::string, std::string_view>
+    // hashes string views, so contains() can look up a std::string_view
+    // without building a std::string first.
+    using HashFunction = std::function<unsigned int(const HashKeyType&)>;
 
 public:
     // Initializes a HashSet to be empty, so that it will use the given
     // hash function whenever it needs to hash an element.
     explicit HashSet(HashFunction hashFunction);
 
+    // Initializes a HashSet to contain the elements in the range from
+    // first to last, as addAll() would add them.
+    template <typename InputIterator>
+    HashSet(InputIterator first, InputIterator last, HashFunction hashFunction);
+
     // Cleans up the HashSet so that it leaks no memory.
     ~HashSet() noexcept override;
 
@@ -76,26 +236,91 @@ public:
     //
     //     capacity * 2 + 1
     //
-    // In the case where the array is resized, this function runs in linear
-    // time (with respect to the number of elements, assuming a good hash
-    // function); otherwise, it runs in constant time (again, assuming a good
-    // hash function).  The amortized running time is also constant.
+    // The capacity changes immediately, but the elements move to the new
+    // array incrementally: the old array is kept until every one of its
+    // linked lists has been relinked into the new one, REHASH_LISTS_PER_ADD
+    // at a time.  (Nodes are relinked, not copied.)  So this function runs
+    // in constant time, not just amortized constant time (assuming a good
+    // hash function).
     void add(const ElementType& element) override;
 
+    // This overload of add() moves the given element into the set, rather
+    // than copying it, if it's not already there.
+    void add(ElementType&& element);
+
+    // emplace() builds an element from the given arguments, then adds it
+    // as add() does.
+    template <typename... Args>
+    void emplace(Args&&... args);
+
+    // addAll() adds every element in the range from first to last.  When
+    // the range's length can be measured without consuming it (i.e., it
+    // has forward iterators), the array is resized once, up front, to fit
+    // all of them, so no add() along the way resizes it again.
+    template <typename InputIterator>
+    void addAll(InputIterator first, InputIterator last);
+
+
+    // reserve() resizes the array, if necessary, so that the set can hold
+    // the given number of elements without resizing again.  Unlike the
+    // resizes triggered by add(), this one happens all at once, since it
+    // usually comes before a burst of adds that would otherwise keep
+    // resizing.  The new capacity is always odd, so that patterns in the
+    // hash values such as even numbers don't favor some indices.
+    void reserve(unsigned int elementCount);
+
+    // shrink_to_fit() resizes the array to the smallest odd capacity
+    // (but not less than DEFAULT_CAPACITY) that holds the current
+    // elements without exceeding the 0.8 ratio of size to capacity, all at
+    // once.  It's meant for a set that's done growing, such as a
+    // dictionary that's been loaded; the next add() will probably start
+    // another resize.
+    void shrink_to_fit();
+
 
     // contains() returns true if the given element is already in the set,
     // false otherwise.  This function runs in constant time (with respect
     // to the number of elements, assuming a good hash function).
     bool contains(const ElementType& element) const override;
 
+    // This overload of contains() looks up a key of the HashKeyType, when
+    // that's a lightweight view of ElementType, without converting it to
+    // an ElementType.
+    template <typename Key, typename = std::enable_if_t<
+        std::is_same_v<Key, HashKeyType> && IsSetLookupKey<ElementType, Key>>>
+    bool contains(const Key& key) const;
+
+
+    // remove() removes the given element from the set, returning true if
+    // it was there and false if it wasn't.  Its node is unlinked from its
+    // linked list and given back to the node allocator, to be reused by a
+    // later add(), so this function runs in constant time (assuming a good
+    // hash function).  The array never shrinks on its own; shrink_to_fit()
+    // does that, after many elements have been removed.
+    bool remove(const ElementType& element);
+
+    // This overload of remove() looks up a key of the HashKeyType, as the
+    // corresponding overload of contains() does.
+    template <typename Key, typename = std::enable_if_t<
+        std::is_same_v<Key, HashKeyType> && IsSetLookupKey<ElementType, Key>>>
+    bool remove(const Key& key);
+
 
     // size() returns the number of elements in the set.
     unsigned int size() const noexcept override;
 
+    // version() returns a number that changes whenever the set's elements
+    // do: when add() adds one, remove() removes one, or the set is
+    // assigned to.  Something that remembers what it found in the set,
+    // such as a SuggestionCache, can use it to tell when that's stale.
+    unsigned long long version() const noexcept;
+
 
     // elementsAtIndex() returns the number of elements that hashed to a
     // particular index in the array.  If the index is out of the boundaries
-    // of the array, this function returns 0.
+    // of the array, this function returns 0.  While a resize is in progress,
+    // elements that haven't moved yet are counted at the index they'll
+    // move to, which takes linear time.
     unsigned int elementsAtIndex(unsigned int index) const;
 
 
@@ -105,20 +330,48 @@ public:
     bool isElementAtIndex(const ElementType& element, unsigned int index) const;
 
 
+    // statistics() returns the HashSet's load factor, the distribution of
+    // the lengths of its linked lists, and what its resizes (and, if its
+    // LookupCounter is CountLookups, its lookups) have cost since it was
+    // created or since resetStatistics() was last called.  This function
+    // takes linear time.
+    HashSetStatistics statistics() const;
+
+    // resetStatistics() zeroes the lookup and resize counts that
+    // statistics() reports.
+    void resetStatistics() noexcept;
+
+
 private:
 
     struct Node
     {
         ElementType value;
-        std::shared_ptr<Node> next;
+        Node* next;
     };
 
     HashFunction hashFunction;
+    NodeAllocator<Node> nodes;
     int capacity;   
-    std::shared_ptr<std::shared_ptr<Node>[]> hash_table; 
+    std::unique_ptr<Node*[]> hash_table; 
     std::shared_ptr<int[]> length_array;
     int element_count;
 
+    // While a resize is in progress, old_hash_table is the array from
+    // before the resize, and its linked lists at indices below
+    // rehash_index have already been moved into hash_table.  Otherwise,
+    // old_hash_table is nullptr.
+    int old_capacity;
+    std::unique_ptr<Node*[]> old_hash_table;
+    int rehash_index;
+
+    unsigned long long version_number = 0;
+
+    // Counts of what lookups and resizes have cost, for statistics().
+    mutable LookupCounter lookup_counter;
+    unsigned int resize_count = 0;
+    std::chrono::steady_clock::duration resize_time{0};
+
     // You'll no doubt want to add member variables and "helper" member
     // functions here.
 
@@ -130,7 +383,7 @@ private:
     //         std::cout << "Index " << i << ": ";
     //         if(hash_table[i] != nullptr) 
     //         {
-    //             std::shared_ptr<Node> curr = hash_table[i];
+    //             Node* curr = hash_table[i];
     //             while(curr != nullptr)
     //             {
     //                 std::cout << curr->value << ", "; 
@@ -156,181 +409,307 @@ private:
     //     std::cout << "capacity: " << capacity << std::endl;
     // }
 
-    int get_hash_value(const ElementType& element) const;
+    int get_hash_value(const HashKeyType& key) const;
+
+    template <typename Key>
+    bool contains_key(const Key& key, unsigned int& probes) const;
+
+    template <typename Key>
+    bool counted_contains(const Key& key) const;
+
+    void swap_statistics(HashSet& s) noexcept;
+
+    template <typename E>
+    void add_element(E&& element);
 
     void reset_arrays(int cap);
-    
-    void copy_table(int cap, int old_cap, std::shared_ptr<std::shared_ptr<Node>[]> hash_t);
-        
+
+    template <typename Key>
+    bool chain_contains(const Node* curr_ll, const Key& key, unsigned int& probes) const;
+
+    template <typename Key>
+    bool remove_key(const Key& key);
+
+    template <typename Key>
+    bool unlink_from_chain(Node*& chain, const Key& key);
+
+    void start_rehash(int cap);
+
+    void rehash_lists(int count);
+
+    void timed_rehash_lists(int count);
+
+    void copy_chain(const Node* curr_node);
+
+    void copy_from(const HashSet& s);
+
+    void destroy_chains(std::unique_ptr<Node*[]>& table, int first, int last);
+
+    void destroy_nodes();
+
+    void rebuild(int cap);
+
+    static int capacity_for(unsigned int elementCount);
+
 };
 
 
 
 namespace impl_
 {
-    template <typename ElementType>
-    unsigned int HashSet__undefinedHashFunction(const ElementType& element)
+    template <typename HashKeyType>
+    unsigned int HashSet__undefinedHashFunction(const HashKeyType& element)
     {
         return 0;
     }
 }
 
 
-template <typename ElementType>
-HashSet<ElementType>::HashSet(HashFunction hashFunction)
-    : hashFunction{hashFunction}, capacity{DEFAULT_CAPACITY}, element_count{0}
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::HashSet(HashFunction hashFunction)
+    : hashFunction{hashFunction}, capacity{DEFAULT_CAPACITY}, element_count{0},
+      old_capacity{0}, old_hash_table{nullptr}, rehash_index{0}
 {
     std::shared_ptr<int[]>dummy{new int[capacity]};
     length_array = dummy;
-    hash_table = std::shared_ptr<std::shared_ptr<Node>[]>{new std::shared_ptr<Node>[capacity]};
+    hash_table = std::unique_ptr<Node*[]>{new Node*[capacity]};
     reset_arrays(capacity);
 }
 
 
-template <typename ElementType>
-HashSet<ElementType>::~HashSet() noexcept
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+template <typename InputIterator>
+HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::HashSet(InputIterator first, InputIterator last, HashFunction hashFunction)
+    : HashSet{hashFunction}
+{
+    addAll(first, last);
+}
+
+
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::~HashSet() noexcept
 {
+    destroy_nodes();
 }
 
 
-template <typename ElementType>
-HashSet<ElementType>::HashSet(const HashSet& s)
-    : hashFunction{impl_::HashSet__undefinedHashFunction<ElementType>}, capacity{s.capacity}, element_count{s.element_count}
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::HashSet(const HashSet& s)
+    : hashFunction{s.hashFunction}, capacity{s.capacity}, element_count{s.element_count},
+      old_capacity{0}, old_hash_table{nullptr}, rehash_index{0}
 {
-    hashFunction = s.hashFunction;
-    copy_table(s.capacity, s.capacity, s.hash_table);
+    try
+    {
+        copy_from(s);
+    }
+    catch (...)
+    {
+        destroy_nodes();
+        throw;
+    }
 }
 
 
-template <typename ElementType>
-HashSet<ElementType>::HashSet(HashSet&& s) noexcept
-    : hashFunction{impl_::HashSet__undefinedHashFunction<ElementType>}, capacity{0}, hash_table{nullptr}, length_array{nullptr}, element_count{0}
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::HashSet(HashSet&& s) noexcept
+    : hashFunction{impl_::HashSet__undefinedHashFunction<HashKeyType>}, capacity{0}, hash_table{nullptr}, length_array{nullptr}, element_count{0},
+      old_capacity{0}, old_hash_table{nullptr}, rehash_index{0}
 {
     std::swap(hashFunction, s.hashFunction);
+    std::swap(nodes, s.nodes);
     std::swap(capacity, s.capacity);
     std::swap(hash_table, s.hash_table);
     std::swap(length_array, s.length_array);
     std::swap(element_count, s.element_count);
-
-
+    std::swap(old_capacity, s.old_capacity);
+    std::swap(old_hash_table, s.old_hash_table);
+    std::swap(rehash_index, s.rehash_index);
+    swap_statistics(s);
+    s.version_number++;
 }
 
 
-template <typename ElementType>
-HashSet<ElementType>& HashSet<ElementType>::operator=(const HashSet& s)
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>& HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::operator=(const HashSet& s)
 {
     if (this != &s)
     {
-        copy_table(s.capacity,s.capacity,s.hash_table);
-        capacity = s.capacity;
-        element_count = s.element_count;
-
+        destroy_nodes();
+        hashFunction = s.hashFunction;
+        copy_from(s);
+        version_number++;
     }
     return *this;
 }
 
 
-template <typename ElementType>
-HashSet<ElementType>& HashSet<ElementType>::operator=(HashSet&& s) noexcept
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>& HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::operator=(HashSet&& s) noexcept
 {
+    std::swap(hashFunction, s.hashFunction);
+    std::swap(nodes, s.nodes);
     std::swap(capacity, s.capacity);
     std::swap(hash_table, s.hash_table);
     std::swap(length_array, s.length_array);
     std::swap(element_count, s.element_count);
+    std::swap(old_capacity, s.old_capacity);
+    std::swap(old_hash_table, s.old_hash_table);
+    std::swap(rehash_index, s.rehash_index);
+    swap_statistics(s);
+    version_number++;
+    s.version_number++;
 
     return *this;
 }
 
 
-template <typename ElementType>
-bool HashSet<ElementType>::isImplemented() const noexcept
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+bool HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::isImplemented() const noexcept
 {
     return true;
 }
 
 
-template <typename ElementType>
-void HashSet<ElementType>::add(const ElementType& element)
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+void HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::add(const ElementType& element)
 {
-    int index = get_hash_value(element);
-    bool found = false;
+    add_element(element);
+}
 
-    
-    std::shared_ptr<Node> curr_ll = hash_table[index];
-    while(curr_ll != nullptr)
+
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+void HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::add(ElementType&& element)
+{
+    add_element(std::move(element));
+}
+
+
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+template <typename... Args>
+void HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::emplace(Args&&... args)
+{
+    add_element(ElementType(std::forward<Args>(args)...));
+}
+
+
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+template <typename InputIterator>
+void HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::addAll(InputIterator first, InputIterator last)
+{
+    using Category = typename std::iterator_traits<InputIterator>::iterator_category;
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>)
     {
-        if(curr_ll->value == element)
-        {
-            found = true;
-            break;
-        }
-        curr_ll = curr_ll->next;
+        reserve(element_count + std::distance(first, last));
     }
-    if(not found)
+
+    for(; first != last; ++first)
     {
-        std::shared_ptr<Node>next_node = hash_table[index];
-        std::shared_ptr<Node> new_node{new Node{element, next_node} };
-        hash_table[index] = new_node;
-        length_array[index]++;
-        element_count++;
+        add_element(*first);
     }
-    
-    if(element_count > capacity*.8)
+}
+
+
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+void HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::reserve(unsigned int elementCount)
+{
+    int cap = capacity_for(elementCount);
+    if(cap > capacity)
     {
-    
-        int old_capacity = capacity;
-        capacity = capacity*2 + 1;
-        copy_table(capacity, old_capacity, hash_table);
+        rebuild(cap);
     }
-
 }
 
 
-template <typename ElementType>
-bool HashSet<ElementType>::contains(const ElementType& element) const
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+void HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::shrink_to_fit()
 {
-    if(element_count == 0)
+    int cap = capacity_for(element_count);
+    if(cap < static_cast<int>(DEFAULT_CAPACITY))
     {
-        return false;
+        cap = DEFAULT_CAPACITY;
     }
-    int index = get_hash_value(element);
-    
-    std::shared_ptr<Node> curr_ll = hash_table[index];
-    
-    while(curr_ll != nullptr)
+    if(cap != capacity || old_hash_table != nullptr)
     {
-
-        if(curr_ll->value == element)
-        {
-            return true;
-        }
-        curr_ll = curr_ll->next;
+        rebuild(cap);
     }
-    return false;
 }
 
 
-template <typename ElementType>
-unsigned int HashSet<ElementType>::size() const noexcept
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+bool HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::contains(const ElementType& element) const
+{
+    return counted_contains(element);
+}
+
+
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+template <typename Key, typename>
+bool HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::contains(const Key& key) const
+{
+    return counted_contains(key);
+}
+
+
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+bool HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::remove(const ElementType& element)
+{
+    return remove_key(element);
+}
+
+
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+template <typename Key, typename>
+bool HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::remove(const Key& key)
+{
+    return remove_key(key);
+}
+
+
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+unsigned int HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::size() const noexcept
 {
     return element_count;
 }
 
 
-template <typename ElementType>
-unsigned int HashSet<ElementType>::elementsAtIndex(unsigned int index) const
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+unsigned long long HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::version() const noexcept
+{
+    return version_number;
+}
+
+
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+unsigned int HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::elementsAtIndex(unsigned int index) const
 {
     if((index >= capacity) || index < 0)
         return 0;
-    return length_array[index];
+
+    unsigned int count = length_array[index];
+    if(old_hash_table != nullptr)
+    {
+        // index is less than capacity, so it fits in the int that
+        // get_hash_value() returns.
+        int hash_value = static_cast<int>(index);
+        for(int i = rehash_index; i < old_capacity; i++)
+        {
+            for(const Node* curr = old_hash_table[i]; curr != nullptr; curr = curr->next)
+            {
+                if(get_hash_value(curr->value) == hash_value)
+                    count++;
+            }
+        }
+    }
+    return count;
 }
 
 
-template <typename ElementType>
-bool HashSet<ElementType>::isElementAtIndex(const ElementType& element, unsigned int index) const
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+bool HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::isElementAtIndex(const ElementType& element, unsigned int index) const
 {
     int ll_index = get_hash_value(element);
-    if (contains(element))
+    unsigned int probes = 0;
+    if (contains_key(element, probes))
     {
         if(ll_index == index)
         {
@@ -340,14 +719,130 @@ bool HashSet<ElementType>::isElementAtIndex(const ElementType& element, unsigned
     return false;
 }
 
-template <typename ElementType>
-int HashSet<ElementType>::get_hash_value(const ElementType& element) const
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+HashSetStatistics HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::statistics() const
+{
+    std::vector<unsigned int> lengths(capacity);
+    for(int i = 0; i < capacity; i++)
+    {
+        lengths[i] = length_array[i];
+    }
+    if(old_hash_table != nullptr)
+    {
+        for(int i = rehash_index; i < old_capacity; i++)
+        {
+            for(const Node* curr = old_hash_table[i]; curr != nullptr; curr = curr->next)
+            {
+                lengths[get_hash_value(curr->value)]++;
+            }
+        }
+    }
+
+    HashSetStatistics stats;
+    stats.size = element_count;
+    stats.capacity = capacity;
+    stats.loadFactor = capacity == 0 ? 0.0 : static_cast<double>(element_count) / capacity;
+    stats.maxChainLength = 0;
+    for(unsigned int length : lengths)
+    {
+        if(length >= stats.chainLengthCounts.size())
+        {
+            stats.chainLengthCounts.resize(length + 1);
+            stats.maxChainLength = length;
+        }
+        stats.chainLengthCounts[length]++;
+    }
+    lookup_counter.report(stats);
+    stats.resizeCount = resize_count;
+    stats.resizeMilliseconds = std::chrono::duration<double, std::milli>(resize_time).count();
+    return stats;
+}
+
+
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+void HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::resetStatistics() noexcept
 {
-    return hashFunction(element)%capacity;
+    lookup_counter.reset();
+    resize_count = 0;
+    resize_time = std::chrono::steady_clock::duration{0};
 }
 
-template <typename ElementType>
-void HashSet<ElementType>::reset_arrays(int cap)
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+int HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::get_hash_value(const HashKeyType& key) const
+{
+    return hashFunction(key)%capacity;
+}
+
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+template <typename Key>
+bool HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::contains_key(const Key& key, unsigned int& probes) const
+{
+    if(element_count == 0)
+    {
+        return false;
+    }
+    if(chain_contains(hash_table[get_hash_value(key)], key, probes))
+    {
+        return true;
+    }
+    if(old_hash_table != nullptr)
+    {
+        int old_index = hashFunction(key)%old_capacity;
+        if(old_index >= rehash_index)
+        {
+            return chain_contains(old_hash_table[old_index], key, probes);
+        }
+    }
+    return false;
+}
+
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+template <typename Key>
+bool HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::counted_contains(const Key& key) const
+{
+    unsigned int probes = 0;
+    if(contains_key(key, probes))
+    {
+        lookup_counter.countHit(probes);
+        return true;
+    }
+    lookup_counter.countMiss(probes);
+    return false;
+}
+
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+void HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::swap_statistics(HashSet& s) noexcept
+{
+    std::swap(lookup_counter, s.lookup_counter);
+    std::swap(resize_count, s.resize_count);
+    std::swap(resize_time, s.resize_time);
+}
+
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+template <typename E>
+void HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::add_element(E&& element)
+{
+    timed_rehash_lists(REHASH_LISTS_PER_ADD);
+    unsigned int probes = 0;
+    if(contains_key(element, probes))
+    {
+        return;
+    }
+
+    int index = get_hash_value(element);
+    hash_table[index] = nodes.create(std::forward<E>(element), hash_table[index]);
+    length_array[index]++;
+    element_count++;
+    version_number++;
+
+    if(element_count > capacity*.8)
+    {
+        start_rehash(capacity*2 + 1);
+    }
+}
+
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+void HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::reset_arrays(int cap)
 {
     for(int i = 0; i < cap; i++)
     {
@@ -356,50 +851,266 @@ void HashSet<ElementType>::reset_arrays(int cap)
     }
 }
 
-template <typename ElementType>
-void HashSet<ElementType>::copy_table(int cap, int old_cap, std::shared_ptr<std::shared_ptr<Node>[]> hash_t)
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+template <typename Key>
+bool HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::chain_contains(const Node* curr_ll, const Key& key, unsigned int& probes) const
 {
-    int index;
-    std::shared_ptr<std::shared_ptr<Node>[]> copy_hash_table{new std::shared_ptr<Node>[capacity]};
-    std::shared_ptr<int[]> copy_length_array{new int[cap]};
-    length_array = copy_length_array;
-    for(int i = 0; i < cap; i++)
+    while(curr_ll != nullptr)
+    {
+        probes++;
+        if(curr_ll->value == key)
+        {
+            return true;
+        }
+        curr_ll = curr_ll->next;
+    }
+    return false;
+}
+
+// While a resize is in progress, the element may still be in the old
+// array's list; only the current array's lists are counted in
+// length_array.
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+template <typename Key>
+bool HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::remove_key(const Key& key)
+{
+    if(element_count == 0)
     {
-        copy_hash_table[i] = nullptr;
+        return false;
     }
-    for(int i = 0; i < cap; i++)
+
+    int index = get_hash_value(key);
+    if(unlink_from_chain(hash_table[index], key))
     {
-        length_array[i] = 0;
+        length_array[index]--;
+        element_count--;
+        version_number++;
+        return true;
     }
-    for(int i = 0; i < old_cap; i++)
+    if(old_hash_table != nullptr)
     {
-        if(hash_t[i] != nullptr)
+        int old_index = hashFunction(key)%old_capacity;
+        if(old_index >= rehash_index && unlink_from_chain(old_hash_table[old_index], key))
         {
-            std::shared_ptr<Node> curr_node = hash_t[i];
-            while(curr_node != nullptr)
-            {
-                index = get_hash_value(curr_node->value);
-                if(length_array[index] == 0)
-                {
-                    std::shared_ptr<Node> new_node = std::shared_ptr<Node>{new Node{curr_node->value, nullptr}};
-                    copy_hash_table[index] = new_node;
-                    //std::cout << new_node->value << std::endl;
-                    curr_node = curr_node->next;
-                }
-                else
-                {
-                    std::shared_ptr<Node> next_node = copy_hash_table[index];
-                    std::shared_ptr<Node> new_node = std::shared_ptr<Node>{new Node{curr_node->value, next_node}};
-                    copy_hash_table[index] = new_node;
-                    curr_node = curr_node->next;
-                }
-                length_array[index]++;
-            }
+            element_count--;
+            version_number++;
+            return true;
         }
     }
-    hash_table = copy_hash_table;
+    return false;
 }
 
+// Unlinks the node holding the given key from a linked list and destroys
+// it, returning false if there isn't one.  curr_link points to whichever
+// pointer leads to the node being examined: the list itself, or the
+// previous node's next.
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+template <typename Key>
+bool HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::unlink_from_chain(Node*& chain, const Key& key)
+{
+    for(Node** curr_link = &chain; *curr_link != nullptr; curr_link = &(*curr_link)->next)
+    {
+        Node* curr_node = *curr_link;
+        if(curr_node->value == key)
+        {
+            *curr_link = curr_node->next;
+            nodes.destroy(curr_node);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Makes a new, empty array of the given capacity the current one, keeping
+// the old array around until rehash_lists() has emptied it.  If a previous
+// resize is still in progress, it's finished first.
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+void HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::start_rehash(int cap)
+{
+    timed_rehash_lists(old_capacity);
+    resize_count++;
+
+    auto start = std::chrono::steady_clock::now();
+
+    old_capacity = capacity;
+    old_hash_table = std::move(hash_table);
+    rehash_index = 0;
+
+    capacity = cap;
+    hash_table = std::unique_ptr<Node*[]>{new Node*[capacity]};
+    length_array = std::shared_ptr<int[]>{new int[capacity]};
+    reset_arrays(capacity);
+
+    resize_time += std::chrono::steady_clock::now() - start;
+}
+
+// Moves up to count of the old array's linked lists into the current
+// array, relinking each node at the front of its new list.
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+void HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::rehash_lists(int count)
+{
+    if(old_hash_table == nullptr)
+    {
+        return;
+    }
+
+    for(int moved = 0; moved < count && rehash_index < old_capacity; moved++, rehash_index++)
+    {
+        Node* curr_node = old_hash_table[rehash_index];
+        old_hash_table[rehash_index] = nullptr;
+        while(curr_node != nullptr)
+        {
+            Node* next_node = curr_node->next;
+            int index = get_hash_value(curr_node->value);
+            curr_node->next = hash_table[index];
+            hash_table[index] = curr_node;
+            length_array[index]++;
+            curr_node = next_node;
+        }
+    }
+
+    if(rehash_index == old_capacity)
+    {
+        old_hash_table = nullptr;
+        old_capacity = 0;
+        rehash_index = 0;
+    }
+}
+
+// Calls rehash_lists(), counting the time toward resize_time when a
+// resize is in progress.  (The clock isn't read otherwise, so add()
+// doesn't pay for it.)
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+void HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::timed_rehash_lists(int count)
+{
+    if(old_hash_table == nullptr)
+    {
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    rehash_lists(count);
+    resize_time += std::chrono::steady_clock::now() - start;
+}
+
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+void HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::copy_chain(const Node* curr_node)
+{
+    while(curr_node != nullptr)
+    {
+        int index = get_hash_value(curr_node->value);
+        hash_table[index] = nodes.create(curr_node->value, hash_table[index]);
+        length_array[index]++;
+        curr_node = curr_node->next;
+    }
+}
+
+// Makes this HashSet a deep copy of s, which is expected to hold no
+// nodes beforehand.  If s is in the middle of a resize,
+// the copy isn't: every element goes straight into the copy's one array.
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+void HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::copy_from(const HashSet& s)
+{
+    capacity = s.capacity;
+    element_count = s.element_count;
+    old_capacity = 0;
+    old_hash_table = nullptr;
+    rehash_index = 0;
+
+    hash_table = std::unique_ptr<Node*[]>{new Node*[capacity]};
+    length_array = std::shared_ptr<int[]>{new int[capacity]};
+    reset_arrays(capacity);
+
+    for(int i = 0; i < s.capacity; i++)
+    {
+        copy_chain(s.hash_table[i]);
+    }
+    if(s.old_hash_table != nullptr)
+    {
+        for(int i = s.rehash_index; i < s.old_capacity; i++)
+        {
+            copy_chain(s.old_hash_table[i]);
+        }
+    }
+}
+
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+void HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::destroy_chains(std::unique_ptr<Node*[]>& table, int first, int last)
+{
+    for(int i = first; i < last; i++)
+    {
+        Node* curr_node = table[i];
+        table[i] = nullptr;
+        while(curr_node != nullptr)
+        {
+            Node* next_node = curr_node->next;
+            nodes.destroy(curr_node);
+            curr_node = next_node;
+        }
+    }
+}
+
+// Destroys every node, leaving the arrays' linked lists dangling, so the
+// caller either discards the arrays or replaces them.  When the allocator
+// can give back all of its nodes' memory at once and the nodes have
+// nothing to clean up, the lists aren't walked at all.
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+void HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::destroy_nodes()
+{
+    if constexpr (!NodeAllocator<Node>::RELEASES_IN_BULK || !std::is_trivially_destructible_v<Node>)
+    {
+        destroy_chains(hash_table, 0, capacity);
+        if(old_hash_table != nullptr)
+        {
+            destroy_chains(old_hash_table, rehash_index, old_capacity);
+        }
+    }
+    nodes.releaseAll();
+}
+
+// Moves every element into a new array of the given capacity right away,
+// finishing any incremental resize that's in progress along the way.
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+void HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::rebuild(int cap)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    rehash_lists(old_capacity);
+
+    std::unique_ptr<Node*[]> previous_table = std::move(hash_table);
+    int previous_capacity = capacity;
+
+    capacity = cap;
+    hash_table = std::unique_ptr<Node*[]>{new Node*[capacity]};
+    length_array = std::shared_ptr<int[]>{new int[capacity]};
+    reset_arrays(capacity);
+
+    for(int i = 0; i < previous_capacity; i++)
+    {
+        Node* curr_node = previous_table[i];
+        while(curr_node != nullptr)
+        {
+            Node* next_node = curr_node->next;
+            int index = get_hash_value(curr_node->value);
+            curr_node->next = hash_table[index];
+            hash_table[index] = curr_node;
+            length_array[index]++;
+            curr_node = next_node;
+        }
+    }
+
+    resize_count++;
+    resize_time += std::chrono::steady_clock::now() - start;
+}
+
+// Returns the smallest odd capacity that can hold the given number of
+// elements without the ratio of size to capacity exceeding 0.8.
+template <typename ElementType, typename HashKeyType, template <typename> class NodeAllocator, typename LookupCounter>
+int HashSet<ElementType, HashKeyType, NodeAllocator, LookupCounter>::capacity_for(unsigned int elementCount)
+{
+    int cap = (static_cast<long long>(elementCount) * 5 + 3) / 4;
+    return cap | 1;
+}
 
 
 
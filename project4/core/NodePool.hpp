@@ -0,0 +1,428 @@
+// NodePool.hpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Node allocators for the linked structures in this project.  A node
+// allocator makes and destroys nodes of one type, handing out raw
+// pointers to them:
+//
+//     NodeType* create(args...)      builds a node from the arguments
+//     void destroy(NodeType* node)   destroys one node
+//     void releaseAll()              gives back the memory of every node
+//                                    at once, without destroying them
+//
+// along with a constant RELEASES_IN_BULK saying whether releaseAll() is
+// worth calling.  releaseAll() doesn't run the nodes' destructors, so it's
+// only a substitute for destroying every node when the node type is
+// trivially destructible; otherwise, the owner destroys each node first.
+//
+// A NodePool carves nodes out of large blocks of memory called "slabs",
+// keeping destroyed nodes on a free list to be reused by later calls to
+// create().  Nodes made one after another sit next to one another in
+// memory, there's one call to operator new per slab rather than per node,
+// and releaseAll() takes time proportional to the number of slabs.
+//
+// A NewDeleteNodeAllocator allocates each node separately with new, the
+// way the linked structures did before there were node allocators.
+//
+// A NodeArena is for nodes whose sizes vary, such as a skip list's, which
+// are followed in memory by an array whose length differs from node to
+// node.  It hands out raw memory of any size and alignment, carved out of
+// slabs one after another, and gives it all back at once in releaseAll();
+// it has no way to give back one node's memory on its own.
+
+#ifndef NODEPOOL_HPP
+#define NODEPOOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+
+
+template <typename NodeType>
+class NodePool
+{
+public:
+    static constexpr bool RELEASES_IN_BULK = true;
+
+    // The first slab has room for FIRST_SLAB_NODES nodes, and each slab
+    // after that is twice as large as the one before, up to
+    // MAX_SLAB_NODES nodes.
+    static constexpr unsigned int FIRST_SLAB_NODES = 16;
+    static constexpr unsigned int MAX_SLAB_NODES = 4096;
+
+public:
+    NodePool() noexcept;
+    ~NodePool() noexcept;
+
+    // A NodePool can't be copied, because the nodes in it belong to
+    // whatever structure it's a part of, but it can be moved, which
+    // moves the ownership of all of its nodes along with it.
+    NodePool(const NodePool& p) = delete;
+    NodePool(NodePool&& p) noexcept;
+    NodePool& operator=(const NodePool& p) = delete;
+    NodePool& operator=(NodePool&& p) noexcept;
+
+
+    template <typename... Args>
+    NodeType* create(Args&&... args);
+
+    void destroy(NodeType* node) noexcept;
+
+    void releaseAll() noexcept;
+
+
+    // slabCount() returns the number of slabs the pool has allocated.
+    unsigned int slabCount() const noexcept;
+
+
+private:
+    // A cell holds one node, or a pointer to the next free cell when
+    // it's on the free list.
+    union Cell
+    {
+        Cell* nextFree;
+        alignas(NodeType) unsigned char node[sizeof(NodeType)];
+    };
+
+    // Each slab is one block of memory: this header, followed by its
+    // cells, starting CELLS_OFFSET bytes in.
+    struct Slab
+    {
+        Slab* next;
+        unsigned int cellCount;
+    };
+
+    static constexpr std::size_t SLAB_ALIGNMENT =
+        alignof(Cell) > alignof(Slab) ? alignof(Cell) : alignof(Slab);
+
+    static constexpr std::size_t CELLS_OFFSET =
+        (sizeof(Slab) + alignof(Cell) - 1) / alignof(Cell) * alignof(Cell);
+
+    Slab* slabs;
+    unsigned int slab_count;
+    Cell* free_list;
+
+    // The cells of the newest slab at and after next_cell have never
+    // been used.
+    Cell* next_cell;
+    Cell* end_cell;
+
+    Cell* allocate_cell();
+
+    void add_slab();
+};
+
+
+
+template <typename NodeType>
+NodePool<NodeType>::NodePool() noexcept
+    : slabs{nullptr}, slab_count{0}, free_list{nullptr}, next_cell{nullptr}, end_cell{nullptr}
+{
+}
+
+
+template <typename NodeType>
+NodePool<NodeType>::~NodePool() noexcept
+{
+    releaseAll();
+}
+
+
+template <typename NodeType>
+NodePool<NodeType>::NodePool(NodePool&& p) noexcept
+    : NodePool{}
+{
+    *this = std::move(p);
+}
+
+
+template <typename NodeType>
+NodePool<NodeType>& NodePool<NodeType>::operator=(NodePool&& p) noexcept
+{
+    std::swap(slabs, p.slabs);
+    std::swap(slab_count, p.slab_count);
+    std::swap(free_list, p.free_list);
+    std::swap(next_cell, p.next_cell);
+    std::swap(end_cell, p.end_cell);
+    return *this;
+}
+
+
+template <typename NodeType>
+template <typename... Args>
+NodeType* NodePool<NodeType>::create(Args&&... args)
+{
+    Cell* cell = allocate_cell();
+
+    try
+    {
+        return new (cell->node) NodeType{std::forward<Args>(args)...};
+    }
+    catch (...)
+    {
+        cell->nextFree = free_list;
+        free_list = cell;
+        throw;
+    }
+}
+
+
+template <typename NodeType>
+void NodePool<NodeType>::destroy(NodeType* node) noexcept
+{
+    node->~NodeType();
+
+    Cell* cell = reinterpret_cast<Cell*>(node);
+    cell->nextFree = free_list;
+    free_list = cell;
+}
+
+
+template <typename NodeType>
+void NodePool<NodeType>::releaseAll() noexcept
+{
+    while (slabs != nullptr)
+    {
+        Slab* next = slabs->next;
+        ::operator delete(slabs, std::align_val_t{SLAB_ALIGNMENT});
+        slabs = next;
+    }
+
+    slab_count = 0;
+    free_list = nullptr;
+    next_cell = nullptr;
+    end_cell = nullptr;
+}
+
+
+template <typename NodeType>
+unsigned int NodePool<NodeType>::slabCount() const noexcept
+{
+    return slab_count;
+}
+
+
+template <typename NodeType>
+typename NodePool<NodeType>::Cell* NodePool<NodeType>::allocate_cell()
+{
+    if (free_list != nullptr)
+    {
+        Cell* cell = free_list;
+        free_list = cell->nextFree;
+        return cell;
+    }
+
+    if (next_cell == end_cell)
+    {
+        add_slab();
+    }
+
+    return next_cell++;
+}
+
+
+template <typename NodeType>
+void NodePool<NodeType>::add_slab()
+{
+    unsigned int cellCount = slabs == nullptr ? FIRST_SLAB_NODES : slabs->cellCount * 2;
+    if (cellCount > MAX_SLAB_NODES)
+    {
+        cellCount = MAX_SLAB_NODES;
+    }
+
+    void* block = ::operator new(CELLS_OFFSET + sizeof(Cell) * cellCount,
+        std::align_val_t{SLAB_ALIGNMENT});
+
+    slabs = new (block) Slab{slabs, cellCount};
+    slab_count++;
+    next_cell = reinterpret_cast<Cell*>(static_cast<unsigned char*>(block) + CELLS_OFFSET);
+    end_cell = next_cell + cellCount;
+}
+
+
+
+template <typename NodeType>
+class NewDeleteNodeAllocator
+{
+public:
+    static constexpr bool RELEASES_IN_BULK = false;
+
+    template <typename... Args>
+    NodeType* create(Args&&... args)
+    {
+        return new NodeType{std::forward<Args>(args)...};
+    }
+
+    void destroy(NodeType* node) noexcept
+    {
+        delete node;
+    }
+
+    void releaseAll() noexcept
+    {
+    }
+};
+
+
+
+class NodeArena
+{
+public:
+    // The first slab is FIRST_SLAB_BYTES bytes, and each slab after that
+    // is twice as large as the one before, up to MAX_SLAB_BYTES (or as
+    // large as a single allocation needs, if that's larger).
+    static constexpr std::size_t FIRST_SLAB_BYTES = 4096;
+    static constexpr std::size_t MAX_SLAB_BYTES = 1 << 20;
+
+public:
+    NodeArena() noexcept;
+    ~NodeArena() noexcept;
+
+    // Like a NodePool, a NodeArena can be moved but not copied.
+    NodeArena(const NodeArena& a) = delete;
+    NodeArena(NodeArena&& a) noexcept;
+    NodeArena& operator=(const NodeArena& a) = delete;
+    NodeArena& operator=(NodeArena&& a) noexcept;
+
+
+    // allocate() returns size bytes of memory aligned to the given
+    // alignment (a power of two), which remain allocated until
+    // releaseAll() is called or the arena is destroyed.
+    void* allocate(std::size_t size, std::size_t alignment);
+
+    void releaseAll() noexcept;
+
+
+    // slabCount() returns the number of slabs the arena has allocated,
+    // and slabBytes() their total size.
+    unsigned int slabCount() const noexcept;
+    std::size_t slabBytes() const noexcept;
+
+
+private:
+    struct Slab
+    {
+        Slab* next;
+        std::size_t size;
+    };
+
+    Slab* slabs;
+    unsigned int slab_count;
+    std::size_t slab_bytes;
+
+    // The bytes of the newest slab from next_byte up to end_byte have
+    // never been handed out.
+    unsigned char* next_byte;
+    unsigned char* end_byte;
+
+    void add_slab(std::size_t minimumSize);
+};
+
+
+
+inline NodeArena::NodeArena() noexcept
+    : slabs{nullptr}, slab_count{0}, slab_bytes{0}, next_byte{nullptr}, end_byte{nullptr}
+{
+}
+
+
+inline NodeArena::~NodeArena() noexcept
+{
+    releaseAll();
+}
+
+
+inline NodeArena::NodeArena(NodeArena&& a) noexcept
+    : NodeArena{}
+{
+    *this = std::move(a);
+}
+
+
+inline NodeArena& NodeArena::operator=(NodeArena&& a) noexcept
+{
+    std::swap(slabs, a.slabs);
+    std::swap(slab_count, a.slab_count);
+    std::swap(slab_bytes, a.slab_bytes);
+    std::swap(next_byte, a.next_byte);
+    std::swap(end_byte, a.end_byte);
+    return *this;
+}
+
+
+inline void* NodeArena::allocate(std::size_t size, std::size_t alignment)
+{
+    auto align = [alignment](unsigned char* p)
+    {
+        std::uintptr_t address = reinterpret_cast<std::uintptr_t>(p);
+        return p + ((alignment - address % alignment) % alignment);
+    };
+
+    unsigned char* start = align(next_byte);
+    if (next_byte == nullptr || static_cast<std::size_t>(end_byte - next_byte) < size + (start - next_byte))
+    {
+        add_slab(size + alignment);
+        start = align(next_byte);
+    }
+
+    next_byte = start + size;
+    return start;
+}
+
+
+inline void NodeArena::releaseAll() noexcept
+{
+    while (slabs != nullptr)
+    {
+        Slab* next = slabs->next;
+        ::operator delete(slabs);
+        slabs = next;
+    }
+
+    slab_count = 0;
+    slab_bytes = 0;
+    next_byte = nullptr;
+    end_byte = nullptr;
+}
+
+
+inline unsigned int NodeArena::slabCount() const noexcept
+{
+    return slab_count;
+}
+
+
+inline std::size_t NodeArena::slabBytes() const noexcept
+{
+    return slab_bytes;
+}
+
+
+inline void NodeArena::add_slab(std::size_t minimumSize)
+{
+    std::size_t size = slabs == nullptr ? FIRST_SLAB_BYTES : slabs->size * 2;
+    if (size > MAX_SLAB_BYTES)
+    {
+        size = MAX_SLAB_BYTES;
+    }
+    if (size < sizeof(Slab) + minimumSize)
+    {
+        size = sizeof(Slab) + minimumSize;
+    }
+
+    void* block = ::operator new(size);
+
+    slabs = new (block) Slab{slabs, size};
+    slab_count++;
+    slab_bytes += size;
+    next_byte = static_cast<unsigned char*>(block) + sizeof(Slab);
+    end_byte = static_cast<unsigned char*>(block) + size;
+}
+
+
+
+#endif
@@ -0,0 +1,39 @@
+// SetCompare.hpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// The ordered Set implementations in this directory (AVLSet and
+// SkipListSet) compare their elements with a three-way comparison: a
+// function object whose operator() takes two elements (or an element and
+// a lookup key; see SetLookupKey.hpp) and returns a negative number, zero,
+// or a positive number, as the first is less than, equal to, or greater
+// than the second.  One comparison then tells a search which way to go,
+// where == followed by < would sometimes take two.
+//
+// SetCompare, the default, uses the elements' own == and < operators.
+// SimdStringCompare (see SimdStrings.hpp) compares strings with SIMD
+// instructions instead.
+
+#ifndef SETCOMPARE_HPP
+#define SETCOMPARE_HPP
+
+
+
+template <typename ElementType>
+struct SetCompare
+{
+    template <typename A, typename B>
+    int operator()(const A& a, const B& b) const
+    {
+        if (a == b)
+        {
+            return 0;
+        }
+        return a < b ? -1 : 1;
+    }
+};
+
+
+
+#endif
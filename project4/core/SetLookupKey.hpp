@@ -0,0 +1,28 @@
+// SetLookupKey.hpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// IsSetLookupKey<ElementType, Key> is true when a Key is a lightweight
+// view of an ElementType: an ElementType converts to a Key implicitly,
+// but not the other way around.  std::string_view is such a view of
+// std::string.  The Set implementations in this directory overload
+// contains() for these keys, comparing them against their elements
+// directly instead of first building an ElementType from them (which,
+// for a std::string, can mean a heap allocation per lookup).
+
+#ifndef SETLOOKUPKEY_HPP
+#define SETLOOKUPKEY_HPP
+
+#include <type_traits>
+
+
+
+template <typename ElementType, typename Key>
+constexpr bool IsSetLookupKey =
+    std::is_convertible_v<const ElementType&, Key>
+    && not std::is_convertible_v<const Key&, ElementType>;
+
+
+
+#endif
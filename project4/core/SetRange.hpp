@@ -0,0 +1,55 @@
+// SetRange.hpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A SetRange is a pair of iterators into one of the ordered Set
+// implementations in this directory (AVLSet and SkipListSet), as returned
+// by their range() member functions.  It has begin() and end(), so it can
+// be used in a range-based for loop:
+//
+//     for (const std::string& word : s.range("CAT", "DOG"))
+//     {
+//         ...
+//     }
+//
+// A SetRange refers to the set's own nodes, so it's valid only until the
+// set is next changed.
+
+#ifndef SETRANGE_HPP
+#define SETRANGE_HPP
+
+
+
+template <typename Iterator>
+class SetRange
+{
+public:
+    SetRange(Iterator first, Iterator last)
+        : first{first}, last{last}
+    {
+    }
+
+    Iterator begin() const
+    {
+        return first;
+    }
+
+    Iterator end() const
+    {
+        return last;
+    }
+
+    bool empty() const
+    {
+        return first == last;
+    }
+
+private:
+    Iterator first;
+    Iterator last;
+};
+
+
+
+#endif
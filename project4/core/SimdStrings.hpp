@@ -0,0 +1,387 @@
+// SimdStrings.hpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Vectorized string hashing and comparison, for sets of words.  Each
+// function works on std::string_view, so it can be given a std::string
+// or a view of one.
+//
+//   * hashString() hashes 16 bytes at a time with SSE2, using the same
+//     32-by-32-bit multiplications as XXH3, and mixes the result with one
+//     128-bit multiplication.  Any word of up to 16 letters is a single
+//     step, and a longer string's last step is its last 16 bytes (which
+//     may overlap the step before).  It can be passed to a HashSet as its
+//     hash function.
+//     hashStringScalar() computes the same hash without SIMD instructions,
+//     which is what hashString() does on platforms without SSE2.
+//
+//   * equal(), commonPrefixLength(), startsWith() and compare() compare
+//     32 bytes at a time with AVX2 (when compiled with it enabled) or 16
+//     at a time with SSE2, finding the first difference from a bit mask.
+//     Strings shorter than 16 bytes are compared eight bytes at a time
+//     with ordinary loads instead.  None of them reads past the end of
+//     either string; the last block is the one ending at the end of the
+//     string, overlapping the block before it.
+//
+// compare() returns a negative number, zero or a positive number, as
+// std::string::compare() does, and SimdStringCompare wraps it so that it
+// can be the comparison of an AVLSet or a SkipListSet.
+
+#ifndef SIMDSTRINGS_HPP
+#define SIMDSTRINGS_HPP
+
+#include <cstdint>
+#include <string_view>
+#include "HashFunctions.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define SIMDSTRINGS_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+#define SIMDSTRINGS_AVX2
+#include <immintrin.h>
+#endif
+
+
+
+namespace simd
+{
+    unsigned int hashString(std::string_view s) noexcept;
+    unsigned int hashStringScalar(std::string_view s) noexcept;
+
+    bool equal(std::string_view a, std::string_view b) noexcept;
+    bool startsWith(std::string_view s, std::string_view prefix) noexcept;
+    std::size_t commonPrefixLength(std::string_view a, std::string_view b) noexcept;
+    int compare(std::string_view a, std::string_view b) noexcept;
+}
+
+
+
+struct SimdStringCompare
+{
+    int operator()(std::string_view a, std::string_view b) const noexcept
+    {
+        return simd::compare(a, b);
+    }
+};
+
+
+
+namespace simd::detail
+{
+    // The starting values of the two 64-bit accumulators, the key that's
+    // mixed into the first block, and what's added to the key for each
+    // block after it (so that swapping two blocks changes the hash).
+    constexpr std::uint64_t START0 = 0x9e3779b185ebca87ull;
+    constexpr std::uint64_t START1 = 0xc2b2ae3d27d4eb4full;
+    constexpr std::uint64_t KEY0 = 0xbe4ba423396cfeb8ull;
+    constexpr std::uint64_t KEY1 = 0x1cad21f72c81017cull;
+    constexpr std::uint64_t STEP0 = 0xdb979083e96dd4deull;
+    constexpr std::uint64_t STEP1 = 0x1f67b3b7a4a44072ull;
+
+
+    inline unsigned int finishHash(std::uint64_t acc0, std::uint64_t acc1, std::size_t length) noexcept
+    {
+        std::uint64_t hash = hashing::detail::multiplyFold(acc0 ^ length ^ 0xa0761d6478bd642full, acc1 ^ 0xe7037ed1a0b428dbull);
+        return static_cast<unsigned int>(hash ^ (hash >> 32));
+    }
+
+
+    // Reads a string of at most 16 bytes into two 64-bit words, with a
+    // few overlapping reads (as wyhash does) rather than a branch for each
+    // length.  Different strings of the same length give different words.
+    inline void readShort(const unsigned char* p, std::size_t length, std::uint64_t& low, std::uint64_t& high) noexcept
+    {
+        if (length >= 4)
+        {
+            std::size_t middle = (length >> 3) << 2;
+            low = (static_cast<std::uint64_t>(hashing::detail::read32(p)) << 32) | hashing::detail::read32(p + middle);
+            high = (static_cast<std::uint64_t>(hashing::detail::read32(p + length - 4)) << 32)
+                | hashing::detail::read32(p + length - 4 - middle);
+        }
+        else if (length > 0)
+        {
+            low = (static_cast<std::uint64_t>(p[0]) << 16) | (static_cast<std::uint64_t>(p[length >> 1]) << 8) | p[length - 1];
+            high = 0;
+        }
+        else
+        {
+            low = 0;
+            high = 0;
+        }
+    }
+
+
+    inline int countTrailingZeros(std::uint64_t x) noexcept
+    {
+#if defined(__GNUC__)
+        return __builtin_ctzll(x);
+#else
+        int count = 0;
+        for (; (x & 1) == 0; x >>= 1)
+        {
+            ++count;
+        }
+        return count;
+#endif
+    }
+
+
+    // Returns the index of the first byte that differs between the given
+    // count (less than 16) of bytes, or count if none do.
+    inline std::size_t shortPrefixLength(const char* a, const char* b, std::size_t count) noexcept
+    {
+        std::size_t i = 0;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        for (; i + 8 <= count; i += 8)
+        {
+            std::uint64_t difference = hashing::detail::read64(reinterpret_cast<const unsigned char*>(a + i))
+                ^ hashing::detail::read64(reinterpret_cast<const unsigned char*>(b + i));
+            if (difference != 0)
+            {
+                return i + countTrailingZeros(difference) / 8;
+            }
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            if (a[i] != b[i])
+            {
+                return i;
+            }
+        }
+        return count;
+    }
+}
+
+
+
+inline unsigned int simd::hashString(std::string_view s) noexcept
+{
+#ifdef SIMDSTRINGS_SSE2
+    __m128i acc = _mm_set_epi64x(detail::START1, detail::START0);
+    __m128i key = _mm_set_epi64x(detail::KEY1, detail::KEY0);
+    const __m128i step = _mm_set_epi64x(detail::STEP1, detail::STEP0);
+
+    auto mix = [&](__m128i data)
+    {
+        // Each 64-bit lane adds the other lane's data and the product of
+        // the two halves of its own data mixed with the key.
+        __m128i keyed = _mm_xor_si128(data, key);
+        __m128i product = _mm_mul_epu32(keyed, _mm_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1)));
+        __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+        acc = _mm_add_epi64(acc, _mm_add_epi64(swapped, product));
+        key = _mm_add_epi64(key, step);
+    };
+
+    const char* p = s.data();
+    std::size_t length = s.size();
+    if (length <= 16)
+    {
+        std::uint64_t low;
+        std::uint64_t high;
+        detail::readShort(reinterpret_cast<const unsigned char*>(p), length, low, high);
+        mix(_mm_set_epi64x(high, low));
+    }
+    else
+    {
+        for (std::size_t i = 0; i + 16 < length; i += 16)
+        {
+            mix(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)));
+        }
+        mix(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + length - 16)));
+    }
+
+    std::uint64_t acc0 = static_cast<std::uint64_t>(_mm_cvtsi128_si64(acc));
+    std::uint64_t acc1 = static_cast<std::uint64_t>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(acc, acc)));
+    return detail::finishHash(acc0, acc1, s.size());
+#else
+    return hashStringScalar(s);
+#endif
+}
+
+
+inline unsigned int simd::hashStringScalar(std::string_view s) noexcept
+{
+    std::uint64_t acc0 = detail::START0;
+    std::uint64_t acc1 = detail::START1;
+    std::uint64_t key0 = detail::KEY0;
+    std::uint64_t key1 = detail::KEY1;
+
+    auto mix = [&](std::uint64_t data0, std::uint64_t data1)
+    {
+        std::uint64_t keyed0 = data0 ^ key0;
+        std::uint64_t keyed1 = data1 ^ key1;
+        acc0 += data1 + (keyed0 & 0xffffffffu) * (keyed0 >> 32);
+        acc1 += data0 + (keyed1 & 0xffffffffu) * (keyed1 >> 32);
+        key0 += detail::STEP0;
+        key1 += detail::STEP1;
+    };
+
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(s.data());
+    std::size_t length = s.size();
+    if (length <= 16)
+    {
+        std::uint64_t low;
+        std::uint64_t high;
+        detail::readShort(p, length, low, high);
+        mix(low, high);
+    }
+    else
+    {
+        for (std::size_t i = 0; i + 16 < length; i += 16)
+        {
+            mix(hashing::detail::read64(p + i), hashing::detail::read64(p + i + 8));
+        }
+        mix(hashing::detail::read64(p + length - 16), hashing::detail::read64(p + length - 8));
+    }
+
+    return detail::finishHash(acc0, acc1, s.size());
+}
+
+
+inline bool simd::equal(std::string_view a, std::string_view b) noexcept
+{
+    std::size_t n = a.size();
+    if (n != b.size())
+    {
+        return false;
+    }
+
+    const char* x = a.data();
+    const char* y = b.data();
+
+#ifdef SIMDSTRINGS_SSE2
+    if (n >= 16)
+    {
+        std::size_t i = 0;
+#ifdef SIMDSTRINGS_AVX2
+        for (; i + 32 <= n; i += 32)
+        {
+            __m256i same = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i)),
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i)));
+            if (static_cast<unsigned int>(_mm256_movemask_epi8(same)) != 0xffffffffu)
+            {
+                return false;
+            }
+        }
+#endif
+        for (; i + 16 <= n; i += 16)
+        {
+            __m128i same = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i)),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(y + i)));
+            if (_mm_movemask_epi8(same) != 0xffff)
+            {
+                return false;
+            }
+        }
+        __m128i same = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(x + n - 16)),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(y + n - 16)));
+        return _mm_movemask_epi8(same) == 0xffff;
+    }
+#endif
+
+    const unsigned char* ux = reinterpret_cast<const unsigned char*>(x);
+    const unsigned char* uy = reinterpret_cast<const unsigned char*>(y);
+    if (n >= 8)
+    {
+        // The first eight bytes and the last eight, overlapping if there
+        // are fewer than 16.
+        std::size_t i = 0;
+        for (; i + 8 < n; i += 8)
+        {
+            if (hashing::detail::read64(ux + i) != hashing::detail::read64(uy + i))
+            {
+                return false;
+            }
+        }
+        return hashing::detail::read64(ux + n - 8) == hashing::detail::read64(uy + n - 8);
+    }
+    if (n >= 4)
+    {
+        return hashing::detail::read32(ux) == hashing::detail::read32(uy) && hashing::detail::read32(ux + n - 4) == hashing::detail::read32(uy + n - 4);
+    }
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (x[i] != y[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+inline bool simd::startsWith(std::string_view s, std::string_view prefix) noexcept
+{
+    return s.size() >= prefix.size() && equal(s.substr(0, prefix.size()), prefix);
+}
+
+
+inline std::size_t simd::commonPrefixLength(std::string_view a, std::string_view b) noexcept
+{
+    std::size_t n = a.size() < b.size() ? a.size() : b.size();
+    const char* x = a.data();
+    const char* y = b.data();
+
+#ifdef SIMDSTRINGS_SSE2
+    if (n >= 16)
+    {
+        std::size_t i = 0;
+#ifdef SIMDSTRINGS_AVX2
+        for (; i + 32 <= n; i += 32)
+        {
+            __m256i same = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i)),
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i)));
+            std::uint32_t different = ~static_cast<std::uint32_t>(_mm256_movemask_epi8(same));
+            if (different != 0)
+            {
+                return i + detail::countTrailingZeros(different);
+            }
+        }
+#endif
+        for (; i + 16 <= n; i += 16)
+        {
+            __m128i same = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i)),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(y + i)));
+            std::uint32_t different = ~static_cast<std::uint32_t>(_mm_movemask_epi8(same)) & 0xffffu;
+            if (different != 0)
+            {
+                return i + detail::countTrailingZeros(different);
+            }
+        }
+        if (i == n)
+        {
+            return n;
+        }
+
+        // Everything before i is the same, so the first difference in the
+        // last 16 bytes is the first difference overall.
+        __m128i same = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(x + n - 16)),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(y + n - 16)));
+        std::uint32_t different = ~static_cast<std::uint32_t>(_mm_movemask_epi8(same)) & 0xffffu;
+        return different == 0 ? n : n - 16 + detail::countTrailingZeros(different);
+    }
+#endif
+
+    return detail::shortPrefixLength(x, y, n);
+}
+
+
+inline int simd::compare(std::string_view a, std::string_view b) noexcept
+{
+    std::size_t common = commonPrefixLength(a, b);
+    if (common < a.size() && common < b.size())
+    {
+        return static_cast<int>(static_cast<unsigned char>(a[common]))
+            - static_cast<int>(static_cast<unsigned char>(b[common]));
+    }
+    return a.size() < b.size() ? -1 : (a.size() > b.size() ? 1 : 0);
+}
+
+
+
+#endif
@@ -12,146 +12,45 @@
 // nodes, with pointers connecting them.  You can, however, use other parts of
 // the C++ Standard Library -- including <random>, notably.
 //
-// Each node should contain only two pointers: one to the node that follows it
-// on the same level and another to the equivalent node on the level below it.
-// Additional pointers use more memory but don't enable any techniques not
-// enabled by the other two.
+// Rather than a separate linked list of nodes for each level, with a copy
+// of a key on every level it occupies, a SkipListSet stores each element
+// once, in a node followed in memory by its "tower": one pointer to the
+// next node for each level the node occupies.  A search moves right along
+// a level by following the current node's pointer for that level, and
+// down by reading the pointer below it in the same tower, so it touches
+// one node per step rather than one per step per level.  The nodes are
+// carved out of large slabs of memory by a NodeArena (see NodePool.hpp).
 //
-// A couple of utilities are included here: SkipListKind and SkipListKey.
-// You can feel free to use these as-is and probably will not need to
-// modify them, though you can make changes to them, if you'd like.
+// A removed element's node is unlinked from every level it occupies, and
+// its memory is kept on a free list for its height, to be reused by the
+// next node with a tower of the same height.
+//
+// The bottom level links every element in ascending order, so an Iterator
+// is just a pointer to a node, and moving to the next element follows the
+// node's bottom pointer.
+//
+// There are no special keys for -INF and +INF: the front of every level
+// is the skip list's own array of pointers, and the end of every level is
+// nullptr.
 
 #ifndef SKIPLISTSET_HPP
 #define SKIPLISTSET_HPP
 
+#include <cstddef>
+#include <iterator>
 #include <memory>
-#include <optional>
+#include <new>
 #include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "NodePool.hpp"
 #include "Set.hpp"
-#include <iostream>
-
-
-
-
-// SkipListKind indicates a kind of key: a normal one, the special key
-// -INF, or the special key +INF.  It's necessary for us to implement
-// the notion of -INF and +INF separately, since we're building a class
-// template and not all types of keys would have a reasonable notion of
-// -INF and +INF.
-
-enum class SkipListKind
-{
-    Normal,
-    NegInf,
-    PosInf
-};
-
-
-
-
-// A SkipListKey represents a single key in a skip list.  It is possible
-// to compare these keys using < or == operators (which are overloaded here)
-// and those comparisons respect the notion of whether each key is normal,
-// -INF, or +INF.
-
-template <typename ElementType>
-class SkipListKey
-{
-public:
-    static SkipListKey normal(const ElementType& element);
-    static SkipListKey negInf();
-    static SkipListKey posInf();
-
-    bool operator==(const SkipListKey& other) const;
-    bool operator==(const ElementType& other) const;
-
-    bool operator<(const SkipListKey& other) const;
-    bool operator<(const ElementType& other) const;
-
-    //remove this
-    // void print_key()
-    // {
-    //     std::cout << *element << std::endl;
-    // }
-
-private:
-    SkipListKey(SkipListKind kind, std::optional<ElementType> element);
-
-private:
-    SkipListKind kind;
-    std::optional<ElementType> element;
-
-};
-
-
-template <typename ElementType>
-SkipListKey<ElementType> SkipListKey<ElementType>::normal(const ElementType& element)
-{
-    return SkipListKey{SkipListKind::Normal, std::make_optional(element)};
-}
-
-
-template <typename ElementType>
-SkipListKey<ElementType> SkipListKey<ElementType>::negInf()
-{
-    return SkipListKey{SkipListKind::NegInf, std::nullopt};
-}
-
-
-template <typename ElementType>
-SkipListKey<ElementType> SkipListKey<ElementType>::posInf()
-{
-    return SkipListKey{SkipListKind::PosInf, std::nullopt};
-}
-
-
-template <typename ElementType>
-SkipListKey<ElementType>::SkipListKey(SkipListKind kind, std::optional<ElementType> element)
-    : kind{kind}, element{element}
-{
-}
-
-
-template <typename ElementType>
-bool SkipListKey<ElementType>::operator==(const SkipListKey& other) const
-{
-    return kind == other.kind
-        && (kind != SkipListKind::Normal || *element == *other.element);
-}
-
-
-template <typename ElementType>
-bool SkipListKey<ElementType>::operator==(const ElementType& other) const
-{
-    return kind == SkipListKind::Normal && *element == other;
-}
-
-
-template <typename ElementType>
-bool SkipListKey<ElementType>::operator<(const SkipListKey& other) const
-{
-    switch (kind)
-    {
-    case SkipListKind::NegInf:
-        return other.kind != SkipListKind::NegInf;
-
-    case SkipListKind::PosInf:
-        return false;
-
-    default: // SkipListKind::Normal
-        return other.kind == SkipListKind::PosInf
-            || (other.kind == SkipListKind::Normal && *element < *other.element);
-    }
-}
+#include "SetCompare.hpp"
+#include "SetLookupKey.hpp"
+#include "SetRange.hpp"
 
 
-template <typename ElementType>
-bool SkipListKey<ElementType>::operator<(const ElementType& other) const
-{
-    return kind == SkipListKind::NegInf
-        || (kind == SkipListKind::Normal && *element < other);
-}
-
 
 
 // The SkipListLevelTester class represents the ability to decide whether
@@ -220,15 +119,31 @@ std::unique_ptr<SkipListLevelTester<ElementType>> RandomSkipListLevelTester<Elem
 
 
 
-template <typename ElementType>
+template <typename ElementType, typename Compare = SetCompare<ElementType>>
 class SkipListSet : public Set<ElementType>
 {
+public:
+    // The most levels a SkipListSet can have.  A key stops "flipping
+    // coins" once it occupies every one of them, which, with a fair coin,
+    // happens to about one key in four billion.
+    static constexpr unsigned int MAX_LEVELS = 32;
+
+    // An Iterator visits the elements of the set in ascending order.  It
+    // can't change them, since that could change where they belong in the
+    // skip list.  Iterators are valid until the set is next changed.
+    class Iterator;
+
 public:
     // Initializes an SkipListSet to be empty, with or without a
     // "level tester" object that will decide, whenever a "coin flip"
     // is needed, whether a key should occupy the next level above.
+    // Keys are ordered by the given three-way comparison (see
+    // SetCompare.hpp), which, by default, uses their own == and <
+    // operators.
     SkipListSet();
-    explicit SkipListSet(std::unique_ptr<SkipListLevelTester<ElementType>> levelTester);
+    explicit SkipListSet(
+        std::unique_ptr<SkipListLevelTester<ElementType>> levelTester,
+        Compare compare = Compare{});
 
     // Cleans up the SkipListSet so that it leaks no memory.
     ~SkipListSet() noexcept override;
@@ -247,6 +162,22 @@ public:
     SkipListSet& operator=(SkipListSet&& s) noexcept;
 
 
+    // fromSorted() returns a SkipListSet containing the elements in the
+    // range from first to last, which should be in ascending order.  Rather
+    // than searching for each element's place, it builds every level from
+    // left to right, appending each element to the end of each level its
+    // tower reaches, with the heights of the towers decided by the given
+    // level tester, in O(n) time.  Elements equal to the one before them
+    // are skipped, and any that are out of order are added afterward, as
+    // add() would add them.
+    template <typename InputIterator>
+    static SkipListSet fromSorted(
+        InputIterator first, InputIterator last,
+        std::unique_ptr<SkipListLevelTester<ElementType>> levelTester =
+            std::make_unique<RandomSkipListLevelTester<ElementType>>(),
+        Compare compare = Compare{});
+
+
     // isImplemented() should be modified to return true if you've
     // decided to implement a SkipListSet, false otherwise.
     bool isImplemented() const noexcept override;
@@ -258,6 +189,15 @@ public:
     // O(log n)) with very high probability.
     void add(const ElementType& element) override;
 
+    // This overload of add() moves the given element into the set, rather
+    // than copying it, if it's not already there.
+    void add(ElementType&& element);
+
+    // emplace() builds an element from the given arguments, then adds it
+    // as add() does.
+    template <typename... Args>
+    void emplace(Args&&... args);
+
 
     // contains() returns true if the given element is already in the set,
     // false otherwise.  This function runs in an expected time of O(log n)
@@ -265,10 +205,64 @@ public:
     // with very high probability.
     bool contains(const ElementType& element) const override;
 
+    // This overload of contains() compares a lightweight view of an
+    // element (see SetLookupKey.hpp) against the skip list's keys
+    // directly, without converting it to an ElementType.
+    template <typename Key, typename = std::enable_if_t<IsSetLookupKey<ElementType, Key>>>
+    bool contains(const Key& key) const;
+
+
+    // remove() removes the given element from the set, returning true if
+    // it was there and false if it wasn't.  One search from the top level
+    // down finds the node before it on every level, so this function runs
+    // in an expected time of O(log n).  Levels left empty are removed.
+    bool remove(const ElementType& element);
+
+    template <typename Key, typename = std::enable_if_t<IsSetLookupKey<ElementType, Key>>>
+    bool remove(const Key& key);
+
 
     // size() returns the number of elements in the set.
     unsigned int size() const noexcept override;
 
+    // version() returns a number that changes whenever the set's elements
+    // do: when add() adds one, remove() removes one, or the set is
+    // assigned to.  Something that remembers what it found in the set,
+    // such as a SuggestionCache, can use it to tell when that's stale.
+    unsigned long long version() const noexcept;
+
+
+    // begin() returns an Iterator to the smallest element in the set, and
+    // end() returns the Iterator that follows the largest one.
+    Iterator begin() const noexcept;
+    Iterator end() const noexcept;
+
+
+    // lowerBound() returns an Iterator to the smallest element that is not
+    // less than the given one, and upperBound() an Iterator to the smallest
+    // element that is greater than it, or end() if there isn't one.  Both
+    // run in an expected time of O(log n), and both have overloads that
+    // take a lightweight view of an element (see SetLookupKey.hpp).
+    Iterator lowerBound(const ElementType& element) const;
+
+    template <typename Key, typename = std::enable_if_t<IsSetLookupKey<ElementType, Key>>>
+    Iterator lowerBound(const Key& key) const;
+
+    Iterator upperBound(const ElementType& element) const;
+
+    template <typename Key, typename = std::enable_if_t<IsSetLookupKey<ElementType, Key>>>
+    Iterator upperBound(const Key& key) const;
+
+
+    // range() returns the elements that are at least lo but less than hi,
+    // in ascending order (or none, if hi isn't greater than lo).  Finding
+    // the first of them takes an expected time of O(log n), and visiting
+    // all k of them takes O(k) more.
+    SetRange<Iterator> range(const ElementType& lo, const ElementType& hi) const;
+
+    template <typename Key, typename = std::enable_if_t<IsSetLookupKey<ElementType, Key>>>
+    SetRange<Iterator> range(const Key& lo, const Key& hi) const;
+
 
     // levelCount() returns the number of levels in the skip list.
     unsigned int levelCount() const noexcept;
@@ -290,426 +284,691 @@ public:
 
 
 private:
-    std::unique_ptr<SkipListLevelTester<ElementType>> levelTester;
-
+    // A Node's tower of pointers, one for each of its height levels,
+    // starts TOWER_OFFSET bytes after the Node itself.
     struct Node
     {
-        SkipListKey<ElementType> key;
-        std::shared_ptr<Node> next;
-        std::shared_ptr<Node> below;
+        ElementType element;
+        unsigned int height;
     };
 
-    struct LinkedList
+    static constexpr std::size_t TOWER_OFFSET =
+        (sizeof(Node) + alignof(Node*) - 1) / alignof(Node*) * alignof(Node*);
+
+    static constexpr std::size_t NODE_ALIGNMENT =
+        alignof(Node) > alignof(Node*) ? alignof(Node) : alignof(Node*);
+
+    std::unique_ptr<SkipListLevelTester<ElementType>> levelTester;
+    Compare compare;
+    NodeArena arena;
+
+    // head[level] is the first node on each level (or nullptr, if there
+    // are none), which makes head the tower of -INF.
+    Node* head[MAX_LEVELS];
+    unsigned int level_sizes[MAX_LEVELS];
+    unsigned int level_count;
+    unsigned int count;
+    unsigned long long version_number = 0;
+
+    // free_nodes[height - 1] lists the removed nodes of each height, whose
+    // elements have been destroyed, linked through their towers' bottoms.
+    Node* free_nodes[MAX_LEVELS];
+
+    static Node** tower(Node* node) noexcept;
+    static Node* const* tower(const Node* node) noexcept;
+
+    template <typename E>
+    Node* create_node(E&& element, unsigned int height);
+
+    void destroy_all() noexcept;
+
+    void copy_nodes(const SkipListSet& s);
+
+    void append_node(Node* node, Node** (&tails)[MAX_LEVELS]) noexcept;
+
+    unsigned int random_height(const ElementType& element);
+
+    template <typename E>
+    void add_element(E&& element);
+
+    template <typename Key>
+    const Node* find_node(const Key& key) const;
+
+    template <typename Key>
+    bool remove_element(const Key& key);
+
+    template <bool IncludeEqual, typename Key>
+    const Node* find_bound(const Key& key) const;
+};
+
+
+
+template <typename ElementType, typename Compare>
+class SkipListSet<ElementType, Compare>::Iterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = ElementType;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const ElementType*;
+    using reference = const ElementType&;
+
+    Iterator() noexcept
+        : node{nullptr}
     {
-        unsigned int length;
-        std::shared_ptr<Node> front;
-        std::shared_ptr<Node> tail;
-    };
+    }
 
-private:
-    std::shared_ptr<std::shared_ptr<LinkedList>[]> front_array;
-    int tot_levels; //size
-    int capacity;
-
-    // void print_everything()
-    // {
-        
-    //     for(int i = 0; i < tot_levels; i++)
-    //     {
-    //         std::shared_ptr<Node> ptr = front_array[i]->front;
-    //         std::cout << "level: " << i << "\n" << std::endl;
-    //         while(ptr != nullptr)
-    //         {
-    //             if(ptr->key == SkipListKey<ElementType>::negInf())
-    //             {
-    //                 std::cout << "negInf" << std::endl;
-    //             }
-    //             else if(ptr->key == SkipListKey<ElementType>::posInf())
-    //             {
-    //                 std::cout << "posInf" << std::endl;
-    //             }
-    //             else{
-    //                 ptr->key.print_key();
-    //             }
-    //             ptr = ptr->next;
-            
-    //         }
-    //         //test if they are posInf and negInf 
-
-    //         //std::cout << "front: " << std::endl;
-    //         //front_array[i]->front->key.print_key();
-    //         //std::cout << "tail: " << std::endl; 
-    //         //front_array[i]->tail->key.print_key();
-    //         std::cout << "\nlength: " << front_array[i]->length << std::endl;
-    //         std::cout << "----------------------------\n";
-    //     }
-    //     std::cout << "capacity: " << capacity << std::endl;
-    //     std::cout << "tot_levels: " << tot_levels << std::endl;
-    //     std::cout << "----------------------------\n";
-
-    // }
-
-    void assign_below_ptr(std::shared_ptr<Node> current, int current_level);
-
-    void insert(SkipListKey<ElementType> key, int current_level);
-
-    void copy_front_array(std::shared_ptr<std::shared_ptr<LinkedList>[]> front);
-
-    void insert_into_skiplist(std::shared_ptr<Node> current, const ElementType& element, int current_level);
-
-//inline functions
-//definitions are within class due to errors when definitions are written outside
-
-    std::shared_ptr<LinkedList> init_ll(int level)
-    {
-        std::shared_ptr<LinkedList> ll{new LinkedList};
-        ll->length = 0;
-        ll->front = std::make_shared<Node>(Node{SkipListKey<ElementType>::negInf(), nullptr, nullptr});
-        ll->front->next = std::make_shared<Node>(Node{SkipListKey<ElementType>::posInf(), nullptr, nullptr});
-        ll->tail = ll->front->next;
-        if(level > 0)
-        {
-            ll->front->below = front_array[level-1]->front;
-            ll->tail->below = front_array[level-1]->tail;
-        }
-        return ll; 
+    reference operator*() const
+    {
+        return node->element;
     }
 
-    std::shared_ptr<Node> find_insertion_point(std::shared_ptr<Node> front, SkipListKey<ElementType> key)
+    pointer operator->() const
     {
-        while(true)
-        {
-            if(not (front->next->key < key))
-            {
-                return front;
-            }
-            else
-            {
-                front = front->next;
-            }
-        }
-        return front;
+        return &node->element;
     }
 
-    std::shared_ptr<Node> insert_between(std::shared_ptr<Node> reader, std::shared_ptr<Node>& marker, std::shared_ptr<Node>& below_ptr) 
-    {                                                                                    // below_ptr points to new node for reference in upper levels
-        std::shared_ptr<Node> end = marker->next;
-        std::shared_ptr<Node> new_node{new Node{reader->key, end, below_ptr}};
-        marker->next = new_node;
-        below_ptr = new_node;
-        return below_ptr;
+    Iterator& operator++() noexcept
+    {
+        node = tower(node)[0];
+        return *this;
     }
 
-    // You'll no doubt want to add member variables and "helper" member
-    // functions here
-};
+    Iterator operator++(int) noexcept
+    {
+        Iterator old = *this;
+        node = tower(node)[0];
+        return old;
+    }
 
+    bool operator==(const Iterator& other) const noexcept
+    {
+        return node == other.node;
+    }
 
+    bool operator!=(const Iterator& other) const noexcept
+    {
+        return node != other.node;
+    }
 
+private:
+    friend class SkipListSet;
 
+    explicit Iterator(const Node* node) noexcept
+        : node{node}
+    {
+    }
 
-template <typename ElementType>
-SkipListSet<ElementType>::SkipListSet()
-    : SkipListSet{std::make_unique<RandomSkipListLevelTester<ElementType>>()} //cheange back to SkipListSet
+    const Node* node;
+};
+
+
+
+template <typename ElementType, typename Compare>
+SkipListSet<ElementType, Compare>::SkipListSet()
+    : SkipListSet{std::make_unique<RandomSkipListLevelTester<ElementType>>()}
 {
-    tot_levels = 0;
-    capacity = 10; //initial capacity of array
-    std::shared_ptr<std::shared_ptr<LinkedList>[]> copy_array{new std::shared_ptr<LinkedList>[capacity]};
-    front_array = copy_array;
-    //front_array[0] = init_ll(0);
 }
 
 
-template <typename ElementType>
-SkipListSet<ElementType>::SkipListSet(std::unique_ptr<SkipListLevelTester<ElementType>> levelTester)
-    : levelTester{std::move(levelTester)}
+template <typename ElementType, typename Compare>
+SkipListSet<ElementType, Compare>::SkipListSet(
+    std::unique_ptr<SkipListLevelTester<ElementType>> levelTester,
+    Compare compare)
+    : levelTester{std::move(levelTester)}, compare{std::move(compare)},
+      head{}, level_sizes{}, level_count{0}, count{0}, free_nodes{}
 {
-    tot_levels = 0;
-    capacity = 10; //initial capacity of array
-    std::shared_ptr<std::shared_ptr<LinkedList>[]> copy_array{new std::shared_ptr<LinkedList>[capacity]};
-    front_array = copy_array;
-    //front_array[0] = init_ll(0);
 }
 
 
-template <typename ElementType>
-SkipListSet<ElementType>::~SkipListSet() noexcept
+template <typename ElementType, typename Compare>
+SkipListSet<ElementType, Compare>::~SkipListSet() noexcept
 {
+    destroy_all();
 }
 
 
-template <typename ElementType>
-SkipListSet<ElementType>::SkipListSet(const SkipListSet& s)
-    : tot_levels{s.tot_levels}, capacity{s.capacity}
+template <typename ElementType, typename Compare>
+SkipListSet<ElementType, Compare>::SkipListSet(const SkipListSet& s)
+    : levelTester{s.levelTester == nullptr ? nullptr : s.levelTester->clone()}, compare{s.compare},
+      head{}, level_sizes{}, level_count{0}, count{0}, free_nodes{}
 {
-    copy_front_array(s.front_array);
+    copy_nodes(s);
 }
 
 
-template <typename ElementType>
-SkipListSet<ElementType>::SkipListSet(SkipListSet&& s) noexcept
-    : front_array{nullptr}, tot_levels{0}, capacity{0}
+template <typename ElementType, typename Compare>
+SkipListSet<ElementType, Compare>::SkipListSet(SkipListSet&& s) noexcept
+    : compare{s.compare}, head{}, level_sizes{}, level_count{0}, count{0}, free_nodes{}
 {
-    std::swap(front_array, s.front_array);
-    std::swap(tot_levels, s.tot_levels);
-    std::swap(capacity, s.capacity);
+    *this = std::move(s);
 }
 
 
-template <typename ElementType>
-SkipListSet<ElementType>& SkipListSet<ElementType>::operator=(const SkipListSet& s)
+template <typename ElementType, typename Compare>
+SkipListSet<ElementType, Compare>& SkipListSet<ElementType, Compare>::operator=(const SkipListSet& s)
 {
     if (this != &s)
     {
-        tot_levels = s.tot_levels;
-        capacity = s.capacity;
-        copy_front_array(s.front_array);
+        SkipListSet copy{s};
+        *this = std::move(copy);
     }
     return *this;
 }
 
 
-template <typename ElementType>
-SkipListSet<ElementType>& SkipListSet<ElementType>::operator=(SkipListSet&& s) noexcept
+template <typename ElementType, typename Compare>
+SkipListSet<ElementType, Compare>& SkipListSet<ElementType, Compare>::operator=(SkipListSet&& s) noexcept
 {
-    std::swap(front_array, s.front_array);
-    std::swap(tot_levels, s.tot_levels);
-    std::swap(capacity, s.capacity);
+    std::swap(levelTester, s.levelTester);
+    std::swap(compare, s.compare);
+    std::swap(arena, s.arena);
+    std::swap(head, s.head);
+    std::swap(level_sizes, s.level_sizes);
+    std::swap(level_count, s.level_count);
+    std::swap(count, s.count);
+    std::swap(free_nodes, s.free_nodes);
+    version_number++;
+    s.version_number++;
     return *this;
 }
 
 
-template <typename ElementType>
-bool SkipListSet<ElementType>::isImplemented() const noexcept
+template <typename ElementType, typename Compare>
+template <typename InputIterator>
+SkipListSet<ElementType, Compare> SkipListSet<ElementType, Compare>::fromSorted(
+    InputIterator first, InputIterator last,
+    std::unique_ptr<SkipListLevelTester<ElementType>> levelTester,
+    Compare compare)
 {
-    return true;
-}
+    SkipListSet s{std::move(levelTester), std::move(compare)};
 
-
-
-template <typename ElementType>
-void SkipListSet<ElementType>::add(const ElementType& element)
-{
-    //std::cout << "skip list height: " << tot_levels << std::endl;
-    if(tot_levels == 0)
+    Node** tails[MAX_LEVELS];
+    for (unsigned int level = 0; level < MAX_LEVELS; ++level)
     {
-        tot_levels++;
-        front_array[0] = init_ll(0);
+        tails[level] = &s.head[level];
     }
-    std::shared_ptr<Node> curr_list_index = front_array[tot_levels-1]->front;
-    int current_level = tot_levels - 1;
-    while (true)
+
+    const Node* previous = nullptr;
+    std::vector<ElementType> unsorted;
+    for (; first != last; ++first)
     {
-        if (curr_list_index->key == element)
+        int order = previous == nullptr ? 1 : s.compare(*first, previous->element);
+        if (order > 0)
         {
-            break; 
-        } 
-        else if(not (curr_list_index->next->key < element)) // check if next key is greater, then move down
-        {
-            if (current_level > 0)
-            {
-                curr_list_index = curr_list_index->below;
-                current_level--;
-            }
-            else
-            {  
-                // std::cout << current_level << std::endl;
-                insert_into_skiplist(curr_list_index, element, current_level);
- 
-                break;
-            }
+            Node* node = s.create_node(*first, s.random_height(*first));
+            s.append_node(node, tails);
+            previous = node;
         }
-        else
+        else if (order < 0)
         {
-            curr_list_index = curr_list_index->next;
+            unsorted.push_back(*first);
         }
     }
+
+    for (ElementType& element : unsorted)
+    {
+        s.add_element(std::move(element));
+    }
+
+    return s;
 }
 
 
-template <typename ElementType>
-bool SkipListSet<ElementType>::contains(const ElementType& element) const
+template <typename ElementType, typename Compare>
+bool SkipListSet<ElementType, Compare>::isImplemented() const noexcept
 {
-    //std::cout << "\n";
-    if(tot_levels == 0)
+    return true;
+}
+
+
+template <typename ElementType, typename Compare>
+void SkipListSet<ElementType, Compare>::add(const ElementType& element)
+{
+    add_element(element);
+}
+
+
+template <typename ElementType, typename Compare>
+void SkipListSet<ElementType, Compare>::add(ElementType&& element)
+{
+    add_element(std::move(element));
+}
+
+
+template <typename ElementType, typename Compare>
+template <typename... Args>
+void SkipListSet<ElementType, Compare>::emplace(Args&&... args)
+{
+    add_element(ElementType(std::forward<Args>(args)...));
+}
+
+
+template <typename ElementType, typename Compare>
+bool SkipListSet<ElementType, Compare>::contains(const ElementType& element) const
+{
+    return find_node(element) != nullptr;
+}
+
+
+template <typename ElementType, typename Compare>
+template <typename Key, typename>
+bool SkipListSet<ElementType, Compare>::contains(const Key& key) const
+{
+    return find_node(key) != nullptr;
+}
+
+
+template <typename ElementType, typename Compare>
+bool SkipListSet<ElementType, Compare>::remove(const ElementType& element)
+{
+    return remove_element(element);
+}
+
+
+template <typename ElementType, typename Compare>
+template <typename Key, typename>
+bool SkipListSet<ElementType, Compare>::remove(const Key& key)
+{
+    return remove_element(key);
+}
+
+
+template <typename ElementType, typename Compare>
+unsigned int SkipListSet<ElementType, Compare>::size() const noexcept
+{
+    return count;
+}
+
+
+template <typename ElementType, typename Compare>
+unsigned long long SkipListSet<ElementType, Compare>::version() const noexcept
+{
+    return version_number;
+}
+
+
+template <typename ElementType, typename Compare>
+typename SkipListSet<ElementType, Compare>::Iterator SkipListSet<ElementType, Compare>::begin() const noexcept
+{
+    return Iterator{head[0]};
+}
+
+
+template <typename ElementType, typename Compare>
+typename SkipListSet<ElementType, Compare>::Iterator SkipListSet<ElementType, Compare>::end() const noexcept
+{
+    return Iterator{};
+}
+
+
+template <typename ElementType, typename Compare>
+typename SkipListSet<ElementType, Compare>::Iterator SkipListSet<ElementType, Compare>::lowerBound(
+    const ElementType& element) const
+{
+    return Iterator{find_bound<true>(element)};
+}
+
+
+template <typename ElementType, typename Compare>
+template <typename Key, typename>
+typename SkipListSet<ElementType, Compare>::Iterator SkipListSet<ElementType, Compare>::lowerBound(
+    const Key& key) const
+{
+    return Iterator{find_bound<true>(key)};
+}
+
+
+template <typename ElementType, typename Compare>
+typename SkipListSet<ElementType, Compare>::Iterator SkipListSet<ElementType, Compare>::upperBound(
+    const ElementType& element) const
+{
+    return Iterator{find_bound<false>(element)};
+}
+
+
+template <typename ElementType, typename Compare>
+template <typename Key, typename>
+typename SkipListSet<ElementType, Compare>::Iterator SkipListSet<ElementType, Compare>::upperBound(
+    const Key& key) const
+{
+    return Iterator{find_bound<false>(key)};
+}
+
+
+template <typename ElementType, typename Compare>
+SetRange<typename SkipListSet<ElementType, Compare>::Iterator> SkipListSet<ElementType, Compare>::range(
+    const ElementType& lo, const ElementType& hi) const
+{
+    if (compare(lo, hi) >= 0)
     {
-        return false;
+        return SetRange<Iterator>{end(), end()};
     }
-    std::shared_ptr<Node> curr_list_index = front_array[tot_levels-1]->front;
-    //std::cout << "total levels: " << tot_levels << std::endl;
-    while (curr_list_index != nullptr)
+    return SetRange<Iterator>{lowerBound(lo), lowerBound(hi)};
+}
+
+
+template <typename ElementType, typename Compare>
+template <typename Key, typename>
+SetRange<typename SkipListSet<ElementType, Compare>::Iterator> SkipListSet<ElementType, Compare>::range(
+    const Key& lo, const Key& hi) const
+{
+    if (compare(lo, hi) >= 0)
     {
-        //std::cout << "curr_key: ";
-        //curr_list_index->key.print_key();
-        //std::cout << "next_key: ";
-        //curr_list_index->next->key.print_key();
-        if (curr_list_index->key == SkipListKey<ElementType>::normal(element)) 
-        {
-            //std::cout << "option: "<< 1 << std::endl;
-            return true;
-        } 
-        else if((not (curr_list_index->next->key < SkipListKey<ElementType>::normal(element))) && (not (curr_list_index->next->key == SkipListKey<ElementType>::normal(element))) ) // check if next key is greater, then move down
-        {
-            //std::cout << "option: "<< 2 << std::endl;
-            curr_list_index = curr_list_index->below;
-        }
-        else
-        {
-            //std::cout << "option: "<< 3 << std::endl;
-            curr_list_index = curr_list_index->next;
-        }
+        return SetRange<Iterator>{end(), end()};
     }
-    return false;
+    return SetRange<Iterator>{lowerBound(lo), lowerBound(hi)};
 }
 
 
-template <typename ElementType>
-unsigned int SkipListSet<ElementType>::size() const noexcept
+template <typename ElementType, typename Compare>
+unsigned int SkipListSet<ElementType, Compare>::levelCount() const noexcept
 {
-    if(tot_levels == 0)
-        return 0;
-    return front_array[0]->length;
+    return level_count;
 }
 
 
-template <typename ElementType>
-unsigned int SkipListSet<ElementType>::levelCount() const noexcept
+template <typename ElementType, typename Compare>
+unsigned int SkipListSet<ElementType, Compare>::elementsOnLevel(unsigned int level) const noexcept
 {
-    return tot_levels;
+    return level < level_count ? level_sizes[level] : 0;
 }
 
 
-template <typename ElementType>
-unsigned int SkipListSet<ElementType>::elementsOnLevel(unsigned int level) const noexcept
+template <typename ElementType, typename Compare>
+bool SkipListSet<ElementType, Compare>::isElementOnLevel(const ElementType& element, unsigned int level) const
 {
-    if(level >= tot_levels)
-        return 0;
-    return front_array[level]->length;
+    const Node* node = find_node(element);
+    return node != nullptr && level < node->height;
 }
 
 
-template <typename ElementType>
-bool SkipListSet<ElementType>::isElementOnLevel(const ElementType& element, unsigned int level) const
+template <typename ElementType, typename Compare>
+typename SkipListSet<ElementType, Compare>::Node** SkipListSet<ElementType, Compare>::tower(Node* node) noexcept
+{
+    return reinterpret_cast<Node**>(reinterpret_cast<unsigned char*>(node) + TOWER_OFFSET);
+}
+
+
+template <typename ElementType, typename Compare>
+typename SkipListSet<ElementType, Compare>::Node* const* SkipListSet<ElementType, Compare>::tower(const Node* node) noexcept
+{
+    return reinterpret_cast<Node* const*>(reinterpret_cast<const unsigned char*>(node) + TOWER_OFFSET);
+}
+
+
+// create_node() leaves the new node's tower for its caller to fill in.  It
+// reuses a removed node of the same height, if there is one, taking it off
+// its free list only once the new element has been built in it.
+template <typename ElementType, typename Compare>
+template <typename E>
+typename SkipListSet<ElementType, Compare>::Node* SkipListSet<ElementType, Compare>::create_node(
+    E&& element, unsigned int height)
 {
-    if(tot_levels == 0)
+    Node* reused = free_nodes[height - 1];
+    if (reused != nullptr)
     {
-        return false;
+        Node* next = tower(reused)[0];
+        Node* node = new (reused) Node{std::forward<E>(element), height};
+        free_nodes[height - 1] = next;
+        return node;
     }
-    std::shared_ptr<Node> curr_list_index = front_array[tot_levels-1]->front;
-    int current_level = tot_levels-1;
-    while (curr_list_index != nullptr)
+
+    void* block = arena.allocate(TOWER_OFFSET + sizeof(Node*) * height, NODE_ALIGNMENT);
+    return new (block) Node{std::forward<E>(element), height};
+}
+
+
+// The arena gives back the nodes' memory; destroy_all() only has to run
+// the elements' destructors, if they have any.
+template <typename ElementType, typename Compare>
+void SkipListSet<ElementType, Compare>::destroy_all() noexcept
+{
+    if constexpr (not std::is_trivially_destructible_v<ElementType>)
     {
-        if (curr_list_index->key == element)
+        for (Node* node = head[0]; node != nullptr; )
         {
-            if (current_level == level)
-                return true;
-            return false;
-        } 
-        else if(not (curr_list_index->next->key < element) && (not (curr_list_index->next->key == element) )) // check if next key is greater, then move down
-        {
-            current_level--;
-            curr_list_index = curr_list_index->below;
+            Node* next = tower(node)[0];
+            node->~Node();
+            node = next;
         }
-        else
+    }
+
+    arena.releaseAll();
+    for (Node*& free : free_nodes)
+    {
+        free = nullptr;
+    }
+}
+
+
+// copy_nodes() copies each of the other skip list's nodes, with the same
+// height, onto the end of every level it occupies.
+template <typename ElementType, typename Compare>
+void SkipListSet<ElementType, Compare>::copy_nodes(const SkipListSet& s)
+{
+    Node** tails[MAX_LEVELS];
+    for (unsigned int level = 0; level < MAX_LEVELS; ++level)
+    {
+        tails[level] = &head[level];
+    }
+
+    try
+    {
+        for (const Node* node = s.head[0]; node != nullptr; node = tower(node)[0])
         {
-            curr_list_index = curr_list_index->next;
+            append_node(create_node(node->element, node->height), tails);
         }
     }
-    return false;
+    catch (...)
+    {
+        destroy_all();
+        throw;
+    }
 }
 
-//private functions
 
-template <typename ElementType>
-void SkipListSet<ElementType>::assign_below_ptr(std::shared_ptr<Node> current, int current_level)
+// append_node() links a node onto the end of every level its tower
+// reaches, when the nodes are being added in ascending order.  tails[level]
+// is the pointer that the next node on each level will be stored in.
+template <typename ElementType, typename Compare>
+void SkipListSet<ElementType, Compare>::append_node(Node* node, Node** (&tails)[MAX_LEVELS]) noexcept
 {
-    std::shared_ptr<Node> below_list_ptr = front_array[current_level-1]->front;
-    while(not (below_list_ptr->key == current->key))
+    for (unsigned int level = 0; level < node->height; ++level)
     {
-        below_list_ptr = below_list_ptr->next;
+        tower(node)[level] = nullptr;
+        *tails[level] = node;
+        tails[level] = &tower(node)[level];
+        level_sizes[level]++;
+    }
+    count++;
+    version_number++;
+
+    if (node->height > level_count)
+    {
+        level_count = node->height;
     }
-    current->below = below_list_ptr;
 }
 
-template <typename ElementType>
-void SkipListSet<ElementType>::insert(SkipListKey<ElementType> key, int current_level)
-{
-    std::shared_ptr<LinkedList> curr_ll = front_array[current_level];
-    curr_ll->length++;
-    std::shared_ptr<Node> current = find_insertion_point(curr_ll->front, key);
 
-    std::shared_ptr<Node> next_node = current->next;
-    std::shared_ptr<Node> new_node{new Node{key, next_node, nullptr}};
-    current->next = new_node;
+// random_height() flips coins with the level tester until the element
+// shouldn't occupy the next level, or it occupies all of them.
+template <typename ElementType, typename Compare>
+unsigned int SkipListSet<ElementType, Compare>::random_height(const ElementType& element)
+{
+    // A moved-from SkipListSet has no level tester of its own.
+    if (levelTester == nullptr)
+    {
+        levelTester = std::make_unique<RandomSkipListLevelTester<ElementType>>();
+    }
 
-    if(current_level > 0)
+    unsigned int height = 1;
+    while (height < MAX_LEVELS && levelTester->shouldOccupyNextLevel(element))
     {
-        current = current->next;
-        assign_below_ptr(current, current_level);
+        height++;
     }
+    return height;
 }
 
-template <typename ElementType>
-void SkipListSet<ElementType>::copy_front_array(std::shared_ptr<std::shared_ptr<LinkedList>[]> front)
+
+// add_element() is shared by both overloads of add().  One search from the
+// top level down finds the node that the new one follows on every level
+// (or -INF's tower, head, if it's first), after which the new node is
+// spliced in after each of them, without searching again.
+template <typename ElementType, typename Compare>
+template <typename E>
+void SkipListSet<ElementType, Compare>::add_element(E&& element)
 {
-    if(tot_levels > 0)
+    Node** predecessors[MAX_LEVELS];
+    Node** links = head;
+    for (unsigned int level = level_count; level-- > 0; )
     {
-        std::shared_ptr<std::shared_ptr<LinkedList>[]> copy_array{new std::shared_ptr<LinkedList>[capacity]};
-        for(int i = 0; i < tot_levels; i++)
+        while (links[level] != nullptr)
         {
-            copy_array[i] = std::shared_ptr<LinkedList>{new LinkedList{front[i]->length, front[i]->front, front[i]->tail}};
+            int order = compare(links[level]->element, element);
+            if (order == 0)
+            {
+                return;
+            }
+            else if (order > 0)
+            {
+                break;
+            }
+            links = tower(links[level]);
         }
-        front_array = copy_array;
+        predecessors[level] = links;
+    }
+
+    unsigned int height = random_height(element);
+    for (; level_count < height; ++level_count)
+    {
+        predecessors[level_count] = head;
+    }
+
+    Node* node = create_node(std::forward<E>(element), height);
+    Node** nodeTower = tower(node);
+    for (unsigned int level = 0; level < height; ++level)
+    {
+        nodeTower[level] = predecessors[level][level];
+        predecessors[level][level] = node;
+        level_sizes[level]++;
     }
+    count++;
+    version_number++;
 }
 
-template <typename ElementType>
-void SkipListSet<ElementType>::insert_into_skiplist(std::shared_ptr<Node> current, const ElementType& element, int current_level)
-{
-    bool coin;
-    int curr_level = current_level;
-    SkipListKey<ElementType> insert_key = SkipListKey<ElementType>::normal(element);
-    insert(insert_key, curr_level);
-    while(true)
-    {
-        coin = levelTester->shouldOccupyNextLevel(element);
-        //std::cout << "coin: " << coin << std::endl;
-        // std::cout << "capacity: " << capacity << std::endl;
-        if(coin)
+
+// find_node() returns the node whose element is equal to the given key,
+// or nullptr if there isn't one.  It moves right along each level while
+// the next node's element is less than the key, then down a level.
+template <typename ElementType, typename Compare>
+template <typename Key>
+const typename SkipListSet<ElementType, Compare>::Node* SkipListSet<ElementType, Compare>::find_node(
+    const Key& key) const
+{
+    Node* const* links = head;
+    for (unsigned int level = level_count; level-- > 0; )
+    {
+        while (links[level] != nullptr)
         {
-            curr_level++;
-            // std::cout << "curr_level: " << curr_level << std::endl;
-            // std::cout << "capacity: " << capacity << std::endl;
-            if (curr_level < tot_levels)
+            int order = compare(links[level]->element, key);
+            if (order == 0)
             {
-                insert(insert_key, curr_level);
+                return links[level];
             }
-            else if(curr_level < capacity)
+            else if (order > 0)
             {
-                tot_levels++;
-                //std::cout << "curr levels: "  << curr_level << std::endl;
-                front_array[curr_level] = init_ll(curr_level);             
-                insert(insert_key, curr_level);
+                break;
             }
-            else
+            links = tower(links[level]);
+        }
+    }
+    return nullptr;
+}
+
+
+// remove_element() is shared by both overloads of remove().  Like
+// add_element(), it finds the node before the key on every level in one
+// search from the top level down, then unlinks the node from each level
+// it occupies, without searching again.
+template <typename ElementType, typename Compare>
+template <typename Key>
+bool SkipListSet<ElementType, Compare>::remove_element(const Key& key)
+{
+    Node** predecessors[MAX_LEVELS];
+    Node** links = head;
+    Node* found = nullptr;
+    for (unsigned int level = level_count; level-- > 0; )
+    {
+        while (links[level] != nullptr)
+        {
+            int order = compare(links[level]->element, key);
+            if (order == 0)
             {
-                capacity*=2;
-                copy_front_array(front_array);
-                // std::cout << "herre" << std::endl;
-                // print_everything();
-                tot_levels++;
-                front_array[curr_level] = init_ll(curr_level);
-                insert(insert_key, curr_level);
+                found = links[level];
+                break;
+            }
+            else if (order > 0)
+            {
+                break;
             }
+            links = tower(links[level]);
         }
-        else
+        predecessors[level] = links;
+    }
+
+    if (found == nullptr)
+    {
+        return false;
+    }
+
+    Node** foundTower = tower(found);
+    for (unsigned int level = 0; level < found->height; ++level)
+    {
+        predecessors[level][level] = foundTower[level];
+        level_sizes[level]--;
+    }
+    while (level_count > 0 && head[level_count - 1] == nullptr)
+    {
+        level_count--;
+    }
+    count--;
+    version_number++;
+
+    unsigned int height = found->height;
+    found->~Node();
+    foundTower[0] = free_nodes[height - 1];
+    free_nodes[height - 1] = found;
+    return true;
+}
+
+
+// find_bound() returns the first node whose element is not less than the
+// given key (if IncludeEqual) or is greater than it (if not), or nullptr
+// if there isn't one.  It moves right along each level while the next
+// node's element comes before the bound, then down a level; the bound is
+// whatever follows it on the bottom level.
+template <typename ElementType, typename Compare>
+template <bool IncludeEqual, typename Key>
+const typename SkipListSet<ElementType, Compare>::Node* SkipListSet<ElementType, Compare>::find_bound(
+    const Key& key) const
+{
+    Node* const* links = head;
+    for (unsigned int level = level_count; level-- > 0; )
+    {
+        while (links[level] != nullptr)
         {
-            break; 
+            int order = compare(links[level]->element, key);
+            if (IncludeEqual ? order >= 0 : order > 0)
+            {
+                break;
+            }
+            links = tower(links[level]);
         }
     }
+    return links[0];
 }
 
 
 
 #endif
-
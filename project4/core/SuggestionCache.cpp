@@ -0,0 +1,119 @@
+// SuggestionCache.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include "SuggestionCache.hpp"
+#include <algorithm>
+#include "HashFunctions.hpp"
+
+
+
+SuggestionCache::SuggestionCache(unsigned int capacity, unsigned int shardCount)
+    : shard_count{std::clamp(shardCount, 1u, std::max(1u, capacity))}, shards{new Shard[shard_count]}
+{
+    // Spread the capacity as evenly as possible.  There are no more shards
+    // than words, so every shard has room for at least one.
+    for (unsigned int i = 0; i < shard_count; ++i)
+    {
+        shards[i].capacity = std::max(1u, capacity / shard_count + (i < capacity % shard_count ? 1 : 0));
+    }
+}
+
+
+bool SuggestionCache::find(std::string_view word, unsigned long long stamp, std::vector<std::string>& suggestions)
+{
+    Shard& shard = shard_for(word);
+    std::lock_guard<std::mutex> lock{shard.mutex};
+
+    auto found = shard.index.find(word);
+    if (found == shard.index.end())
+    {
+        shard.misses++;
+        return false;
+    }
+    if (found->second->stamp != stamp)
+    {
+        shard.misses++;
+        shard.stale++;
+        return false;
+    }
+
+    shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+    suggestions = found->second->suggestions;
+    shard.hits++;
+    return true;
+}
+
+
+void SuggestionCache::insert(std::string_view word, unsigned long long stamp, const std::vector<std::string>& suggestions)
+{
+    Shard& shard = shard_for(word);
+    std::lock_guard<std::mutex> lock{shard.mutex};
+
+    auto found = shard.index.find(word);
+    if (found != shard.index.end())
+    {
+        found->second->stamp = stamp;
+        found->second->suggestions = suggestions;
+        shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+        return;
+    }
+
+    if (shard.entries.size() >= shard.capacity)
+    {
+        shard.index.erase(shard.entries.back().word);
+        shard.entries.pop_back();
+        shard.evictions++;
+    }
+
+    shard.entries.push_front(Entry{std::string{word}, stamp, suggestions});
+    shard.index.emplace(shard.entries.front().word, shard.entries.begin());
+}
+
+
+void SuggestionCache::clear()
+{
+    for (unsigned int i = 0; i < shard_count; ++i)
+    {
+        std::lock_guard<std::mutex> lock{shards[i].mutex};
+        shards[i].index.clear();
+        shards[i].entries.clear();
+    }
+}
+
+
+SuggestionCacheStatistics SuggestionCache::statistics() const
+{
+    SuggestionCacheStatistics stats{0, 0, 0, 0, 0, 0};
+    for (unsigned int i = 0; i < shard_count; ++i)
+    {
+        std::lock_guard<std::mutex> lock{shards[i].mutex};
+        stats.size += shards[i].entries.size();
+        stats.capacity += shards[i].capacity;
+        stats.hits += shards[i].hits;
+        stats.misses += shards[i].misses;
+        stats.stale += shards[i].stale;
+        stats.evictions += shards[i].evictions;
+    }
+    return stats;
+}
+
+
+void SuggestionCache::resetStatistics()
+{
+    for (unsigned int i = 0; i < shard_count; ++i)
+    {
+        std::lock_guard<std::mutex> lock{shards[i].mutex};
+        shards[i].hits = 0;
+        shards[i].misses = 0;
+        shards[i].stale = 0;
+        shards[i].evictions = 0;
+    }
+}
+
+
+SuggestionCache::Shard& SuggestionCache::shard_for(std::string_view word) const
+{
+    return shards[hashing::wyhashString(word) % shard_count];
+}
@@ -0,0 +1,135 @@
+// SuggestionCache.hpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A SuggestionCache remembers the suggestions found for recently
+// misspelled words, so that a WordChecker using one (see
+// WordChecker::setCache()) only has to find suggestions for a typo the
+// first time it sees it, or the first time since the typo was evicted.
+// Real typos are heavily skewed toward a few common ones, so even a small
+// cache answers most requests.
+//
+// The cache holds at most a fixed number of words, discarding the least
+// recently used one to make room for another.  Any number of threads can
+// use it at once: it's divided into shards, each with its own lock and
+// its own share of the capacity, and a word always goes in the shard its
+// hash chooses, so threads looking up different words rarely wait for
+// one another.
+//
+// Every entry carries a "stamp" describing the dictionary it was found
+// with, and a lookup with a different stamp is treated as a miss, so the
+// entries for an old dictionary are never used once it changes.  (The
+// WordChecker's stamp is its Set's version; see WordChecker::setCache().)
+// clear() empties the cache outright.
+
+#ifndef SUGGESTIONCACHE_HPP
+#define SUGGESTIONCACHE_HPP
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+
+
+// A SuggestionCacheStatistics describes how often a SuggestionCache has
+// had what was asked of it.
+struct SuggestionCacheStatistics
+{
+    unsigned int size;
+    unsigned int capacity;
+
+    // Lookups that found an entry with the right stamp (hits), and that
+    // didn't (misses), including those that found an entry for an old
+    // dictionary (stale).
+    unsigned long long hits;
+    unsigned long long misses;
+    unsigned long long stale;
+
+    // Entries discarded to make room for others.
+    unsigned long long evictions;
+
+    double hitRate() const noexcept
+    {
+        return hits + misses == 0 ? 0.0 : static_cast<double>(hits) / (hits + misses);
+    }
+};
+
+
+
+class SuggestionCache
+{
+public:
+    static constexpr unsigned int DEFAULT_SHARD_COUNT = 16;
+
+public:
+    // Initializes an empty SuggestionCache that holds up to capacity
+    // words (but room for at least one), divided among the given number
+    // of shards (but no more shards than words).
+    explicit SuggestionCache(unsigned int capacity, unsigned int shardCount = DEFAULT_SHARD_COUNT);
+
+    // A SuggestionCache can't be copied or moved, since other threads
+    // may be using it.
+    SuggestionCache(const SuggestionCache& c) = delete;
+    SuggestionCache& operator=(const SuggestionCache& c) = delete;
+
+
+    // find() looks for the given word's suggestions, found with the
+    // dictionary the stamp describes.  If they're there, it copies them
+    // into suggestions, makes the word the most recently used in its
+    // shard, and returns true; otherwise, it returns false.
+    bool find(std::string_view word, unsigned long long stamp, std::vector<std::string>& suggestions);
+
+    // insert() stores the given word's suggestions, replacing any that
+    // were already there, and evicting the least recently used word in
+    // its shard if the shard is full.
+    void insert(std::string_view word, unsigned long long stamp, const std::vector<std::string>& suggestions);
+
+    // clear() removes every entry, without resetting the statistics.
+    void clear();
+
+
+    // statistics() returns the cache's size and what its lookups have
+    // found since it was created or resetStatistics() was last called.
+    SuggestionCacheStatistics statistics() const;
+
+    void resetStatistics();
+
+
+private:
+    struct Entry
+    {
+        std::string word;
+        unsigned long long stamp;
+        std::vector<std::string> suggestions;
+    };
+
+    // Each shard's entries are in a list from most to least recently
+    // used, with a map from each word (viewing the string in its entry)
+    // to its place in the list.
+    struct alignas(64) Shard
+    {
+        std::mutex mutex;
+        unsigned int capacity = 0;
+        std::list<Entry> entries;
+        std::unordered_map<std::string_view, std::list<Entry>::iterator> index;
+
+        unsigned long long hits = 0;
+        unsigned long long misses = 0;
+        unsigned long long stale = 0;
+        unsigned long long evictions = 0;
+    };
+
+    unsigned int shard_count;
+    std::unique_ptr<Shard[]> shards;
+
+    Shard& shard_for(std::string_view word) const;
+};
+
+
+
+#endif
@@ -0,0 +1,291 @@
+// Trie.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include "Trie.hpp"
+#include <algorithm>
+
+
+
+// The state of one call to withinDistance().  rows holds one row per
+// letter of the prefix being searched, plus one for the empty prefix;
+// entry j of row i is the distance from the first j letters of the string
+// to the first i letters of the prefix, or maxDistance + 1 if that's more.
+struct Trie::Search
+{
+    std::string_view s;
+    unsigned int maxDistance;
+    std::string prefix;
+    std::vector<unsigned int> rows;
+    std::vector<std::string> found;
+
+    unsigned int* row(std::size_t depth)
+    {
+        return rows.data() + depth * (s.size() + 1);
+    }
+};
+
+
+
+Trie::Trie()
+    : nodes{Node{0, 0, '\0', false}}, word_count{0}
+{
+}
+
+
+Trie::Trie(const std::vector<std::string>& words)
+    : Trie{}
+{
+    for (const std::string& word : words)
+    {
+        add(word);
+    }
+    compact();
+}
+
+
+bool Trie::isImplemented() const noexcept
+{
+    return true;
+}
+
+
+void Trie::add(const std::string& element)
+{
+    std::uint32_t node = 0;
+
+    for (char c : element)
+    {
+        // Find where c belongs among the children, which are in order.
+        std::uint32_t previous = 0;
+        std::uint32_t child = nodes[node].firstChild;
+        while (child != 0 && nodes[child].letter < c)
+        {
+            previous = child;
+            child = nodes[child].nextSibling;
+        }
+
+        if (child == 0 || nodes[child].letter != c)
+        {
+            std::uint32_t added = nodes.size();
+            nodes.push_back(Node{0, child, c, false});
+            if (previous == 0)
+            {
+                nodes[node].firstChild = added;
+            }
+            else
+            {
+                nodes[previous].nextSibling = added;
+            }
+            child = added;
+        }
+
+        node = child;
+    }
+
+    if (not nodes[node].terminal)
+    {
+        nodes[node].terminal = true;
+        word_count++;
+    }
+}
+
+
+bool Trie::contains(const std::string& element) const
+{
+    return contains_view(element);
+}
+
+
+unsigned int Trie::size() const noexcept
+{
+    return word_count;
+}
+
+
+std::vector<std::string> Trie::withinDistance(std::string_view s, unsigned int maxDistance) const
+{
+    Search search{s, maxDistance, std::string{}, std::vector<unsigned int>{}, std::vector<std::string>{}};
+
+    // No word longer than this can be close enough.
+    std::size_t maxDepth = s.size() + maxDistance;
+    search.prefix.reserve(maxDepth);
+    search.rows.resize((maxDepth + 1) * (s.size() + 1));
+
+    unsigned int* first = search.row(0);
+    for (std::size_t j = 0; j <= s.size(); ++j)
+    {
+        first[j] = std::min<std::size_t>(j, maxDistance + 1);
+    }
+
+    if (nodes[0].terminal && first[s.size()] <= maxDistance)
+    {
+        search.found.push_back(std::string{});
+    }
+    if (maxDepth == 0)
+    {
+        return std::move(search.found);
+    }
+
+    for (std::uint32_t child = nodes[0].firstChild; child != 0; child = nodes[child].nextSibling)
+    {
+        search_from(search, child, 1);
+    }
+
+    return std::move(search.found);
+}
+
+
+void Trie::compact()
+{
+    // Number the nodes in breadth-first order, so that each node's
+    // children (which are siblings of one another) are numbered in a row.
+    std::vector<std::uint32_t> order;
+    order.reserve(nodes.size());
+    order.push_back(0);
+    for (std::size_t i = 0; i < order.size(); ++i)
+    {
+        for (std::uint32_t child = nodes[order[i]].firstChild; child != 0; child = nodes[child].nextSibling)
+        {
+            order.push_back(child);
+        }
+    }
+
+    std::vector<std::uint32_t> renumbered(nodes.size());
+    for (std::uint32_t i = 0; i < order.size(); ++i)
+    {
+        renumbered[order[i]] = i;
+    }
+
+    std::vector<Node> compacted;
+    compacted.reserve(nodes.size());
+    for (std::uint32_t old : order)
+    {
+        Node n = nodes[old];
+        n.firstChild = renumbered[n.firstChild];
+        n.nextSibling = renumbered[n.nextSibling];
+        compacted.push_back(n);
+    }
+
+    nodes = std::move(compacted);
+}
+
+
+unsigned int Trie::nodeCount() const noexcept
+{
+    return nodes.size();
+}
+
+
+bool Trie::contains_view(std::string_view word) const noexcept
+{
+    std::uint32_t node = 0;
+
+    for (char c : word)
+    {
+        std::uint32_t child = nodes[node].firstChild;
+        while (child != 0 && nodes[child].letter < c)
+        {
+            child = nodes[child].nextSibling;
+        }
+        if (child == 0 || nodes[child].letter != c)
+        {
+            return false;
+        }
+        node = child;
+    }
+
+    return nodes[node].terminal;
+}
+
+
+// Extends the search's prefix with the given node's letter, which puts
+// it depth letters long, fills in its row from the one above, and goes
+// on to the node's children unless the row shows that none of them can
+// be close enough.
+void Trie::search_from(Search& search, std::uint32_t node, std::size_t depth) const
+{
+    const Node& n = nodes[node];
+    std::string_view s = search.s;
+    unsigned int limit = search.maxDistance + 1;
+
+    search.prefix.push_back(n.letter);
+
+    const unsigned int* above = search.row(depth - 1);
+    const unsigned int* twoAbove = depth >= 2 ? search.row(depth - 2) : nullptr;
+    unsigned int* row = search.row(depth);
+
+    // Entries further than maxDistance from the diagonal are at least
+    // that far apart in length, so they're never close enough.
+    std::size_t low = depth > search.maxDistance ? depth - search.maxDistance : 0;
+    std::size_t high = std::min(s.size(), depth + search.maxDistance);
+
+    row[0] = std::min<std::size_t>(depth, limit);
+    unsigned int smallest = row[0];
+    for (std::size_t j = 1; j <= s.size(); ++j)
+    {
+        if (j < low || j > high)
+        {
+            row[j] = limit;
+            continue;
+        }
+
+        unsigned int distance = std::min({
+            above[j] + 1,
+            row[j - 1] + 1,
+            above[j - 1] + (s[j - 1] == n.letter ? 0 : 1)});
+
+        if (twoAbove != nullptr && j >= 2 && s[j - 1] == search.prefix[depth - 2] && s[j - 2] == n.letter)
+        {
+            distance = std::min(distance, twoAbove[j - 2] + 1);
+        }
+
+        row[j] = std::min(distance, limit);
+        smallest = std::min(smallest, row[j]);
+    }
+
+    if (n.terminal && row[s.size()] < limit)
+    {
+        search.found.push_back(search.prefix);
+    }
+
+    if (smallest < limit && depth < s.size() + search.maxDistance)
+    {
+        // With no edits to spare, the next letter has to be one that
+        // matches: the letter after some prefix of the string that's within
+        // the distance already, or the first of a swapped pair whose
+        // second letter was just matched.  Any other child can be skipped
+        // without working out its row.
+        char wanted[64];
+        std::size_t wantedCount = 0;
+        bool spare = smallest < search.maxDistance || 4 * search.maxDistance + 2 > sizeof(wanted);
+        if (not spare)
+        {
+            for (std::size_t j = low; j <= high && j < s.size(); ++j)
+            {
+                if (row[j] < limit)
+                {
+                    wanted[wantedCount++] = s[j];
+                }
+            }
+            for (std::size_t j = std::max<std::size_t>(low, 2); j <= high + 1 && j <= s.size(); ++j)
+            {
+                if (above[j - 2] < search.maxDistance && s[j - 1] == n.letter)
+                {
+                    wanted[wantedCount++] = s[j - 2];
+                }
+            }
+        }
+
+        for (std::uint32_t child = n.firstChild; child != 0; child = nodes[child].nextSibling)
+        {
+            if (spare || std::find(wanted, wanted + wantedCount, nodes[child].letter) != wanted + wantedCount)
+            {
+                search_from(search, child, depth + 1);
+            }
+        }
+    }
+
+    search.prefix.pop_back();
+}
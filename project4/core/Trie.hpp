@@ -0,0 +1,117 @@
+// Trie.hpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A Trie is a Set of strings stored as a tree of letters, where each
+// path from the root spells out a prefix, and the nodes where a word ends
+// are marked.  Words that share a prefix share its nodes.  Each node
+// holds one letter and two indexes (its first child and its next sibling,
+// with siblings kept in alphabetical order), all in one array, so a node
+// takes twelve bytes.  A Trie built from a vector of words lays its nodes
+// out breadth-first, so that siblings are next to one another in memory.
+//
+// What a Trie adds to a Set is withinDistance(), which finds every word
+// within a given edit distance of a string without generating a single
+// candidate spelling.  It walks the trie depth-first while simulating a
+// Levenshtein automaton for the string: for each prefix, it keeps a row
+// saying how many edits it takes to turn each prefix of the string into
+// that prefix of a word.  Once every entry in a row exceeds the distance,
+// no word below that node can be close enough, so the whole subtree is
+// skipped.  Only entries within the distance of the diagonal can be
+// small enough to matter, so each row costs 2 * distance + 1 steps.  And
+// once a prefix has used up every edit, only the few children whose
+// letters match what the string needs next are searched.
+//
+// The edits counted are the kinds WordChecker tries: inserting, deleting
+// or replacing a letter, or swapping two adjacent letters (so this is the
+// "optimal string alignment" distance).  Any character counts as a letter,
+// though, while WordChecker only ever inserts or replaces 'A' through 'Z'.
+
+#ifndef TRIE_HPP
+#define TRIE_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "Set.hpp"
+
+
+
+class Trie : public Set<std::string>
+{
+public:
+    // Initializes a Trie to be empty.
+    Trie();
+
+    // Initializes a Trie containing the given words.
+    explicit Trie(const std::vector<std::string>& words);
+
+
+    bool isImplemented() const noexcept override;
+
+
+    // add() adds a word to the Trie, if it's not already there, in time
+    // proportional to its length (times the size of the alphabet, in the
+    // worst case, to find each letter among its siblings).
+    void add(const std::string& element) override;
+
+
+    // contains() returns true if the given word is in the Trie, false
+    // otherwise, in time proportional to its length.
+    bool contains(const std::string& element) const override;
+
+    // This overload of contains() looks up a std::string_view.
+    template <typename Key, typename = std::enable_if_t<std::is_same_v<Key, std::string_view>>>
+    bool contains(const Key& key) const;
+
+
+    unsigned int size() const noexcept override;
+
+
+    // withinDistance() returns every word whose edit distance from the
+    // given string is at most maxDistance (including the string itself,
+    // if it's a word), in alphabetical order.
+    std::vector<std::string> withinDistance(std::string_view s, unsigned int maxDistance) const;
+
+
+    // nodeCount() returns the number of nodes, including the root.
+    unsigned int nodeCount() const noexcept;
+
+
+private:
+    struct Node
+    {
+        // Index 0 is the root, which is never anyone's child or sibling,
+        // so 0 means "none".
+        std::uint32_t firstChild;
+        std::uint32_t nextSibling;
+        char letter;
+        bool terminal;
+    };
+
+    struct Search;
+
+    std::vector<Node> nodes;
+    unsigned int word_count;
+
+    bool contains_view(std::string_view word) const noexcept;
+
+    void compact();
+
+    void search_from(Search& search, std::uint32_t node, std::size_t depth) const;
+};
+
+
+
+template <typename Key, typename>
+bool Trie::contains(const Key& key) const
+{
+    return contains_view(key);
+}
+
+
+
+#endif
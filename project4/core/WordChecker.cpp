@@ -5,106 +5,292 @@
 //
 // Replace and/or augment the implementations below as needed to meet
 // the requirements.
+//
+// Every candidate spelling is built by changing a single buffer in place
+// (and then changing it back, or moving on to the next change), so none
+// of them needs a heap allocation; only the suggestions themselves are
+// copied into new strings.
 
 #include "WordChecker.hpp"
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include "HashFunctions.hpp"
+
+
+
+namespace
+{
+    // How likely each kind of typo is, relative to the others, for
+    // findBestSuggestions().  A suggestion that's the word itself needs no
+    // fixing at all.
+    const double SAME_WEIGHT = 1.0;
+    const double SWAP_WEIGHT = 0.9;
+    const double REPLACE_WEIGHT = 0.7;
+    const double DELETE_WEIGHT = 0.6;
+    const double INSERT_WEIGHT = 0.6;
+    const double SPLIT_WEIGHT = 0.4;
+
+
+    bool isAlphabetLetter(char c)
+    {
+        return c >= 'A' && c <= 'Z';
+    }
+
+
+    // Returns true if WordChecker's own candidates for the word include
+    // the given one, which is within one edit of it.  A Trie or a
+    // DeletionIndex finds words that differ by any character, but the
+    // candidates only ever insert or replace 'A' through 'Z'.
+    bool isAlphabetEdit(const std::string& word, const std::string& nearby)
+    {
+        if(nearby.size() < word.size())
+        {
+            return true;
+        }
+
+        auto difference = std::mismatch(word.begin(), word.end(), nearby.begin());
+        std::size_t i = difference.first - word.begin();
+        if(nearby.size() > word.size())
+        {
+            // Wherever the letter was inserted, the first difference is a
+            // copy of it.
+            return isAlphabetLetter(nearby[i]);
+        }
+        if(i == word.size())
+        {
+            // The word itself is a candidate when a letter is replaced by
+            // itself or two equal letters are swapped.
+            return std::any_of(word.begin(), word.end(), isAlphabetLetter)
+                || std::adjacent_find(word.begin(), word.end()) != word.end();
+        }
+        if(i + 1 < word.size() && word[i] == nearby[i + 1] && word[i + 1] == nearby[i]
+            && std::equal(word.begin() + i + 2, word.end(), nearby.begin() + i + 2))
+        {
+            return true;
+        }
+        return isAlphabetLetter(nearby[i]);
+    }
+}
+
+
+
+// A SuggestionList is the suggestions found so far, along with a small
+// open-addressing hash table of their indexes, so that adding one that's
+// already there is noticed without searching the whole list.
+class WordChecker::SuggestionList
+{
+public:
+    SuggestionList()
+        : slots(INITIAL_SLOTS, EMPTY)
+    {
+    }
+
+    void add(std::string_view suggestion)
+    {
+        if(2 * (suggestions.size() + 1) > slots.size())
+        {
+            grow();
+        }
+
+        std::size_t slot = find_slot(suggestion);
+        if(slots[slot] == EMPTY)
+        {
+            slots[slot] = suggestions.size();
+            suggestions.emplace_back(suggestion);
+        }
+    }
+
+    std::vector<std::string>& list() noexcept
+    {
+        return suggestions;
+    }
+
+private:
+    static constexpr std::size_t INITIAL_SLOTS = 16;
+    static constexpr std::uint32_t EMPTY = 0xffffffffu;
+
+    std::vector<std::string> suggestions;
+    std::vector<std::uint32_t> slots;
+
+    // Returns the slot holding the given suggestion's index, or the empty
+    // slot where it belongs.
+    std::size_t find_slot(std::string_view suggestion) const noexcept
+    {
+        std::size_t mask = slots.size() - 1;
+        std::size_t slot = hashing::wyhashString(suggestion) & mask;
+        while(slots[slot] != EMPTY && suggestions[slots[slot]] != suggestion)
+        {
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+
+    void grow()
+    {
+        slots.assign(slots.size() * 2, EMPTY);
+        for(std::uint32_t i = 0; i < suggestions.size(); ++i)
+        {
+            slots[find_slot(suggestions[i])] = i;
+        }
+    }
+};
 
 
 
 WordChecker::WordChecker(const Set<std::string>& words)
-    : words{words}
+    : words{words}, filter{nullptr}, trie{nullptr}, index{nullptr}, cache{nullptr}
+{
+}
+
+
+WordChecker::WordChecker(const Set<std::string>& words, const BloomFilter& filter)
+    : words{words}, filter{&filter}, trie{nullptr}, index{nullptr}, cache{nullptr}
+{
+}
+
+
+WordChecker::WordChecker(const Trie& words)
+    : words{words}, filter{nullptr}, trie{&words}, index{nullptr}, cache{nullptr}
+{
+}
+
+
+WordChecker::WordChecker(const Set<std::string>& words, const DeletionIndex& index)
+    : words{words}, filter{nullptr}, trie{nullptr}, index{&index}, cache{nullptr}
 {
 }
 
 
 bool WordChecker::wordExists(const std::string& word) const
 {
+    if(filter != nullptr && !filter->mightContain(word))
+    {
+        return false;
+    }
     if(words.contains(word)){
         return true;
     }
     return false;
 }
 
-void WordChecker::deleteWord(std::vector<std::string>& suggestions, std::string word) const
+// Looks up part of a word, which is only copied into the buffer (since
+// the Set can only look up a std::string) if the filter doesn't rule it
+// out first.  A Trie can look it up as it is.
+bool WordChecker::partExists(std::string_view part, std::string& candidate) const
+{
+    if(trie != nullptr)
+    {
+        return trie->contains(part);
+    }
+    if(filter != nullptr && !filter->mightContain(part))
+    {
+        return false;
+    }
+    candidate.assign(part.data(), part.size());
+    return words.contains(candidate);
+}
+
+// The candidate starts as the word without its first letter.  Moving on
+// from deleting letter i - 1 to deleting letter i only means putting
+// letter i - 1 back where letter i was.
+void WordChecker::deleteWord(SuggestionList& suggestions, const std::string& word, std::string& candidate) const
 {
-    std::string copy_word;
-    for(int i = 0; i < word.size(); i++)
+    if(word.empty())
+    {
+        return;
+    }
+
+    candidate.assign(word, 1);
+    for(std::size_t i = 0; i < word.size(); i++)
     {
-        copy_word = word;
-        copy_word.erase(i,1);
-        if(wordExists(copy_word))
+        if(i > 0)
+        {
+            candidate[i - 1] = word[i - 1];
+        }
+        if(wordExists(candidate))
         {
-            suggestions.push_back(copy_word);
+            suggestions.add(candidate);
         }
     }
 }
 
-void WordChecker::swapChars(std::vector<std::string>& suggestions, std::string word) const
+void WordChecker::swapChars(SuggestionList& suggestions, const std::string& word, std::string& candidate) const
 {
-    std::string copy_word;
-    for(int i = 0; i < word.size()-1; i++)
+    candidate.assign(word);
+    for(std::size_t i = 0; i + 1 < word.size(); i++)
     {
-        copy_word = word;
-        std::swap(copy_word[i], copy_word[i+1]);
-        if(wordExists(copy_word))
+        std::swap(candidate[i], candidate[i+1]);
+        if(wordExists(candidate))
         {
-            suggestions.push_back(copy_word);
+            suggestions.add(candidate);
         }
+        std::swap(candidate[i], candidate[i+1]);
     }
 }
 
-void WordChecker::addAlphabet(std::vector<std::string>& suggestions, std::string word) const 
+// The candidate is one letter longer than the word, with a "gap" where
+// the new letter goes.  Moving the gap from position i to i + 1 only
+// means copying letter i of the word into the gap.
+void WordChecker::addAlphabet(SuggestionList& suggestions, const std::string& word, std::string& candidate) const 
 {
-    std::string copy_word;
-    std::string insert;
-    for(int i = 0; i < word.size()+1; i++)
+    candidate.assign(1, ' ');
+    candidate.append(word);
+    for(std::size_t i = 0; i < word.size()+1; i++)
     {
+        if(i > 0)
+        {
+            candidate[i - 1] = word[i - 1];
+        }
         for(char c = 'A'; c<='Z'; c++)
         {
-            copy_word = word;
-            insert = std::string{c};
-            copy_word.insert(i, insert);
-            if(wordExists(copy_word))
+            candidate[i] = c;
+            if(wordExists(candidate))
             {
-                suggestions.push_back(copy_word);
+                suggestions.add(candidate);
             }
         }
     }
 }
 
-void WordChecker::replaceAlphabet(std::vector<std::string>& suggestions,  std::string word) const
+void WordChecker::replaceAlphabet(SuggestionList& suggestions, const std::string& word, std::string& candidate) const
 {
-    std::string copy_word;
-    for(int i = 0; i < word.size(); i++)
+    candidate.assign(word);
+    for(std::size_t i = 0; i < word.size(); i++)
     {
         for(char c = 'A'; c<='Z'; c++)
         {
-            copy_word = word;
-            copy_word.at(i) = c;
-            if (wordExists(copy_word))
+            candidate[i] = c;
+            if (wordExists(candidate))
             {
-                suggestions.push_back(copy_word);
+                suggestions.add(candidate);
             }
         }
+        candidate[i] = word[i];
     }
 }
 
-void WordChecker::splitWord(std::vector<std::string>& suggestions, std::string word) const
+void WordChecker::splitWord(SuggestionList& suggestions, const std::string& word, std::string& candidate) const
 {
-    std::string copy_word;
-    std::string substring1;
-    std::string substring2;
+    std::string_view whole{word};
 
-    for(int i = 1; i < word.size()-1; i++)
+    for(std::size_t i = 1; i + 1 < word.size(); i++)
     {
-        copy_word = word;
-        copy_word.insert(i, " "); 
-        substring1 = copy_word.substr(0,i);
-        substring2 = copy_word.substr(i+1);
-
-        if ((wordExists(substring1)) && (wordExists(substring2)))
+        if(partExists(whole.substr(0, i), candidate) && partExists(whole.substr(i), candidate))
         {
-            suggestions.push_back(copy_word);
+            std::string split;
+            split.reserve(word.size() + 1);
+            split.append(whole.substr(0, i));
+            split.push_back(' ');
+            split.append(whole.substr(i));
+            suggestions.add(split);
         }
     }
 }
@@ -114,24 +300,246 @@ void WordChecker::splitWord(std::vector<std::string>& suggestions, std::string w
 
 
 
+void WordChecker::setCache(SuggestionCache* cache, VersionFunction version)
+{
+    if(cache != nullptr && !version)
+    {
+        throw std::invalid_argument{"A SuggestionCache needs a VersionFunction"};
+    }
+    this->cache = cache;
+    this->version = std::move(version);
+}
+
+
 std::vector<std::string> WordChecker::findSuggestions(const std::string& word) const
 {
-    // Nonsensical code because the compiler requires the member variables
-    // 'words' to be used somewhere, or else it becomes a warning (which
-    // turns into an error).
-    //words.isImplemented();
+    if(cache == nullptr)
+    {
+        return find_suggestions(word);
+    }
+
+    // The version changes whenever the Set does, so entries found with
+    // an older Set are never used.
+    unsigned long long stamp = version();
     std::vector<std::string> suggestions;
-    splitWord(suggestions, word);
-    replaceAlphabet(suggestions, word);
-    addAlphabet(suggestions, word);
-    swapChars(suggestions, word);
-    deleteWord(suggestions, word);
-    suggestions.erase(unique(suggestions.begin(), suggestions.end()), suggestions.end() );
+    if(!cache->find(word, stamp, suggestions))
+    {
+        suggestions = find_suggestions(word);
+        cache->insert(word, stamp, suggestions);
+    }
+    return suggestions;
+}
 
 
+std::vector<std::string> WordChecker::find_suggestions(const std::string& word) const
+{
+    // The longest candidate is one letter longer than the word, so this
+    // is the only allocation the buffer needs.
+    std::string candidate;
+    candidate.reserve(word.size() + 1);
 
-    
+    SuggestionList suggestions;
+    splitWord(suggestions, word, candidate);
 
-    return suggestions;
+    if(trie != nullptr || index != nullptr)
+    {
+        for(const std::string& nearby : trie != nullptr ? trie->withinDistance(word, 1) : index->withinDistance(word, 1))
+        {
+            if(isAlphabetEdit(word, nearby))
+            {
+                suggestions.add(nearby);
+            }
+        }
+        return std::move(suggestions.list());
+    }
+
+    replaceAlphabet(suggestions, word, candidate);
+    addAlphabet(suggestions, word, candidate);
+    swapChars(suggestions, word, candidate);
+    deleteWord(suggestions, word, candidate);
+
+    return std::move(suggestions.list());
+}
+
+
+std::vector<std::string> WordChecker::findBestSuggestions(const std::string& word, unsigned int count) const
+{
+    std::vector<std::string> suggestions = findSuggestions(word);
+
+    // Keep the best count suggestions seen so far in a heap with the worst
+    // of them on top, so each of the rest only has to beat that one.
+    using Scored = std::pair<double, std::size_t>;
+    auto better = [](const Scored& a, const Scored& b)
+    {
+        return a.first > b.first || (a.first == b.first && a.second < b.second);
+    };
+
+    std::vector<Scored> best;
+    best.reserve(std::min<std::size_t>(count, suggestions.size()) + 1);
+    for(std::size_t i = 0; i < suggestions.size() && count > 0; i++)
+    {
+        Scored scored{score(word, suggestions[i]), i};
+        if(best.size() < count)
+        {
+            best.push_back(scored);
+            std::push_heap(best.begin(), best.end(), better);
+        }
+        else if(better(scored, best.front()))
+        {
+            std::pop_heap(best.begin(), best.end(), better);
+            best.back() = scored;
+            std::push_heap(best.begin(), best.end(), better);
+        }
+    }
+    std::sort_heap(best.begin(), best.end(), better);
+
+    std::vector<std::string> ranked;
+    ranked.reserve(best.size());
+    for(const Scored& scored : best)
+    {
+        ranked.push_back(std::move(suggestions[scored.second]));
+    }
+    return ranked;
 }
 
+
+void WordChecker::setFrequencies(FrequencyFunction frequencies)
+{
+    this->frequencies = std::move(frequencies);
+}
+
+
+// Works out which kind of typo the suggestion would fix from how it
+// differs from the word, and weighs how common the suggested word is by
+// how likely that kind of typo is.  A split is as common as the rarer of
+// its two words.
+double WordChecker::score(const std::string& word, const std::string& suggestion) const
+{
+    std::size_t space = suggestion.find(' ');
+    if(space != std::string::npos)
+    {
+        double frequency = 1.0;
+        if(frequencies)
+        {
+            frequency = std::min(frequencies(suggestion.substr(0, space)), frequencies(suggestion.substr(space + 1)));
+        }
+        return SPLIT_WEIGHT * frequency;
+    }
+
+    double weight;
+    if(suggestion.size() > word.size())
+    {
+        weight = INSERT_WEIGHT;
+    }
+    else if(suggestion.size() < word.size())
+    {
+        weight = DELETE_WEIGHT;
+    }
+    else
+    {
+        auto difference = std::mismatch(word.begin(), word.end(), suggestion.begin());
+        std::size_t i = difference.first - word.begin();
+        if(i == word.size())
+        {
+            weight = SAME_WEIGHT;
+        }
+        else if(i + 1 < word.size() && word[i] == suggestion[i + 1] && word[i + 1] == suggestion[i]
+            && std::equal(word.begin() + i + 2, word.end(), suggestion.begin() + i + 2))
+        {
+            weight = SWAP_WEIGHT;
+        }
+        else
+        {
+            weight = REPLACE_WEIGHT;
+        }
+    }
+
+    return weight * (frequencies ? frequencies(suggestion) : 1.0);
+}
+
+
+std::vector<WordCheck> WordChecker::checkWords(const std::vector<std::string>& words, unsigned int threadCount) const
+{
+    std::vector<WordCheck> checks;
+    std::unordered_map<std::string_view, std::size_t> seen;
+    for(const std::string& word : words)
+    {
+        auto found = seen.emplace(word, checks.size());
+        if(found.second)
+        {
+            checks.push_back(WordCheck{word, 1, false, {}});
+        }
+        else
+        {
+            checks[found.first->second].occurrences++;
+        }
+    }
+
+    if(threadCount == 0)
+    {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threadCount = std::min<std::size_t>(threadCount, checks.size() / CHECKS_PER_CLAIM + 1);
+
+    // Each thread repeatedly claims the next few words and fills in their
+    // WordChecks, which are already in their final order, so no thread
+    // ever touches another's results.
+    std::atomic<std::size_t> next{0};
+    std::exception_ptr failure;
+    std::mutex failure_mutex;
+
+    auto work = [&]()
+    {
+        try
+        {
+            for(std::size_t first = next.fetch_add(CHECKS_PER_CLAIM); first < checks.size();
+                first = next.fetch_add(CHECKS_PER_CLAIM))
+            {
+                std::size_t last = std::min(first + CHECKS_PER_CLAIM, checks.size());
+                for(std::size_t i = first; i < last; i++)
+                {
+                    checks[i].exists = wordExists(checks[i].word);
+                    if(!checks[i].exists)
+                    {
+                        checks[i].suggestions = findSuggestions(checks[i].word);
+                    }
+                }
+            }
+        }
+        catch(...)
+        {
+            // Claiming everything that's left stops the other threads.
+            next.store(checks.size());
+            std::lock_guard<std::mutex> lock{failure_mutex};
+            if(!failure)
+            {
+                failure = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for(unsigned int i = 1; i < threadCount; i++)
+    {
+        threads.emplace_back(work);
+    }
+    work();
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    if(failure)
+    {
+        std::rethrow_exception(failure);
+    }
+
+    return checks;
+}
+
+
+std::vector<WordCheck> WordChecker::checkWords(std::istream& in, unsigned int threadCount) const
+{
+    std::vector<std::string> words{std::istream_iterator<std::string>{in}, std::istream_iterator<std::string>{}};
+    return checkWords(words, threadCount);
+}
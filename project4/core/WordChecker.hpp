@@ -16,21 +16,79 @@
 #ifndef WORDCHECKER_HPP
 #define WORDCHECKER_HPP
 
+#include <functional>
+#include <istream>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "BloomFilter.hpp"
+#include "DeletionIndex.hpp"
 #include "Set.hpp"
+#include "SuggestionCache.hpp"
+#include "Trie.hpp"
+
+
+
+// A WordCheck is what WordChecker::checkWords() found out about one of
+// the distinct words it was given.
+struct WordCheck
+{
+    std::string word;
+
+    // The number of times the word appeared.
+    unsigned int occurrences;
+
+    bool exists;
+
+    // What findSuggestions() returns for the word, if it doesn't exist;
+    // otherwise, empty.
+    std::vector<std::string> suggestions;
+};
 
 
 
 class WordChecker
 {
+public:
+    // A FrequencyFunction returns how common the given word is, such as
+    // the number of times it appears in a large body of text; the larger,
+    // the more common.
+    using FrequencyFunction = std::function<double(const std::string&)>;
+
+    // A VersionFunction returns a number that changes whenever the words
+    // in the WordChecker's Set do, such as the Set's own version() (for
+    // the Sets in this directory that can change).
+    using VersionFunction = std::function<unsigned long long()>;
+
 public:
     // The constructor requires a Set of words to be passed into it.  The
     // WordChecker will store a reference to a const Set, which it will use
     // whenever it needs to look up a word.
     WordChecker(const Set<std::string>& words);
 
+    // This constructor also takes a BloomFilter that every word in the Set
+    // has been added to, which the WordChecker will also store a reference
+    // to.  Words that the filter rules out are never looked up in the Set,
+    // which is most of the candidates that findSuggestions() tries.
+    WordChecker(const Set<std::string>& words, const BloomFilter& filter);
+
+    // When the words are in a Trie, findSuggestions() searches the Trie
+    // for words one edit away (see Trie::withinDistance()) instead of
+    // trying every possible edit.  It keeps only the words that inserting
+    // or replacing one of the letters 'A' through 'Z' (or deleting or
+    // swapping letters) would make, so it finds the same suggestions, with
+    // the ones that aren't splits in alphabetical order.
+    WordChecker(const Trie& words);
+
+    // This constructor also takes a DeletionIndex (with a maxDistance of
+    // at least 1) of the same words as the Set, which the WordChecker will
+    // store a reference to.  findSuggestions() then asks the index for the
+    // words one edit away instead of trying every possible edit, keeping
+    // the same ones as with a Trie, so it finds the same suggestions, with
+    // the ones that aren't splits in alphabetical order.
+    WordChecker(const Set<std::string>& words, const DeletionIndex& index);
+
 
     // wordExists() returns true if the given word is spelled correctly,
     // false otherwise.
@@ -39,19 +97,79 @@ public:
 
     // findSuggestions() returns a vector containing suggested alternative
     // spellings for the given word, using the five algorithms described in
-    // the project write-up.
+    // the project write-up, each only once, in the order they're found.
     std::vector<std::string> findSuggestions(const std::string& word) const;
+
+    // findBestSuggestions() returns at most count of the suggestions that
+    // findSuggestions() finds, best first.  A suggestion's score is how
+    // common its word is (see setFrequencies(); otherwise, every word is
+    // equally common) times a weight for the kind of typo it would fix,
+    // from swapped letters (the likeliest) down to a missing space; ties
+    // go to the suggestion findSuggestions() lists first.
+    std::vector<std::string> findBestSuggestions(const std::string& word, unsigned int count) const;
+
+    // setFrequencies() gives findBestSuggestions() a function that says
+    // how common each word is.
+    void setFrequencies(FrequencyFunction frequencies);
+
+
+    // setCache() makes findSuggestions() remember what it finds in the
+    // given SuggestionCache, and look there first, until setCache() is
+    // called with nullptr.  The WordChecker stores a pointer to the cache,
+    // which can be shared by many WordCheckers with the same Set.  Entries
+    // are stamped with what the given VersionFunction returns, so the ones
+    // found before any change to the Set are never used after it.  If a
+    // cache is given without a VersionFunction, a std::invalid_argument is
+    // thrown.
+    void setCache(SuggestionCache* cache, VersionFunction version = nullptr);
+
+
+    // checkWords() checks a whole batch of words, such as every word in a
+    // document, at once.  Each distinct word is checked only once, no
+    // matter how many times it appears, and suggestions are found for the
+    // ones that don't exist.  The work is spread across the given number
+    // of threads (or, if it's 0, as many as the hardware supports), all
+    // sharing the WordChecker's Set, which must not change in the meantime.
+    //
+    // The result has one WordCheck per distinct word, in the order the
+    // words first appear, no matter how many threads there are.
+    std::vector<WordCheck> checkWords(const std::vector<std::string>& words, unsigned int threadCount = 0) const;
+
+    // This overload of checkWords() checks the words read from the given
+    // stream, separated by whitespace, until the end of the stream.
+    std::vector<WordCheck> checkWords(std::istream& in, unsigned int threadCount = 0) const;
     
 
 
 private:
-    const Set<std::string>& words;
+    // The number of words checkWords() hands a thread at a time.
+    static constexpr std::size_t CHECKS_PER_CLAIM = 16;
 
-    void swapChars(std::vector<std::string>& suggestions,  std::string word) const;
-    void deleteWord(std::vector<std::string>& suggestions,  std::string word) const;
-    void addAlphabet(std::vector<std::string>& suggestions,  std::string word) const;
-    void replaceAlphabet(std::vector<std::string>& suggestions,  std::string word) const;
-    void splitWord(std::vector<std::string>& suggestions,  std::string word) const;
+    const Set<std::string>& words;
+    const BloomFilter* filter;
+    const Trie* trie;
+    const DeletionIndex* index;
+    SuggestionCache* cache;
+    VersionFunction version;
+    FrequencyFunction frequencies;
+
+    // A SuggestionList collects suggestions, ignoring any it already has.
+    class SuggestionList;
+
+    std::vector<std::string> find_suggestions(const std::string& word) const;
+
+    double score(const std::string& word, const std::string& suggestion) const;
+
+    // Each of these tries one kind of candidate, building every candidate
+    // in place in the given buffer (which findSuggestions() reuses, so
+    // its capacity is allocated only once) rather than in a new string.
+    void swapChars(SuggestionList& suggestions, const std::string& word, std::string& candidate) const;
+    void deleteWord(SuggestionList& suggestions, const std::string& word, std::string& candidate) const;
+    void addAlphabet(SuggestionList& suggestions, const std::string& word, std::string& candidate) const;
+    void replaceAlphabet(SuggestionList& suggestions, const std::string& word, std::string& candidate) const;
+    void splitWord(SuggestionList& suggestions, const std::string& word, std::string& candidate) const;
+
+    bool partExists(std::string_view part, std::string& candidate) const;
 };
 
 
@@ -0,0 +1,108 @@
+// AllocationCounting.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Replaces the global operator new and operator delete for the benchmark
+// program, so benchmarks can count how many heap allocations they cause,
+// and how many bytes those allocations asked for.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include "Benchmarks.hpp"
+
+
+namespace
+{
+    std::atomic<unsigned long long> allocations{0};
+    std::atomic<unsigned long long> bytes{0};
+
+    void* allocate(std::size_t size, std::size_t alignment)
+    {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        bytes.fetch_add(size, std::memory_order_relaxed);
+        void* p = alignment <= alignof(std::max_align_t)
+            ? std::malloc(size == 0 ? 1 : size)
+            : std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+        if (p == nullptr)
+        {
+            throw std::bad_alloc{};
+        }
+        return p;
+    }
+}
+
+
+unsigned long long benchmarks::allocationCount()
+{
+    return allocations.load(std::memory_order_relaxed);
+}
+
+
+unsigned long long benchmarks::allocatedBytes()
+{
+    return bytes.load(std::memory_order_relaxed);
+}
+
+
+void* operator new(std::size_t size)
+{
+    return allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size)
+{
+    return allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept
+{
+    std::free(p);
+}
@@ -0,0 +1,89 @@
+// BatchCheckBenchmarks.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Measures how many words per second WordChecker can check in a large
+// document, one word at a time (the way the shell does it) and with
+// checkWords() on increasing numbers of threads.  The document is made
+// like real text: a few words appear very often and most rarely (with
+// frequencies following Zipf's law), and about 3% are misspelled.
+
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Benchmarks.hpp"
+#include "BloomFilter.hpp"
+#include "HashFunctions.hpp"
+#include "HashSet.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    std::vector<std::string> makeDocument(const std::vector<std::string>& vocabulary, unsigned int length)
+    {
+        std::vector<double> weights;
+        for (std::size_t rank = 1; rank <= vocabulary.size(); ++rank)
+        {
+            weights.push_back(1.0 / rank);
+        }
+
+        std::default_random_engine engine{46};
+        std::discrete_distribution<std::size_t> word{weights.begin(), weights.end()};
+        std::bernoulli_distribution misspelled{0.03};
+        std::uniform_int_distribution<int> letter{'A', 'Z'};
+
+        std::vector<std::string> document;
+        document.reserve(length);
+        for (unsigned int i = 0; i < length; ++i)
+        {
+            document.push_back(vocabulary[word(engine)]);
+            if (misspelled(engine))
+            {
+                std::string& typo = document.back();
+                typo[std::uniform_int_distribution<std::size_t>{0, typo.size() - 1}(engine)] = letter(engine);
+            }
+        }
+        return document;
+    }
+}
+
+
+void benchmarks::batchSpellCheck()
+{
+    std::vector<std::string> words = loadWords(250000);
+    std::vector<std::string> vocabulary(words.begin(), words.begin() + 50000);
+    std::vector<std::string> document = makeDocument(vocabulary, 2000000);
+
+    HashSet<std::string> hashSet{words.begin(), words.end(), hashing::wyhashString};
+    BloomFilter filter{words};
+    WordChecker checker{hashSet, filter};
+
+    unsigned long long suggestions = 0;
+    double ms = timeMilliseconds([&]()
+    {
+        for (const std::string& word : document)
+        {
+            if (not checker.wordExists(word))
+            {
+                suggestions += checker.findSuggestions(word).size();
+            }
+        }
+    });
+    std::cout << "  " << document.size() << " words, " << std::thread::hardware_concurrency()
+        << " hardware threads" << std::endl;
+    std::cout << "  One word at a time: " << document.size() / ms * 1000.0 << " words/s" << std::endl;
+
+    for (unsigned int threadCount : {1u, 2u, 4u, 8u})
+    {
+        std::size_t distinct = 0;
+        ms = timeMilliseconds([&]()
+        {
+            distinct = checker.checkWords(document, threadCount).size();
+        });
+        std::cout << "  checkWords() on " << threadCount << " thread(s): "
+            << document.size() / ms * 1000.0 << " words/s (" << distinct << " distinct)" << std::endl;
+    }
+}
@@ -0,0 +1,151 @@
+// Benchmarks.hpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Shared helpers for the benchmarks in the "exp" directory.  Each
+// benchmark is a function declared at the bottom of this file and
+// defined in its own source file; expmain.cpp runs them by name.
+//
+// Benchmarks that need a dictionary read words.txt from the current
+// directory if there is one (one word per line), otherwise they make
+// up random uppercase words with a realistic spread of lengths.
+
+#ifndef BENCHMARKS_HPP
+#define BENCHMARKS_HPP
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+
+
+namespace benchmarks
+{
+    // Returns count distinct uppercase words, from words.txt if it has
+    // enough, otherwise made up from the given seed.
+    inline std::vector<std::string> loadWords(unsigned int count, unsigned int seed = 46)
+    {
+        std::vector<std::string> words;
+        std::unordered_set<std::string> seen;
+
+        std::ifstream in{"words.txt"};
+        std::string line;
+        while (words.size() < count && std::getline(in, line))
+        {
+            std::transform(line.begin(), line.end(), line.begin(), ::toupper);
+            if (not line.empty() && seen.insert(line).second)
+            {
+                words.push_back(line);
+            }
+        }
+
+        std::default_random_engine engine{seed};
+        std::binomial_distribution<int> length{14, 0.55};
+        std::uniform_int_distribution<int> letter{'A', 'Z'};
+        while (words.size() < count)
+        {
+            std::string word(std::max(2, length(engine)), ' ');
+            for (char& c : word)
+            {
+                c = letter(engine);
+            }
+            if (seen.insert(word).second)
+            {
+                words.push_back(word);
+            }
+        }
+        return words;
+    }
+
+
+    // Returns a copy of the given words with one random letter changed
+    // in each, which is what a stream of typos looks like.
+    inline std::vector<std::string> misspell(std::vector<std::string> words, unsigned int seed = 64)
+    {
+        std::default_random_engine engine{seed};
+        std::uniform_int_distribution<int> letter{'A', 'Z'};
+        for (std::string& word : words)
+        {
+            std::uniform_int_distribution<std::size_t> position{0, word.size() - 1};
+            word[position(engine)] = letter(engine);
+        }
+        return words;
+    }
+
+
+    // Runs the given function once and returns how long it took.
+    template <typename Function>
+    double timeMilliseconds(Function f)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+
+    inline void report(const std::string& label, double milliseconds, unsigned int operations)
+    {
+        std::cout << "  " << label << ": " << milliseconds << " ms ("
+            << (milliseconds * 1e6 / std::max(operations, 1u)) << " ns/op)" << std::endl;
+    }
+
+
+    // Simple hash functions of the kind used to test HashSet.
+    inline unsigned int polynomialHash(const std::string& s)
+    {
+        unsigned int hash = 0;
+        for (char c : s)
+        {
+            hash = hash * 31 + static_cast<unsigned char>(c);
+        }
+        return hash;
+    }
+
+    inline unsigned int identityHash(const int& i)
+    {
+        return i;
+    }
+
+
+    // allocationCount() returns how many times operator new has been
+    // called so far in this program (see AllocationCounting.cpp), and
+    // allocatedBytes() the total number of bytes it was asked for.
+    unsigned long long allocationCount();
+    unsigned long long allocatedBytes();
+
+
+    void hashSetLayouts();
+    void hashSetInsertLatency();
+    void setInsertionAllocations();
+    void hashSetNodeAllocation();
+    void hashQuality();
+    void concurrentHashSetThroughput();
+    void hashSetBulkLoad();
+    void frozenStringSetSuggestions();
+    void bloomFilterSuggestions();
+    void wordCheckerCandidates();
+    void trieSuggestions();
+    void deletionIndexSuggestions();
+    void batchSpellCheck();
+    void suggestionCacheHitRates();
+    void rankedSuggestions();
+    void simdStringLookups();
+    void skipListLayouts();
+    void skipListBulkInsert();
+    void concurrentSkipListThroughput();
+    void orderedRangeQueries();
+    void orderedBulkLoad();
+    void mixedSetWorkloads();
+}
+
+
+
+#endif
@@ -0,0 +1,81 @@
+// BloomFilterBenchmarks.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Measures how many misspelled words per second findSuggestions() can
+// handle with and without a BloomFilter in front of the dictionary, for
+// the kinds of Set that can hold a full-sized dictionary, along with the
+// filter's size and its measured false positive rate.
+
+#include <string>
+#include <vector>
+#include "AVLSet.hpp"
+#include "Benchmarks.hpp"
+#include "BloomFilter.hpp"
+#include "FrozenStringSet.hpp"
+#include "HashFunctions.hpp"
+#include "HashSet.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    double suggestionsPerSecond(const WordChecker& checker, const std::vector<std::string>& typos)
+    {
+        unsigned int suggestions = 0;
+        double ms = benchmarks::timeMilliseconds([&]()
+        {
+            for (const std::string& typo : typos)
+            {
+                suggestions += checker.findSuggestions(typo).size();
+            }
+        });
+        return typos.size() / ms * 1000.0;
+    }
+
+
+    void run(const std::string& label, const Set<std::string>& words, const BloomFilter& filter,
+        const std::vector<std::string>& typos)
+    {
+        double without = suggestionsPerSecond(WordChecker{words}, typos);
+        double with = suggestionsPerSecond(WordChecker{words, filter}, typos);
+        std::cout << "  " << label << ": " << without << " words/s without the filter, "
+            << with << " with it" << std::endl;
+    }
+}
+
+
+void benchmarks::bloomFilterSuggestions()
+{
+    const unsigned int count = 250000;
+    std::vector<std::string> all = loadWords(count * 2);
+    std::vector<std::string> words(all.begin(), all.begin() + count);
+    std::vector<std::string> absent(all.begin() + count, all.end());
+    std::vector<std::string> typos = misspell(loadWords(2000, 99));
+
+    for (double bitsPerWord : {8.0, 10.0, 16.0})
+    {
+        BloomFilter filter{words, bitsPerWord};
+        unsigned int falsePositives = 0;
+        for (const std::string& word : absent)
+        {
+            falsePositives += filter.mightContain(word);
+        }
+        std::cout << "  " << bitsPerWord << " bits per word: " << filter.sizeInBytes() << " bytes, "
+            << 100.0 * falsePositives / absent.size() << "% false positives" << std::endl;
+    }
+
+    BloomFilter filter{words};
+    HashSet<std::string> hashSet{words.begin(), words.end(), hashing::wyhashString};
+    run("HashSet", hashSet, filter, typos);
+
+    AVLSet<std::string> avlSet;
+    for (const std::string& word : words)
+    {
+        avlSet.add(word);
+    }
+    run("AVLSet", avlSet, filter, typos);
+
+    run("FrozenStringSet", FrozenStringSet{words}, filter, typos);
+}
@@ -0,0 +1,142 @@
+// ConcurrentHashSetBenchmarks.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Measures the throughput of a shared dictionary at 1 to 64 threads, with
+// mixes of lookups and adds ranging from read-only to half adds.  The
+// dictionary starts with 100,000 words; half of the lookups are for words
+// in it and half are for misspellings.  Adds are of new words, divided
+// among the threads ahead of time.
+//
+// ConcurrentHashSet is compared with a HashSet behind a std::shared_mutex,
+// which is the simplest way to share a HashSet safely.  The number of
+// hardware threads is printed first, since results beyond it mostly show
+// the cost of oversubscription.
+
+#include <atomic>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Benchmarks.hpp"
+#include "ConcurrentHashSet.hpp"
+#include "HashFunctions.hpp"
+#include "HashSet.hpp"
+
+
+namespace
+{
+    class LockedHashSet
+    {
+    public:
+        LockedHashSet()
+            : s{hashing::wyhashString}
+        {
+        }
+
+        void add(const std::string& word)
+        {
+            std::unique_lock<std::shared_mutex> lock{mutex};
+            s.add(word);
+        }
+
+        bool contains(const std::string& word) const
+        {
+            std::shared_lock<std::shared_mutex> lock{mutex};
+            return s.contains(word);
+        }
+
+    private:
+        mutable std::shared_mutex mutex;
+        HashSet<std::string> s;
+    };
+
+
+    const unsigned int INITIAL_WORDS = 100000;
+    const unsigned int TOTAL_OPERATIONS = 2000000;
+
+
+    template <typename SetType>
+    double run(unsigned int threadCount, double writeFraction, const std::vector<std::string>& words,
+        const std::vector<std::string>& typos)
+    {
+        SetType s;
+        for (unsigned int i = 0; i < INITIAL_WORDS; ++i)
+        {
+            s.add(words[i]);
+        }
+
+        unsigned int operationsPerThread = TOTAL_OPERATIONS / threadCount;
+        unsigned int newWordsPerThread = (words.size() - INITIAL_WORDS) / threadCount;
+        std::atomic<unsigned int> found{0};
+
+        double ms = benchmarks::timeMilliseconds([&]()
+        {
+            std::vector<std::thread> threads;
+            for (unsigned int t = 0; t < threadCount; ++t)
+            {
+                threads.emplace_back([&, t]()
+                {
+                    std::default_random_engine engine{t};
+                    std::uniform_real_distribution<double> kind{0.0, 1.0};
+                    std::uniform_int_distribution<unsigned int> which{0, INITIAL_WORDS - 1};
+                    unsigned int nextWord = INITIAL_WORDS + t * newWordsPerThread;
+                    unsigned int endWord = nextWord + newWordsPerThread;
+                    unsigned int hits = 0;
+
+                    for (unsigned int i = 0; i < operationsPerThread; ++i)
+                    {
+                        if (kind(engine) < writeFraction && nextWord < endWord)
+                        {
+                            s.add(words[nextWord++]);
+                        }
+                        else
+                        {
+                            unsigned int w = which(engine);
+                            hits += s.contains(i % 2 == 0 ? words[w] : typos[w]);
+                        }
+                    }
+                    found += hits;
+                });
+            }
+            for (std::thread& thread : threads)
+            {
+                thread.join();
+            }
+        });
+
+        return TOTAL_OPERATIONS / ms / 1000.0;
+    }
+
+
+    struct ConcurrentDictionary : ConcurrentHashSet<std::string>
+    {
+        ConcurrentDictionary()
+            : ConcurrentHashSet<std::string>{hashing::wyhashString}
+        {
+        }
+    };
+}
+
+
+void benchmarks::concurrentHashSetThroughput()
+{
+    std::vector<std::string> words = loadWords(INITIAL_WORDS + TOTAL_OPERATIONS / 2);
+    std::vector<std::string> typos = misspell(std::vector<std::string>(words.begin(), words.begin() + INITIAL_WORDS));
+
+    std::cout << "  " << std::thread::hardware_concurrency() << " hardware threads" << std::endl;
+    for (double writeFraction : {0.0, 0.01, 0.1, 0.5})
+    {
+        std::cout << "  " << writeFraction * 100 << "% adds (millions of operations per second)" << std::endl;
+        for (unsigned int threadCount : {1, 2, 4, 8, 16, 32, 64})
+        {
+            double concurrent = run<ConcurrentDictionary>(threadCount, writeFraction, words, typos);
+            double locked = run<LockedHashSet>(threadCount, writeFraction, words, typos);
+            std::cout << "    " << threadCount << " threads: ConcurrentHashSet " << concurrent
+                << ", HashSet with shared_mutex " << locked << std::endl;
+        }
+    }
+}
@@ -0,0 +1,144 @@
+// ConcurrentSkipListSetBenchmarks.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Measures the throughput of a shared ordered dictionary at 1 to 16
+// threads, as concurrentHashSetThroughput does for the hash tables.  The
+// dictionary starts with 100,000 words; half of the lookups are for words
+// in it and half are for misspellings.  Adds are of new words, divided
+// among the threads ahead of time.
+//
+// ConcurrentSkipListSet is compared with an AVLSet behind a
+// std::shared_mutex.  AVLSet can't remove elements, so the last mix, in
+// which each thread also removes the words it added, oldest first, is
+// measured for ConcurrentSkipListSet alone.
+
+#include <atomic>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "AVLSet.hpp"
+#include "Benchmarks.hpp"
+#include "ConcurrentSkipListSet.hpp"
+
+
+namespace
+{
+    class LockedAVLSet
+    {
+    public:
+        void add(const std::string& word)
+        {
+            std::unique_lock<std::shared_mutex> lock{mutex};
+            s.add(word);
+        }
+
+        bool contains(const std::string& word) const
+        {
+            std::shared_lock<std::shared_mutex> lock{mutex};
+            return s.contains(word);
+        }
+
+    private:
+        mutable std::shared_mutex mutex;
+        AVLSet<std::string> s;
+    };
+
+
+    const unsigned int INITIAL_WORDS = 100000;
+    const unsigned int TOTAL_OPERATIONS = 1000000;
+
+
+    template <typename SetType>
+    double run(unsigned int threadCount, double addFraction, double removeFraction,
+        const std::vector<std::string>& words, const std::vector<std::string>& typos)
+    {
+        SetType s;
+        for (unsigned int i = 0; i < INITIAL_WORDS; ++i)
+        {
+            s.add(words[i]);
+        }
+
+        unsigned int operationsPerThread = TOTAL_OPERATIONS / threadCount;
+        unsigned int newWordsPerThread = (words.size() - INITIAL_WORDS) / threadCount;
+        std::atomic<unsigned int> found{0};
+
+        double ms = benchmarks::timeMilliseconds([&]()
+        {
+            std::vector<std::thread> threads;
+            for (unsigned int t = 0; t < threadCount; ++t)
+            {
+                threads.emplace_back([&, t]()
+                {
+                    std::default_random_engine engine{t};
+                    std::uniform_real_distribution<double> kind{0.0, 1.0};
+                    std::uniform_int_distribution<unsigned int> which{0, INITIAL_WORDS - 1};
+                    unsigned int oldestWord = INITIAL_WORDS + t * newWordsPerThread;
+                    unsigned int nextWord = oldestWord;
+                    unsigned int endWord = nextWord + newWordsPerThread;
+                    unsigned int hits = 0;
+
+                    for (unsigned int i = 0; i < operationsPerThread; ++i)
+                    {
+                        double k = kind(engine);
+                        if (k < addFraction && nextWord < endWord)
+                        {
+                            s.add(words[nextWord++]);
+                        }
+                        else if (k < addFraction + removeFraction && oldestWord < nextWord)
+                        {
+                            if constexpr (not std::is_same_v<SetType, LockedAVLSet>)
+                            {
+                                s.remove(words[oldestWord++]);
+                            }
+                        }
+                        else
+                        {
+                            unsigned int w = which(engine);
+                            hits += s.contains(i % 2 == 0 ? words[w] : typos[w]);
+                        }
+                    }
+                    found += hits;
+                });
+            }
+            for (std::thread& thread : threads)
+            {
+                thread.join();
+            }
+        });
+
+        return TOTAL_OPERATIONS / ms / 1000.0;
+    }
+}
+
+
+void benchmarks::concurrentSkipListThroughput()
+{
+    std::vector<std::string> words = loadWords(INITIAL_WORDS + TOTAL_OPERATIONS / 2);
+    std::vector<std::string> typos = misspell(std::vector<std::string>(words.begin(), words.begin() + INITIAL_WORDS));
+
+    std::cout << "  " << std::thread::hardware_concurrency() << " hardware threads" << std::endl;
+    for (double addFraction : {0.0, 0.1, 0.5})
+    {
+        std::cout << "  " << addFraction * 100 << "% adds (millions of operations per second)" << std::endl;
+        for (unsigned int threadCount : {1, 2, 4, 8, 16})
+        {
+            double concurrent = run<ConcurrentSkipListSet<std::string>>(threadCount, addFraction, 0.0, words, typos);
+            double locked = run<LockedAVLSet>(threadCount, addFraction, 0.0, words, typos);
+            std::cout << "    " << threadCount << " threads: ConcurrentSkipListSet " << concurrent
+                << ", AVLSet with shared_mutex " << locked << std::endl;
+        }
+    }
+
+    std::cout << "  25% adds, 25% removes (millions of operations per second)" << std::endl;
+    for (unsigned int threadCount : {1, 2, 4, 8, 16})
+    {
+        double concurrent = run<ConcurrentSkipListSet<std::string>>(threadCount, 0.25, 0.25, words, typos);
+        std::cout << "    " << threadCount << " threads: ConcurrentSkipListSet " << concurrent << std::endl;
+    }
+}
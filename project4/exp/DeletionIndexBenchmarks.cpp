@@ -0,0 +1,86 @@
+// DeletionIndexBenchmarks.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Measures how long a DeletionIndex takes to build and how much memory it
+// takes, at distances 1 and 2, and compares findSuggestions() with one
+// against the other ways of finding the words one edit away, by average
+// and worst-case time per misspelled word.
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "Benchmarks.hpp"
+#include "BloomFilter.hpp"
+#include "DeletionIndex.hpp"
+#include "HashFunctions.hpp"
+#include "HashSet.hpp"
+#include "Trie.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    void run(const std::string& label, const WordChecker& checker, const std::vector<std::string>& typos)
+    {
+        double slowest = 0.0;
+        double total = 0.0;
+        for (const std::string& typo : typos)
+        {
+            double ms = benchmarks::timeMilliseconds([&]()
+            {
+                checker.findSuggestions(typo);
+            });
+            total += ms;
+            slowest = std::max(slowest, ms);
+        }
+
+        std::cout << "  " << label << ": " << total * 1000.0 / typos.size() << " us/word on average, "
+            << slowest * 1000.0 << " us at worst" << std::endl;
+    }
+}
+
+
+void benchmarks::deletionIndexSuggestions()
+{
+    const unsigned int count = 250000;
+    std::vector<std::string> words = loadWords(count);
+    std::vector<std::string> typos = misspell(loadWords(5000, 99));
+
+    HashSet<std::string> hashSet{words.begin(), words.end(), hashing::wyhashString};
+    BloomFilter filter{words};
+    Trie trie{words};
+
+    for (unsigned int maxDistance : {1u, 2u})
+    {
+        unsigned long long found = 0;
+        double build = 0.0;
+        double search = 0.0;
+        {
+            std::vector<DeletionIndex> index;
+            build = timeMilliseconds([&]()
+            {
+                index.emplace_back(words, maxDistance);
+            });
+            search = timeMilliseconds([&]()
+            {
+                for (const std::string& typo : typos)
+                {
+                    found += index[0].withinDistance(typo, maxDistance).size();
+                }
+            });
+
+            std::cout << "  Distance " << maxDistance << ": built in " << build << " ms, "
+                << index[0].sizeInBytes() / 1048576.0 << " MB, "
+                << search * 1000.0 / typos.size() << " us/word to search" << std::endl;
+        }
+    }
+
+    DeletionIndex index{words};
+    run("HashSet", WordChecker{hashSet}, typos);
+    run("HashSet with a BloomFilter", WordChecker{hashSet, filter}, typos);
+    run("Trie", WordChecker{trie}, typos);
+    run("HashSet with a DeletionIndex", WordChecker{hashSet, index}, typos);
+}
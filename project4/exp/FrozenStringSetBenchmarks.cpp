@@ -0,0 +1,105 @@
+// FrozenStringSetBenchmarks.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Compares FrozenStringSet with the other Sets on what WordChecker does
+// most: findSuggestions() on misspelled words, each of which makes a few
+// hundred lookups, nearly all of them misses.  Also times building a
+// FrozenStringSet, saving it, and loading it back, which only maps the
+// file.
+//
+// Every Set is run on a 20,000-word dictionary, then on a 250,000-word
+// one.
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "AVLSet.hpp"
+#include "Benchmarks.hpp"
+#include "FrozenStringSet.hpp"
+#include "HashFunctions.hpp"
+#include "HashSet.hpp"
+#include "SkipListSet.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    void runSuggestions(const std::string& label, const Set<std::string>& words,
+        const std::vector<std::string>& typos)
+    {
+        WordChecker checker{words};
+        unsigned int suggestions = 0;
+        double ms = benchmarks::timeMilliseconds([&]()
+        {
+            for (const std::string& typo : typos)
+            {
+                suggestions += checker.findSuggestions(typo).size();
+            }
+        });
+        benchmarks::report(label + " findSuggestions", ms, typos.size());
+    }
+
+
+    template <typename SetType>
+    void loadAndRun(const std::string& label, SetType s, const std::vector<std::string>& words,
+        const std::vector<std::string>& typos)
+    {
+        double ms = benchmarks::timeMilliseconds([&]()
+        {
+            for (const std::string& word : words)
+            {
+                s.add(word);
+            }
+        });
+        benchmarks::report(label + " load", ms, words.size());
+        runSuggestions(label, s, typos);
+    }
+
+
+    void runFrozen(const std::vector<std::string>& words, const std::vector<std::string>& typos)
+    {
+        const std::string path = "FrozenStringSetBenchmark.fss";
+
+        FrozenStringSet* built = nullptr;
+        double ms = benchmarks::timeMilliseconds([&]()
+        {
+            built = new FrozenStringSet{words};
+        });
+        benchmarks::report("FrozenStringSet build", ms, words.size());
+
+        ms = benchmarks::timeMilliseconds([&]()
+        {
+            built->save(path);
+        });
+        benchmarks::report("FrozenStringSet save", ms, words.size());
+        delete built;
+
+        FrozenStringSet loaded{std::vector<std::string>{}};
+        ms = benchmarks::timeMilliseconds([&]()
+        {
+            loaded = FrozenStringSet::load(path);
+        });
+        benchmarks::report("FrozenStringSet load (mapped)", ms, words.size());
+
+        runSuggestions("FrozenStringSet", loaded, typos);
+        std::remove(path.c_str());
+    }
+}
+
+
+void benchmarks::frozenStringSetSuggestions()
+{
+    std::vector<std::string> typos = misspell(loadWords(2000, 99));
+
+    for (unsigned int count : {20000u, 250000u})
+    {
+        std::vector<std::string> words = loadWords(count);
+        std::cout << "  " << count << " words" << std::endl;
+        loadAndRun("HashSet", HashSet<std::string>{hashing::wyhashString}, words, typos);
+        loadAndRun("AVLSet", AVLSet<std::string>{}, words, typos);
+        loadAndRun("SkipListSet", SkipListSet<std::string>{}, words, typos);
+        runFrozen(words, typos);
+    }
+}
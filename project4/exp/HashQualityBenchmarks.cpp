@@ -0,0 +1,81 @@
+// HashQualityBenchmarks.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Compares the simple hash functions used to test HashSet with the
+// ready-made ones in HashFunctions.hpp, reporting time along with what
+// HashSet's statistics() say about how evenly each one spreads elements
+// out.  The ints are multiples of 1024, a pattern that's common in real
+// data.  Because HashSet's capacities are odd, such strides don't pile
+// up at a few indices even when each int is its own hash, and sequential
+// ints even land at neighboring indices, so identityHash is the baseline
+// that mixInt should come close to rather than beat.
+
+#include <string>
+#include <vector>
+#include "Benchmarks.hpp"
+#include "HashFunctions.hpp"
+#include "HashSet.hpp"
+
+
+namespace
+{
+    template <typename ElementType, typename HashFunction>
+    void run(const std::string& label, HashFunction hashFunction, const std::vector<ElementType>& present,
+        const std::vector<ElementType>& absent)
+    {
+        std::cout << label << std::endl;
+
+        HashSet<ElementType, ElementType, NodePool, CountLookups> s{hashFunction};
+        double ms = benchmarks::timeMilliseconds([&]()
+        {
+            for (const ElementType& e : present)
+            {
+                s.add(e);
+            }
+        });
+        benchmarks::report("insert", ms, present.size());
+
+        ms = benchmarks::timeMilliseconds([&]()
+        {
+            for (unsigned int i = 0; i < present.size(); ++i)
+            {
+                s.contains(present[i]);
+                s.contains(absent[i]);
+            }
+        });
+        benchmarks::report("lookup", ms, present.size() * 2);
+
+        HashSetStatistics stats = s.statistics();
+        std::cout << "  load factor " << stats.loadFactor
+            << ", max chain " << stats.maxChainLength
+            << ", empty lists " << stats.chainLengthCounts[0] << " of " << stats.capacity << std::endl;
+        std::cout << "  probes per hit " << stats.averageProbesPerHit()
+            << ", per miss " << stats.averageProbesPerMiss() << std::endl;
+        std::cout << "  " << stats.resizeCount << " resizes took " << stats.resizeMilliseconds << " ms" << std::endl;
+    }
+}
+
+
+void benchmarks::hashQuality()
+{
+    const unsigned int count = 200000;
+
+    std::vector<std::string> words = loadWords(count * 2);
+    std::vector<std::string> present(words.begin(), words.begin() + count);
+    std::vector<std::string> absent(words.begin() + count, words.end());
+    run("polynomialHash", polynomialHash, present, absent);
+    run("hashing::wyhashString", hashing::wyhashString, present, absent);
+    run("hashing::xxhashString", hashing::xxhashString, present, absent);
+
+    std::vector<int> numbers;
+    std::vector<int> missing;
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        numbers.push_back(i * 1024);
+        missing.push_back(i * 1024 + 512);
+    }
+    run("identityHash", identityHash, numbers, missing);
+    run("hashing::mixInt", hashing::mixInt, numbers, missing);
+}
@@ -0,0 +1,105 @@
+// HashSetBulkLoadBenchmarks.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Times loading dictionaries of realistic sizes into a HashSet: one add()
+// at a time, with reserve() first, with addAll() and with the range
+// constructor.  Then times lookups before and after shrink_to_fit(),
+// starting from a set that reserved twice the room it needed.
+
+#include <string>
+#include <vector>
+#include "Benchmarks.hpp"
+#include "HashFunctions.hpp"
+#include "HashSet.hpp"
+
+
+namespace
+{
+    void reportLoad(const std::string& label, double ms, const HashSet<std::string>& s)
+    {
+        HashSetStatistics stats = s.statistics();
+        benchmarks::report(label, ms, s.size());
+        std::cout << "    " << stats.resizeCount << " resizes, capacity " << stats.capacity << std::endl;
+    }
+
+
+    double timeLookups(const HashSet<std::string>& s, const std::vector<std::string>& words,
+        const std::vector<std::string>& typos)
+    {
+        unsigned int found = 0;
+        double ms = benchmarks::timeMilliseconds([&]()
+        {
+            for (unsigned int i = 0; i < words.size(); ++i)
+            {
+                found += s.contains(words[i]);
+                found += s.contains(typos[i]);
+            }
+        });
+        if (found < words.size())
+        {
+            std::cout << "  (lookups found " << found << " of at least " << words.size() << ")" << std::endl;
+        }
+        return ms;
+    }
+}
+
+
+void benchmarks::hashSetBulkLoad()
+{
+    for (unsigned int count : {50000, 250000, 500000})
+    {
+        std::vector<std::string> words = loadWords(count);
+        std::vector<std::string> typos = misspell(words);
+        std::cout << "  " << count << " words" << std::endl;
+
+        {
+            HashSet<std::string> s{hashing::wyhashString};
+            double ms = timeMilliseconds([&]()
+            {
+                for (const std::string& word : words)
+                {
+                    s.add(word);
+                }
+            });
+            reportLoad("add()", ms, s);
+        }
+        {
+            HashSet<std::string> s{hashing::wyhashString};
+            double ms = timeMilliseconds([&]()
+            {
+                s.reserve(words.size());
+                for (const std::string& word : words)
+                {
+                    s.add(word);
+                }
+            });
+            reportLoad("reserve() then add()", ms, s);
+        }
+        {
+            HashSet<std::string> s{hashing::wyhashString};
+            double ms = timeMilliseconds([&]()
+            {
+                s.addAll(words.begin(), words.end());
+            });
+            reportLoad("addAll()", ms, s);
+        }
+
+        HashSet<std::string> s{hashing::wyhashString};
+        double ms = timeMilliseconds([&]()
+        {
+            s = HashSet<std::string>{words.begin(), words.end(), hashing::wyhashString};
+        });
+        reportLoad("range constructor", ms, s);
+
+        s.reserve(words.size() * 2);
+        report("lookup with room for twice as many", timeLookups(s, words, typos), words.size() * 2);
+        ms = timeMilliseconds([&]()
+        {
+            s.shrink_to_fit();
+        });
+        report("shrink_to_fit()", ms, words.size());
+        report("lookup after shrink_to_fit()", timeLookups(s, words, typos), words.size() * 2);
+    }
+}
@@ -0,0 +1,50 @@
+// HashSetLatencyBenchmarks.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Times every individual add() while loading a dictionary and reports the
+// latency percentiles.  HashSet spreads each resize over later calls to
+// add(); FlatHashSet, which resizes all at once, is shown for contrast.
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "Benchmarks.hpp"
+#include "FlatHashSet.hpp"
+#include "HashSet.hpp"
+
+
+namespace
+{
+    template <typename SetType>
+    void run(const std::string& label, SetType s, const std::vector<std::string>& words)
+    {
+        std::vector<double> latencies;
+        latencies.reserve(words.size());
+        for (const std::string& word : words)
+        {
+            auto start = std::chrono::steady_clock::now();
+            s.add(word);
+            auto end = std::chrono::steady_clock::now();
+            latencies.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+        }
+        std::sort(latencies.begin(), latencies.end());
+
+        auto percentile = [&](double p)
+        {
+            return latencies[std::min(latencies.size() - 1, static_cast<std::size_t>(p * latencies.size()))];
+        };
+        std::cout << "  " << label << ": p50 " << percentile(0.5) << " us, p99 " << percentile(0.99)
+            << " us, p99.9 " << percentile(0.999) << " us, max " << latencies.back() << " us" << std::endl;
+    }
+}
+
+
+void benchmarks::hashSetInsertLatency()
+{
+    std::vector<std::string> words = loadWords(500000);
+    run("HashSet<std::string>", HashSet<std::string>{polynomialHash}, words);
+    run("FlatHashSet<std::string>", FlatHashSet<std::string>{polynomialHash}, words);
+}
@@ -0,0 +1,74 @@
+// HashSetLayoutBenchmarks.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Compares the insert and lookup throughput of the separately-chained
+// HashSet and the open-addressing FlatHashSet, for std::string and int
+// keys.  Half of the lookups hit and half miss.
+
+#include <string>
+#include <vector>
+#include "Benchmarks.hpp"
+#include "FlatHashSet.hpp"
+#include "HashSet.hpp"
+
+
+namespace
+{
+    template <typename SetType, typename ElementType>
+    void run(const std::string& label, SetType s, const std::vector<ElementType>& present,
+        const std::vector<ElementType>& absent)
+    {
+        std::cout << label << std::endl;
+
+        double ms = benchmarks::timeMilliseconds([&]()
+        {
+            for (const ElementType& e : present)
+            {
+                s.add(e);
+            }
+        });
+        benchmarks::report("insert", ms, present.size());
+
+        unsigned int found = 0;
+        ms = benchmarks::timeMilliseconds([&]()
+        {
+            for (unsigned int i = 0; i < present.size(); ++i)
+            {
+                found += s.contains(present[i]);
+                found += s.contains(absent[i]);
+            }
+        });
+        benchmarks::report("lookup", ms, present.size() * 2);
+
+        if (found != present.size())
+        {
+            std::cout << "  (lookups found " << found << " of " << present.size() << ")" << std::endl;
+        }
+    }
+}
+
+
+void benchmarks::hashSetLayouts()
+{
+    const unsigned int count = 200000;
+
+    std::vector<std::string> words = loadWords(count * 2);
+    std::vector<std::string> present(words.begin(), words.begin() + count);
+    std::vector<std::string> absent(words.begin() + count, words.end());
+    run("HashSet<std::string>", HashSet<std::string>{polynomialHash}, present, absent);
+    run("FlatHashSet<std::string>", FlatHashSet<std::string>{polynomialHash}, present, absent);
+
+    std::vector<int> numbers;
+    std::vector<int> missing;
+    std::default_random_engine engine{46};
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        numbers.push_back(i * 2);
+        missing.push_back(i * 2 + 1);
+    }
+    std::shuffle(numbers.begin(), numbers.end(), engine);
+    run("HashSet<int>", HashSet<int>{identityHash}, numbers, missing);
+    run("FlatHashSet<int>", FlatHashSet<int>{identityHash}, numbers, missing);
+}
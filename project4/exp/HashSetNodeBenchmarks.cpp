@@ -0,0 +1,84 @@
+// HashSetNodeBenchmarks.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Compares HashSets whose nodes come from a NodePool with ones whose
+// nodes are allocated one at a time, counting allocations and timing
+// insertion, lookups in random order (which are dominated by cache
+// misses once the set outgrows the cache) and destruction.  To see the
+// cache misses themselves, run this benchmark under "perf stat -e
+// cache-misses".
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "Benchmarks.hpp"
+#include "HashSet.hpp"
+#include "NodePool.hpp"
+
+
+namespace
+{
+    template <typename SetType, typename ElementType, typename HashFunction>
+    void run(const std::string& label, HashFunction hashFunction, const std::vector<ElementType>& elements)
+    {
+        std::cout << label << std::endl;
+
+        std::unique_ptr<SetType> s{new SetType{hashFunction}};
+        unsigned long long before = benchmarks::allocationCount();
+        double ms = benchmarks::timeMilliseconds([&]()
+        {
+            for (const ElementType& e : elements)
+            {
+                s->add(e);
+            }
+        });
+        benchmarks::report("insert", ms, elements.size());
+        std::cout << "  allocations: " << benchmarks::allocationCount() - before << std::endl;
+
+        std::vector<ElementType> shuffled = elements;
+        std::shuffle(shuffled.begin(), shuffled.end(), std::default_random_engine{46});
+        unsigned int found = 0;
+        ms = benchmarks::timeMilliseconds([&]()
+        {
+            for (const ElementType& e : shuffled)
+            {
+                found += s->contains(e);
+            }
+        });
+        benchmarks::report("random lookup", ms, shuffled.size());
+
+        ms = benchmarks::timeMilliseconds([&]()
+        {
+            s.reset();
+        });
+        benchmarks::report("destroy", ms, elements.size());
+
+        if (found != elements.size())
+        {
+            std::cout << "  (lookups found " << found << " of " << elements.size() << ")" << std::endl;
+        }
+    }
+}
+
+
+void benchmarks::hashSetNodeAllocation()
+{
+    const unsigned int count = 1000000;
+
+    std::vector<int> numbers;
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        numbers.push_back(i * 7);
+    }
+    run<HashSet<int>>("HashSet<int> (NodePool)", identityHash, numbers);
+    run<HashSet<int, int, NewDeleteNodeAllocator>>("HashSet<int> (new per node)", identityHash, numbers);
+
+    std::vector<std::string> words = loadWords(count / 2);
+    run<HashSet<std::string>>("HashSet<std::string> (NodePool)", polynomialHash, words);
+    run<HashSet<std::string, std::string, NewDeleteNodeAllocator>>(
+        "HashSet<std::string> (new per node)", polynomialHash, words);
+}
@@ -0,0 +1,117 @@
+// MixedWorkloadBenchmarks.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Times a stream of contains(), add() and remove() calls against each of
+// the Set implementations that can remove elements.  Each set starts with
+// half of a pool of 200,000 words, then runs 1,000,000 operations on words
+// drawn at random from the whole pool, in a read-heavy mix (90% contains)
+// and a churning one (50% contains, with adds and removes balancing each
+// other so the set stays about the same size).
+
+#include <random>
+#include <string>
+#include <vector>
+#include "AVLSet.hpp"
+#include "Benchmarks.hpp"
+#include "FlatHashSet.hpp"
+#include "HashSet.hpp"
+#include "HashFunctions.hpp"
+#include "SkipListSet.hpp"
+
+
+namespace
+{
+    enum class Operation
+    {
+        Contains,
+        Add,
+        Remove
+    };
+
+
+    struct Step
+    {
+        Operation operation;
+        unsigned int word;
+    };
+
+
+    std::vector<Step> makeSteps(unsigned int count, unsigned int poolSize, unsigned int containsPercent)
+    {
+        std::default_random_engine engine{46};
+        std::uniform_int_distribution<unsigned int> word{0, poolSize - 1};
+        std::uniform_int_distribution<unsigned int> percent{0, 99};
+
+        std::vector<Step> steps;
+        steps.reserve(count);
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            unsigned int p = percent(engine);
+            Operation operation =
+                p < containsPercent ? Operation::Contains
+                : (p - containsPercent) % 2 == 0 ? Operation::Add
+                : Operation::Remove;
+            steps.push_back(Step{operation, word(engine)});
+        }
+        return steps;
+    }
+
+
+    template <typename SetType>
+    void run(const std::string& label, SetType s, const std::vector<std::string>& pool, const std::vector<Step>& steps)
+    {
+        for (unsigned int i = 0; i < pool.size(); i += 2)
+        {
+            s.add(pool[i]);
+        }
+
+        unsigned int found = 0;
+        unsigned int removed = 0;
+        double ms = benchmarks::timeMilliseconds([&]()
+        {
+            for (const Step& step : steps)
+            {
+                const std::string& word = pool[step.word];
+                switch (step.operation)
+                {
+                case Operation::Contains:
+                    found += s.contains(word);
+                    break;
+                case Operation::Add:
+                    s.add(word);
+                    break;
+                case Operation::Remove:
+                    removed += s.remove(word);
+                    break;
+                }
+            }
+        });
+        benchmarks::report(label, ms, steps.size());
+        std::cout << "    found " << found << ", removed " << removed
+            << ", final size " << s.size() << std::endl;
+    }
+}
+
+
+void benchmarks::mixedSetWorkloads()
+{
+    constexpr unsigned int POOL_SIZE = 200000;
+    constexpr unsigned int STEP_COUNT = 1000000;
+
+    std::vector<std::string> pool = loadWords(POOL_SIZE);
+
+    for (unsigned int containsPercent : {90, 50})
+    {
+        std::cout << "  " << containsPercent << "% contains, "
+            << (100 - containsPercent) / 2 << "% add, "
+            << (100 - containsPercent) / 2 << "% remove" << std::endl;
+
+        std::vector<Step> steps = makeSteps(STEP_COUNT, POOL_SIZE, containsPercent);
+        run("HashSet", HashSet<std::string>{hashing::wyhashString}, pool, steps);
+        run("FlatHashSet", FlatHashSet<std::string>{hashing::wyhashString}, pool, steps);
+        run("AVLSet", AVLSet<std::string>{}, pool, steps);
+        run("SkipListSet", SkipListSet<std::string>{}, pool, steps);
+    }
+}
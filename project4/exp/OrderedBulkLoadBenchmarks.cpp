@@ -0,0 +1,92 @@
+// OrderedBulkLoadBenchmarks.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Times loading a sorted dictionary into AVLSet and SkipListSet at sizes
+// from 100,000 to 1,000,000 words: one add() at a time, which searches
+// for each word's place (and, for AVLSet, rotates; in ascending order, an
+// AVL tree rotates on about every other add), and with fromSorted(),
+// which builds the whole structure in one pass.  Lookups are timed
+// afterward, to show that the bulk-loaded structures are as fast to
+// search as the ones built by add().
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "AVLSet.hpp"
+#include "Benchmarks.hpp"
+#include "SkipListSet.hpp"
+
+
+namespace
+{
+    template <typename SetType>
+    void timeLookups(const std::string& label, const SetType& s, const std::vector<std::string>& words)
+    {
+        unsigned int found = 0;
+        double ms = benchmarks::timeMilliseconds([&]()
+        {
+            for (unsigned int i = 0; i < words.size(); i += 10)
+            {
+                found += s.contains(words[i * 7919u % words.size()]);
+            }
+        });
+        benchmarks::report(label, ms, words.size() / 10);
+
+        if (found != words.size() / 10)
+        {
+            std::cout << "    (missing " << words.size() / 10 - found << " words)" << std::endl;
+        }
+    }
+}
+
+
+void benchmarks::orderedBulkLoad()
+{
+    for (unsigned int size : {100000, 300000, 1000000})
+    {
+        std::vector<std::string> words = loadWords(size);
+        std::sort(words.begin(), words.end());
+        std::cout << "  " << size << " sorted words" << std::endl;
+
+        {
+            AVLSet<std::string> added;
+            double ms = timeMilliseconds([&]()
+            {
+                for (const std::string& word : words)
+                {
+                    added.add(word);
+                }
+            });
+            report("AVLSet::add()", ms, size);
+
+            AVLSet<std::string> loaded;
+            ms = timeMilliseconds([&]() { loaded = AVLSet<std::string>::fromSorted(words.begin(), words.end()); });
+            report("AVLSet::fromSorted()", ms, size);
+            std::cout << "    heights " << added.height() << " and " << loaded.height() << std::endl;
+
+            timeLookups("AVLSet lookups after add()", added, words);
+            timeLookups("AVLSet lookups after fromSorted()", loaded, words);
+        }
+
+        {
+            SkipListSet<std::string> added;
+            double ms = timeMilliseconds([&]()
+            {
+                for (const std::string& word : words)
+                {
+                    added.add(word);
+                }
+            });
+            report("SkipListSet::add()", ms, size);
+
+            SkipListSet<std::string> loaded;
+            ms = timeMilliseconds([&]() { loaded = SkipListSet<std::string>::fromSorted(words.begin(), words.end()); });
+            report("SkipListSet::fromSorted()", ms, size);
+
+            timeLookups("SkipListSet lookups after add()", added, words);
+            timeLookups("SkipListSet lookups after fromSorted()", loaded, words);
+        }
+    }
+}
@@ -0,0 +1,103 @@
+// OrderedRangeBenchmarks.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Measures prefix scans of the kind an autocompleter makes: given the first
+// few letters a user has typed, find every dictionary word that starts with
+// them.  The dictionary has 100,000 words, and each prefix is the first
+// three letters of one of them.
+//
+// Before AVLSet had iterators, the only way to see its elements in order
+// was inorder(), which visits every element through a std::function,
+// however few of them match.  range() finds the first match in O(log n)
+// time and visits only the k matches after it.  Fewer prefixes are timed
+// with inorder(), since each one takes as long as a whole traversal.
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "AVLSet.hpp"
+#include "Benchmarks.hpp"
+#include "SkipListSet.hpp"
+
+
+namespace
+{
+    const unsigned int WORDS = 100000;
+    const unsigned int PREFIXES = 10000;
+    const unsigned int TRAVERSED_PREFIXES = 50;
+
+
+    // Every word starting with the prefix is at least the prefix and less
+    // than the prefix with its last letter advanced.
+    std::string afterPrefix(std::string prefix)
+    {
+        prefix.back()++;
+        return prefix;
+    }
+
+
+    template <typename SetType>
+    unsigned long long scanRanges(const SetType& s, const std::vector<std::string>& prefixes, unsigned int count)
+    {
+        unsigned long long found = 0;
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            std::string hi = afterPrefix(prefixes[i]);
+            for (const std::string& word : s.range(std::string_view{prefixes[i]}, std::string_view{hi}))
+            {
+                found += word.size();
+            }
+        }
+        return found;
+    }
+}
+
+
+void benchmarks::orderedRangeQueries()
+{
+    std::vector<std::string> words = loadWords(WORDS);
+    std::vector<std::string> prefixes;
+    for (unsigned int i = 0; i < PREFIXES; ++i)
+    {
+        prefixes.push_back(words[i * 7919 % WORDS].substr(0, 3));
+    }
+
+    AVLSet<std::string> avl;
+    SkipListSet<std::string> skipList;
+    for (const std::string& word : words)
+    {
+        avl.add(word);
+        skipList.add(word);
+    }
+
+    unsigned long long traversed = 0;
+    double ms = timeMilliseconds([&]()
+    {
+        for (unsigned int i = 0; i < TRAVERSED_PREFIXES; ++i)
+        {
+            std::string_view prefix = prefixes[i];
+            avl.inorder([&](const std::string& word)
+            {
+                if (std::string_view{word}.substr(0, prefix.size()) == prefix)
+                {
+                    traversed += word.size();
+                }
+            });
+        }
+    });
+    report("AVLSet::inorder()", ms, TRAVERSED_PREFIXES);
+
+    unsigned long long ranged = 0;
+    ms = timeMilliseconds([&]() { ranged = scanRanges(avl, prefixes, TRAVERSED_PREFIXES); });
+    std::cout << "  (" << (ranged == traversed ? "same" : "DIFFERENT") << " matches from range())" << std::endl;
+
+    ms = timeMilliseconds([&]() { ranged = scanRanges(avl, prefixes, PREFIXES); });
+    report("AVLSet::range()", ms, PREFIXES);
+
+    unsigned long long skipped = 0;
+    ms = timeMilliseconds([&]() { skipped = scanRanges(skipList, prefixes, PREFIXES); });
+    report("SkipListSet::range()", ms, PREFIXES);
+    std::cout << "  (" << (skipped == ranged ? "same" : "DIFFERENT") << " matches from both)" << std::endl;
+}
@@ -0,0 +1,88 @@
+// RankedSuggestionBenchmarks.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Measures what ranking suggestions costs on top of finding them: plain
+// findSuggestions(), then findBestSuggestions() keeping the top 5 and
+// keeping every suggestion.  The dictionary is crowded (every word made
+// from only four letters), so typos have many suggestions.
+
+#include <random>
+#include <string>
+#include <vector>
+#include "Benchmarks.hpp"
+#include "HashFunctions.hpp"
+#include "HashSet.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    std::vector<std::string> crowdedWords(unsigned int count, unsigned int length, unsigned int seed)
+    {
+        std::default_random_engine engine{seed};
+        std::uniform_int_distribution<int> letter{'A', 'D'};
+
+        std::vector<std::string> words;
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            std::string word(length, ' ');
+            for (char& c : word)
+            {
+                c = letter(engine);
+            }
+            words.push_back(word);
+        }
+        return words;
+    }
+}
+
+
+void benchmarks::rankedSuggestions()
+{
+    for (unsigned int length : {6u, 8u, 10u})
+    {
+        std::vector<std::string> words;
+        for (unsigned int l = length - 1; l <= length + 1; ++l)
+        {
+            std::vector<std::string> some = crowdedWords(100000, l, l);
+            words.insert(words.end(), some.begin(), some.end());
+        }
+        HashSet<std::string> hashSet{words.begin(), words.end(), hashing::wyhashString};
+        WordChecker checker{hashSet};
+        checker.setFrequencies([](const std::string& word)
+        {
+            return static_cast<double>(hashing::wyhashString(word) % 1000);
+        });
+
+        std::vector<std::string> typos = crowdedWords(2000, length, 99);
+        unsigned long long found = 0;
+        double all = timeMilliseconds([&]()
+        {
+            for (const std::string& typo : typos)
+            {
+                found += checker.findSuggestions(typo).size();
+            }
+        });
+        double top5 = timeMilliseconds([&]()
+        {
+            for (const std::string& typo : typos)
+            {
+                checker.findBestSuggestions(typo, 5);
+            }
+        });
+        double ranked = timeMilliseconds([&]()
+        {
+            for (const std::string& typo : typos)
+            {
+                checker.findBestSuggestions(typo, 1000);
+            }
+        });
+
+        std::cout << "  " << length << " letters, " << static_cast<double>(found) / typos.size()
+            << " suggestions per word: " << all * 1000.0 / typos.size() << " us/word unranked, "
+            << top5 * 1000.0 / typos.size() << " for the top 5, "
+            << ranked * 1000.0 / typos.size() << " for all ranked" << std::endl;
+    }
+}
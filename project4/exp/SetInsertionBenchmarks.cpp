@@ -0,0 +1,110 @@
+// SetInsertionBenchmarks.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Counts the heap allocations made while loading a dictionary into each
+// kind of Set, first by copying each word in with add(const&), then by
+// moving each one in with add(&&).  Then counts the allocations made by
+// looking up words that are slices of a larger text, first by building a
+// std::string from each slice and then by passing the std::string_view.
+//
+// Only words longer than the small-string buffer (15 characters with
+// libstdc++) allocate when copied, so the dictionary here is made of
+// long words, such as compound and technical terms.
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "AVLSet.hpp"
+#include "Benchmarks.hpp"
+#include "HashSet.hpp"
+#include "SkipListSet.hpp"
+
+
+namespace
+{
+    unsigned int viewHash(const std::string_view& s)
+    {
+        unsigned int hash = 0;
+        for (char c : s)
+        {
+            hash = hash * 31 + static_cast<unsigned char>(c);
+        }
+        return hash;
+    }
+
+
+    template <typename SetType>
+    void run(const std::string& label, SetType copied, SetType moved, const std::vector<std::string>& words)
+    {
+        std::cout << label << " (" << words.size() << " words)" << std::endl;
+
+        unsigned long long before = benchmarks::allocationCount();
+        for (const std::string& word : words)
+        {
+            copied.add(word);
+        }
+        std::cout << "  add(const&): " << benchmarks::allocationCount() - before << " allocations" << std::endl;
+
+        std::vector<std::string> expiring = words;
+        before = benchmarks::allocationCount();
+        for (std::string& word : expiring)
+        {
+            moved.add(std::move(word));
+        }
+        std::cout << "  add(&&):     " << benchmarks::allocationCount() - before << " allocations" << std::endl;
+
+        std::string text;
+        std::vector<std::string_view> slices;
+        for (const std::string& word : words)
+        {
+            text += word + ' ';
+        }
+        for (std::size_t start = 0, space; (space = text.find(' ', start)) != std::string::npos; start = space + 1)
+        {
+            slices.push_back(std::string_view{text}.substr(start, space - start));
+        }
+
+        unsigned int found = 0;
+        before = benchmarks::allocationCount();
+        for (std::string_view slice : slices)
+        {
+            found += moved.contains(std::string{slice});
+        }
+        std::cout << "  contains(std::string{view}): " << benchmarks::allocationCount() - before << " allocations" << std::endl;
+
+        before = benchmarks::allocationCount();
+        for (std::string_view slice : slices)
+        {
+            found += moved.contains(slice);
+        }
+        std::cout << "  contains(view):              " << benchmarks::allocationCount() - before << " allocations" << std::endl;
+
+        if (found != 2 * words.size())
+        {
+            std::cout << "  (lookups found " << found << " of " << 2 * words.size() << ")" << std::endl;
+        }
+    }
+
+
+    std::vector<std::string> longWords(unsigned int count)
+    {
+        std::vector<std::string> words = benchmarks::loadWords(count);
+        for (std::string& word : words)
+        {
+            word = word + "ABLENESS" + word;
+        }
+        return words;
+    }
+}
+
+
+void benchmarks::setInsertionAllocations()
+{
+    std::vector<std::string> words = longWords(500000);
+    run("HashSet<std::string, std::string_view>", HashSet<std::string, std::string_view>{viewHash},
+        HashSet<std::string, std::string_view>{viewHash}, words);
+    run("AVLSet<std::string>", AVLSet<std::string>{}, AVLSet<std::string>{}, words);
+    run("SkipListSet<std::string>", SkipListSet<std::string>{}, SkipListSet<std::string>{}, words);
+}
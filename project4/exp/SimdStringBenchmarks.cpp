@@ -0,0 +1,139 @@
+// SimdStringBenchmarks.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Compares the vectorized string hash and comparison in SimdStrings.hpp
+// with their ordinary equivalents: first the hash functions alone, then
+// lookups in a HashSet hashing with each of them, then lookups in an
+// AVLSet and a SkipListSet ordered by std::string's operators and by
+// SimdStringCompare.  Half of the lookups hit and half miss (the misses
+// are misspellings of words that are present, as a spell checker's are).
+// The SkipListSets hold fewer words, since building them takes time
+// quadratic in their size.
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "AVLSet.hpp"
+#include "Benchmarks.hpp"
+#include "HashFunctions.hpp"
+#include "HashSet.hpp"
+#include "SimdStrings.hpp"
+#include "SkipListSet.hpp"
+
+
+namespace
+{
+    // polynomialHash(), but of a view, as HashSet<std::string, std::string_view> needs.
+    unsigned int polynomialViewHash(const std::string_view& s)
+    {
+        unsigned int hash = 0;
+        for (char c : s)
+        {
+            hash = hash * 31 + static_cast<unsigned char>(c);
+        }
+        return hash;
+    }
+
+
+    template <typename HashFunction>
+    void runHash(const std::string& label, HashFunction hash, const std::vector<std::string>& words)
+    {
+        const unsigned int rounds = 20;
+
+        unsigned int combined = 0;
+        double ms = benchmarks::timeMilliseconds([&]()
+        {
+            for (unsigned int round = 0; round < rounds; ++round)
+            {
+                for (const std::string& word : words)
+                {
+                    combined ^= hash(word);
+                }
+            }
+        });
+        benchmarks::report(label, ms, words.size() * rounds);
+
+        if (combined == 0xffffffffu)
+        {
+            std::cout << "  (unlikely, but keeps the hashing from being optimized away)" << std::endl;
+        }
+    }
+
+
+    template <typename SetType>
+    void runLookups(const std::string& label, SetType& s, const std::vector<std::string>& present,
+        const std::vector<std::string>& absent)
+    {
+        unsigned int found = 0;
+        double ms = benchmarks::timeMilliseconds([&]()
+        {
+            for (unsigned int i = 0; i < present.size(); ++i)
+            {
+                found += s.contains(std::string_view{present[i]});
+                found += s.contains(std::string_view{absent[i]});
+            }
+        });
+        benchmarks::report(label, ms, present.size() * 2);
+
+        if (found < present.size())
+        {
+            std::cout << "  (lookups found only " << found << " of " << present.size() << ")" << std::endl;
+        }
+    }
+
+
+    template <typename SetType>
+    void runOrdered(const std::string& label, SetType s, const std::vector<std::string>& present,
+        const std::vector<std::string>& absent)
+    {
+        for (const std::string& word : present)
+        {
+            s.add(word);
+        }
+        runLookups(label, s, present, absent);
+    }
+
+
+    void runHashSet(const std::string& label, HashSet<std::string, std::string_view>::HashFunction hash,
+        const std::vector<std::string>& present, const std::vector<std::string>& absent)
+    {
+        HashSet<std::string, std::string_view> s{hash};
+        for (const std::string& word : present)
+        {
+            s.add(word);
+        }
+        runLookups(label, s, present, absent);
+    }
+}
+
+
+void benchmarks::simdStringLookups()
+{
+    const unsigned int count = 100000;
+
+    std::vector<std::string> present = loadWords(count);
+    std::vector<std::string> absent = misspell(present);
+
+    std::cout << "Hashing words" << std::endl;
+    runHash("polynomialHash", polynomialHash, present);
+    runHash("hashing::wyhashString", hashing::wyhashString, present);
+    runHash("simd::hashString", simd::hashString, present);
+    runHash("simd::hashStringScalar", simd::hashStringScalar, present);
+
+    std::cout << "HashSet<std::string> lookups" << std::endl;
+    runHashSet("polynomialHash", polynomialViewHash, present, absent);
+    runHashSet("hashing::wyhashString", hashing::wyhashString, present, absent);
+    runHashSet("simd::hashString", simd::hashString, present, absent);
+
+    std::cout << "Ordered set lookups" << std::endl;
+    runOrdered("AVLSet<std::string>", AVLSet<std::string>{}, present, absent);
+    runOrdered("AVLSet<std::string, SimdStringCompare>", AVLSet<std::string, SimdStringCompare>{}, present, absent);
+
+    std::vector<std::string> fewerPresent(present.begin(), present.begin() + count / 10);
+    std::vector<std::string> fewerAbsent(absent.begin(), absent.begin() + count / 10);
+    runOrdered("SkipListSet<std::string>", SkipListSet<std::string>{}, fewerPresent, fewerAbsent);
+    runOrdered("SkipListSet<std::string, SimdStringCompare>",
+        SkipListSet<std::string, SimdStringCompare>{}, fewerPresent, fewerAbsent);
+}
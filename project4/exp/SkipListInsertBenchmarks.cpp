@@ -0,0 +1,156 @@
+// SkipListInsertBenchmarks.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Shows how the time SkipListSet takes per insertion grows with its size,
+// compared with the way it used to insert: finding the new key's place on
+// each level by walking that level from its front, then finding the node
+// below it by walking the level beneath from its front, too, which takes
+// time linear in the size of the skip list per insertion.  The "before"
+// version below is a copy of that algorithm (and of the layout it ran on).
+//
+// Each size is built twice, from keys in random order and in ascending
+// order (the worst case for walking from the front, since every key goes
+// at the end).  If insertion takes O(log n) time, doubling the size adds
+// a constant number of steps to each insertion; if it takes O(n), it
+// doubles them.  (In random order, the steps also get slower as the skip
+// list outgrows the cache; in ascending order, they're mostly along the
+// most recently added nodes, which are still cached.)
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+#include "Benchmarks.hpp"
+#include "SkipListSet.hpp"
+
+
+namespace
+{
+    class RescanningSkipList
+    {
+    public:
+        void add(int element)
+        {
+            if (contains(element))
+            {
+                return;
+            }
+
+            std::size_t height = 1;
+            while (coin(engine))
+            {
+                height++;
+            }
+            while (fronts.size() < height)
+            {
+                std::shared_ptr<Node> below = fronts.empty() ? nullptr : fronts.back();
+                std::shared_ptr<Node> tail = std::make_shared<Node>(Node{std::nullopt, nullptr, nullptr});
+                fronts.push_back(std::make_shared<Node>(Node{std::nullopt, tail, below}));
+            }
+
+            for (std::size_t level = 0; level < height; ++level)
+            {
+                std::shared_ptr<Node> node = fronts[level];
+                while (node->next->key && *node->next->key < element)
+                {
+                    node = node->next;
+                }
+                node->next = std::make_shared<Node>(Node{element, node->next, nullptr});
+
+                if (level > 0)
+                {
+                    std::shared_ptr<Node> below = fronts[level - 1];
+                    while (below->key != element)
+                    {
+                        below = below->next;
+                    }
+                    node->next->below = below;
+                }
+            }
+        }
+
+        bool contains(int element) const
+        {
+            if (fronts.empty())
+            {
+                return false;
+            }
+
+            const Node* node = fronts.back().get();
+            while (node != nullptr)
+            {
+                if (node->next->key && *node->next->key < element)
+                {
+                    node = node->next.get();
+                }
+                else if (node->next->key == element)
+                {
+                    return true;
+                }
+                else
+                {
+                    node = node->below.get();
+                }
+            }
+            return false;
+        }
+
+    private:
+        // The keys of the nodes at the front (-INF) and end (+INF) of
+        // each level are empty.
+        struct Node
+        {
+            std::optional<int> key;
+            std::shared_ptr<Node> next;
+            std::shared_ptr<Node> below;
+        };
+
+        std::vector<std::shared_ptr<Node>> fronts;
+
+        std::default_random_engine engine{46};
+        std::bernoulli_distribution coin{0.5};
+    };
+
+
+    template <typename SetType>
+    void run(const std::string& label, const std::vector<unsigned int>& sizes)
+    {
+        std::cout << label << std::endl;
+
+        for (unsigned int size : sizes)
+        {
+            std::vector<int> ascending;
+            for (unsigned int i = 0; i < size; ++i)
+            {
+                ascending.push_back(i);
+            }
+            std::vector<int> shuffled = ascending;
+            std::shuffle(shuffled.begin(), shuffled.end(), std::default_random_engine{46});
+
+            for (const std::vector<int>* keys : {&shuffled, &ascending})
+            {
+                std::unique_ptr<SetType> s = std::make_unique<SetType>();
+                double ms = benchmarks::timeMilliseconds([&]()
+                {
+                    for (int key : *keys)
+                    {
+                        s->add(key);
+                    }
+                });
+                benchmarks::report(
+                    std::to_string(size) + (keys == &shuffled ? " random" : " ascending"), ms, size);
+            }
+        }
+    }
+}
+
+
+void benchmarks::skipListBulkInsert()
+{
+    run<RescanningSkipList>("Rescanning each level from its front", {2000, 4000, 8000, 16000});
+    run<SkipListSet<int>>("One top-down search, then splicing", {250000, 500000, 1000000, 2000000});
+}
@@ -0,0 +1,173 @@
+// SkipListLayoutBenchmarks.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Compares SkipListSet, which stores each element once in a node with an
+// arena-allocated tower of forward pointers, with the layout it replaced:
+// a linked list of std::shared_ptr nodes per level, each holding its own
+// key (and so its own copy of the element) and a pointer to the same
+// key's node on the level below.  The "before" version below keeps
+// that layout, but finds every level's insertion point in one top-down
+// search, so that building it doesn't take quadratic time and only the
+// layouts are being compared.
+//
+// For each, this reports the memory allocated to build it, the time to
+// build it, and the time per lookup, half of which hit and half miss.
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+#include "Benchmarks.hpp"
+#include "SkipListSet.hpp"
+
+
+namespace
+{
+    template <typename ElementType>
+    class LinkedLevelsSkipList
+    {
+    public:
+        void add(const ElementType& element)
+        {
+            std::vector<Node*> predecessors(fronts.size());
+            for (std::size_t level = fronts.size(); level-- > 0; )
+            {
+                Node* node = level + 1 == fronts.size() ? fronts[level].get() : predecessors[level + 1]->below.get();
+                while (node->next->key && *node->next->key < element)
+                {
+                    node = node->next.get();
+                }
+                if (node->next->key == element)
+                {
+                    return;
+                }
+                predecessors[level] = node;
+            }
+
+            std::size_t height = 1;
+            while (coin(engine))
+            {
+                height++;
+            }
+            while (fronts.size() < height)
+            {
+                std::shared_ptr<Node> below = fronts.empty() ? nullptr : fronts.back();
+                std::shared_ptr<Node> tail = std::make_shared<Node>(Node{std::nullopt, nullptr, nullptr});
+                fronts.push_back(std::make_shared<Node>(Node{std::nullopt, tail, below}));
+                predecessors.push_back(fronts.back().get());
+            }
+
+            std::shared_ptr<Node> below;
+            for (std::size_t level = 0; level < height; ++level)
+            {
+                Node* predecessor = predecessors[level];
+                predecessor->next = std::make_shared<Node>(Node{element, predecessor->next, below});
+                below = predecessor->next;
+            }
+        }
+
+        bool contains(const ElementType& element) const
+        {
+            if (fronts.empty())
+            {
+                return false;
+            }
+
+            const Node* node = fronts.back().get();
+            while (node != nullptr)
+            {
+                if (node->next->key && *node->next->key < element)
+                {
+                    node = node->next.get();
+                }
+                else if (node->next->key == element)
+                {
+                    return true;
+                }
+                else
+                {
+                    node = node->below.get();
+                }
+            }
+            return false;
+        }
+
+    private:
+        // The keys of the nodes at the front (-INF) and end (+INF) of
+        // each level are empty.
+        struct Node
+        {
+            std::optional<ElementType> key;
+            std::shared_ptr<Node> next;
+            std::shared_ptr<Node> below;
+        };
+
+        // The -INF node of each level, from the bottom up.
+        std::vector<std::shared_ptr<Node>> fronts;
+
+        std::default_random_engine engine{46};
+        std::bernoulli_distribution coin{0.5};
+    };
+
+
+    template <typename SetType, typename ElementType>
+    void run(const std::string& label, const std::vector<ElementType>& present, const std::vector<ElementType>& absent)
+    {
+        std::cout << label << " (" << present.size() << " elements)" << std::endl;
+
+        unsigned long long before = benchmarks::allocatedBytes();
+        std::unique_ptr<SetType> s = std::make_unique<SetType>();
+        double ms = benchmarks::timeMilliseconds([&]()
+        {
+            for (const ElementType& e : present)
+            {
+                s->add(e);
+            }
+        });
+        unsigned long long bytes = benchmarks::allocatedBytes() - before;
+        benchmarks::report("build", ms, present.size());
+        std::cout << "  memory: " << bytes / (1024.0 * 1024.0) << " MB ("
+            << static_cast<double>(bytes) / present.size() << " bytes/element)" << std::endl;
+
+        unsigned int found = 0;
+        ms = benchmarks::timeMilliseconds([&]()
+        {
+            for (unsigned int i = 0; i < present.size(); ++i)
+            {
+                found += s->contains(present[i]);
+                found += s->contains(absent[i]);
+            }
+        });
+        benchmarks::report("lookup", ms, present.size() * 2);
+
+        if (found != present.size())
+        {
+            std::cout << "  (lookups found " << found << " of " << present.size() << ")" << std::endl;
+        }
+    }
+}
+
+
+void benchmarks::skipListLayouts()
+{
+    std::vector<std::string> words = loadWords(400000);
+    std::vector<std::string> present(words.begin(), words.begin() + 200000);
+    std::vector<std::string> absent(words.begin() + 200000, words.end());
+    run<LinkedLevelsSkipList<std::string>>("Linked levels, std::string", present, absent);
+    run<SkipListSet<std::string>>("Towers, std::string", present, absent);
+
+    std::vector<int> numbers;
+    std::vector<int> missing;
+    for (int i = 0; i < 1000000; ++i)
+    {
+        numbers.push_back(i * 2);
+        missing.push_back(i * 2 + 1);
+    }
+    std::shuffle(numbers.begin(), numbers.end(), std::default_random_engine{46});
+    run<LinkedLevelsSkipList<int>>("Linked levels, int", numbers, missing);
+    run<SkipListSet<int>>("Towers, int", numbers, missing);
+}
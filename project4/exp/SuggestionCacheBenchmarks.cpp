@@ -0,0 +1,89 @@
+// SuggestionCacheBenchmarks.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Measures findSuggestions() on a stream of typos whose frequencies
+// follow Zipf's law (the kth most common typo appears about 1 / k as
+// often as the most common one), as real typos do, without a
+// SuggestionCache and with caches of increasing size, reporting each
+// cache's hit rate.
+
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include "Benchmarks.hpp"
+#include "BloomFilter.hpp"
+#include "HashFunctions.hpp"
+#include "HashSet.hpp"
+#include "SuggestionCache.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    std::vector<std::string> zipfStream(const std::vector<std::string>& typos, unsigned int length, double exponent)
+    {
+        std::vector<double> weights;
+        for (std::size_t rank = 1; rank <= typos.size(); ++rank)
+        {
+            weights.push_back(1.0 / std::pow(rank, exponent));
+        }
+
+        std::default_random_engine engine{46};
+        std::discrete_distribution<std::size_t> typo{weights.begin(), weights.end()};
+
+        std::vector<std::string> stream;
+        stream.reserve(length);
+        for (unsigned int i = 0; i < length; ++i)
+        {
+            stream.push_back(typos[typo(engine)]);
+        }
+        return stream;
+    }
+
+
+    double wordsPerSecond(const WordChecker& checker, const std::vector<std::string>& stream)
+    {
+        unsigned long long suggestions = 0;
+        double ms = benchmarks::timeMilliseconds([&]()
+        {
+            for (const std::string& typo : stream)
+            {
+                suggestions += checker.findSuggestions(typo).size();
+            }
+        });
+        return stream.size() / ms * 1000.0;
+    }
+}
+
+
+void benchmarks::suggestionCacheHitRates()
+{
+    std::vector<std::string> words = loadWords(250000);
+    std::vector<std::string> typos = misspell(loadWords(50000, 99));
+
+    HashSet<std::string> hashSet{words.begin(), words.end(), hashing::wyhashString};
+    BloomFilter filter{words};
+    WordChecker checker{hashSet, filter};
+
+    for (double exponent : {0.8, 1.0, 1.2})
+    {
+        std::vector<std::string> stream = zipfStream(typos, 500000, exponent);
+        std::cout << "  Zipf exponent " << exponent << ": " << wordsPerSecond(checker, stream)
+            << " words/s without a cache" << std::endl;
+
+        for (unsigned int capacity : {100u, 1000u, 10000u})
+        {
+            SuggestionCache cache{capacity};
+            checker.setCache(&cache, [&hashSet]() { return hashSet.version(); });
+            double rate = wordsPerSecond(checker, stream);
+            checker.setCache(nullptr);
+
+            SuggestionCacheStatistics stats = cache.statistics();
+            std::cout << "    " << capacity << " entries: " << rate << " words/s, "
+                << 100.0 * stats.hitRate() << "% hits, " << stats.evictions << " evictions" << std::endl;
+        }
+    }
+}
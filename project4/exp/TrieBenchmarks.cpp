@@ -0,0 +1,116 @@
+// TrieBenchmarks.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Compares findSuggestions() with its words in a Trie, which searches
+// the Trie for words one edit away, against a HashSet (with and without
+// a BloomFilter), which tries every possible edit, for misspelled words
+// of increasing length.  The number of edits to try grows with a word's
+// length, while the part of the Trie worth searching doesn't grow much.
+// Also measures how long a Trie takes to find every word two edits away,
+// which is far too many candidates to try one at a time.
+
+#include <string>
+#include <vector>
+#include "Benchmarks.hpp"
+#include "BloomFilter.hpp"
+#include "HashFunctions.hpp"
+#include "HashSet.hpp"
+#include "Trie.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    // Returns up to count of the given words whose lengths are in the
+    // given range, misspelled.
+    std::vector<std::string> typosOfLength(const std::vector<std::string>& words,
+        std::size_t shortest, std::size_t longest, unsigned int count)
+    {
+        std::vector<std::string> chosen;
+        for (const std::string& word : words)
+        {
+            if (chosen.size() < count && word.size() >= shortest && word.size() <= longest)
+            {
+                chosen.push_back(word);
+            }
+        }
+        return benchmarks::misspell(chosen);
+    }
+
+
+    double microsecondsPerWord(const std::vector<std::string>& typos, const WordChecker& checker)
+    {
+        unsigned long long suggestions = 0;
+        double ms = benchmarks::timeMilliseconds([&]()
+        {
+            for (const std::string& typo : typos)
+            {
+                suggestions += checker.findSuggestions(typo).size();
+            }
+        });
+        return ms * 1000.0 / typos.size();
+    }
+}
+
+
+void benchmarks::trieSuggestions()
+{
+    const unsigned int count = 250000;
+    std::vector<std::string> words = loadWords(count);
+
+    Trie trie{words};
+    HashSet<std::string> hashSet{words.begin(), words.end(), hashing::wyhashString};
+    BloomFilter filter{words};
+
+    std::cout << "  " << trie.size() << " words, " << trie.nodeCount() << " trie nodes" << std::endl;
+
+    WordChecker fromHashSet{hashSet};
+    WordChecker fromFilteredHashSet{hashSet, filter};
+    WordChecker fromTrie{trie};
+
+    // The dictionary itself may not have many long words, so long words
+    // are made by running two of them together.
+    std::vector<std::string> extra = loadWords(20000, 99);
+    std::vector<std::string> joined;
+    for (std::size_t i = 0; i + 1 < extra.size(); i += 2)
+    {
+        joined.push_back(extra[i] + extra[i + 1]);
+    }
+    for (const std::string& word : joined)
+    {
+        trie.add(word);
+        hashSet.add(word);
+        filter.add(word);
+    }
+
+    struct Lengths
+    {
+        std::size_t shortest;
+        std::size_t longest;
+        const std::vector<std::string>* from;
+    };
+
+    for (Lengths lengths : {Lengths{3, 6, &words}, Lengths{7, 10, &words}, Lengths{11, 16, &joined},
+        Lengths{17, 24, &joined}})
+    {
+        std::vector<std::string> typos = typosOfLength(*lengths.from, lengths.shortest, lengths.longest, 2000);
+
+        unsigned long long nearby = 0;
+        double distance2 = timeMilliseconds([&]()
+        {
+            for (const std::string& typo : typos)
+            {
+                nearby += trie.withinDistance(typo, 2).size();
+            }
+        });
+
+        std::cout << "  " << lengths.shortest << " to " << lengths.longest << " letters ("
+            << typos.size() << " words): "
+            << microsecondsPerWord(typos, fromHashSet) << " us/word with a HashSet, "
+            << microsecondsPerWord(typos, fromFilteredHashSet) << " with a filtered HashSet, "
+            << microsecondsPerWord(typos, fromTrie) << " with a Trie; "
+            << distance2 * 1000.0 / typos.size() << " us/word within two edits" << std::endl;
+    }
+}
@@ -0,0 +1,176 @@
+// WordCheckerCandidateBenchmarks.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Measures how many candidate spellings per second findSuggestions() can
+// generate and look up, and how many allocations each one costs, compared
+// with the way WordChecker used to build every candidate in a new string.
+// The "before" version below is a copy of those old helper functions.
+//
+// Generating candidates is measured on its own by looking them up in a
+// set that never contains anything, then again with a real dictionary.
+// Short words fit in a std::string's own storage, so copying them never
+// allocated anyway; the long words (pairs of words run together) don't.
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Benchmarks.hpp"
+#include "HashFunctions.hpp"
+#include "HashSet.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    class EmptySet : public Set<std::string>
+    {
+    public:
+        bool isImplemented() const noexcept override { return true; }
+        void add(const std::string&) override { }
+        bool contains(const std::string&) const override { return false; }
+        unsigned int size() const noexcept override { return 0; }
+    };
+
+
+    std::vector<std::string> copyingSuggestions(const Set<std::string>& words, const std::string& word)
+    {
+        std::vector<std::string> suggestions;
+        std::string copy_word;
+
+        for (std::size_t i = 1; i + 1 < word.size(); i++)
+        {
+            copy_word = word;
+            copy_word.insert(i, " ");
+            std::string substring1 = copy_word.substr(0, i);
+            std::string substring2 = copy_word.substr(i + 1);
+            if (words.contains(substring1) && words.contains(substring2))
+            {
+                suggestions.push_back(copy_word);
+            }
+        }
+
+        for (std::size_t i = 0; i < word.size(); i++)
+        {
+            for (char c = 'A'; c <= 'Z'; c++)
+            {
+                copy_word = word;
+                copy_word.at(i) = c;
+                if (words.contains(copy_word))
+                {
+                    suggestions.push_back(copy_word);
+                }
+            }
+        }
+
+        for (std::size_t i = 0; i < word.size() + 1; i++)
+        {
+            for (char c = 'A'; c <= 'Z'; c++)
+            {
+                copy_word = word;
+                std::string insert = std::string{c};
+                copy_word.insert(i, insert);
+                if (words.contains(copy_word))
+                {
+                    suggestions.push_back(copy_word);
+                }
+            }
+        }
+
+        for (std::size_t i = 0; i + 1 < word.size(); i++)
+        {
+            copy_word = word;
+            std::swap(copy_word[i], copy_word[i + 1]);
+            if (words.contains(copy_word))
+            {
+                suggestions.push_back(copy_word);
+            }
+        }
+
+        for (std::size_t i = 0; i < word.size(); i++)
+        {
+            copy_word = word;
+            copy_word.erase(i, 1);
+            if (words.contains(copy_word))
+            {
+                suggestions.push_back(copy_word);
+            }
+        }
+
+        suggestions.erase(std::unique(suggestions.begin(), suggestions.end()), suggestions.end());
+        return suggestions;
+    }
+
+
+    // The number of candidates (or, for splits, pairs of parts) that are
+    // looked up for a word of the given length.
+    unsigned long long candidateCount(std::size_t length)
+    {
+        unsigned long long splits = length > 2 ? length - 2 : 0;
+        unsigned long long swaps = length > 1 ? length - 1 : 0;
+        return splits + 26 * length + 26 * (length + 1) + swaps + length;
+    }
+
+
+    template <typename FindSuggestions>
+    void run(const std::string& label, const std::vector<std::string>& typos, FindSuggestions findSuggestions)
+    {
+        unsigned long long candidates = 0;
+        for (const std::string& typo : typos)
+        {
+            candidates += candidateCount(typo.size());
+        }
+
+        unsigned long long suggestions = 0;
+        unsigned long long allocations = benchmarks::allocationCount();
+        double ms = benchmarks::timeMilliseconds([&]()
+        {
+            for (const std::string& typo : typos)
+            {
+                suggestions += findSuggestions(typo).size();
+            }
+        });
+        allocations = benchmarks::allocationCount() - allocations;
+
+        std::cout << "  " << label << ": " << candidates / ms * 1000.0 << " candidates/s, "
+            << static_cast<double>(allocations) / candidates << " allocations per candidate ("
+            << suggestions << " suggestions)" << std::endl;
+    }
+
+
+    void compare(const std::string& label, const Set<std::string>& words, const std::vector<std::string>& typos)
+    {
+        WordChecker checker{words};
+        run(label + ", before", typos, [&](const std::string& typo)
+        {
+            return copyingSuggestions(words, typo);
+        });
+        run(label + ", after", typos, [&](const std::string& typo)
+        {
+            return checker.findSuggestions(typo);
+        });
+    }
+}
+
+
+void benchmarks::wordCheckerCandidates()
+{
+    std::vector<std::string> words = loadWords(250000);
+    std::vector<std::string> typos = misspell(loadWords(5000, 99));
+
+    std::vector<std::string> longTypos;
+    for (std::size_t i = 0; i + 1 < typos.size(); i += 2)
+    {
+        longTypos.push_back(typos[i] + typos[i + 1]);
+    }
+
+    EmptySet emptySet;
+    HashSet<std::string> hashSet{words.begin(), words.end(), hashing::wyhashString};
+
+    compare("Empty set", emptySet, typos);
+    compare("Empty set, long words", emptySet, longTypos);
+    compare("HashSet", hashSet, typos);
+    compare("HashSet, long words", hashSet, longTypos);
+}
@@ -6,22 +6,58 @@
 // Do whatever you'd like here.  This is intended to allow you to experiment
 // with your code, outside of the context of the broader program or Google
 // Test.
-#include "SkipListSet.hpp"
+//
+// Runs the benchmarks declared in Benchmarks.hpp: all of them by default,
+// or just the ones named on the command line.
 
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include "Benchmarks.hpp"
 
-int main()
-{
 
-    // SkipListSet<int> s;
-    // for(int i = 0; i < 10; i++)
-    // {
-    //     s.add(i);
-    // }
-    //s.print_everything();
+int main(int argc, char** argv)
+{
+    std::map<std::string, std::function<void()>> all{
+        {"hashSetLayouts", benchmarks::hashSetLayouts},
+        {"hashSetInsertLatency", benchmarks::hashSetInsertLatency},
+        {"setInsertionAllocations", benchmarks::setInsertionAllocations},
+        {"hashSetNodeAllocation", benchmarks::hashSetNodeAllocation},
+        {"hashQuality", benchmarks::hashQuality},
+        {"concurrentHashSetThroughput", benchmarks::concurrentHashSetThroughput},
+        {"hashSetBulkLoad", benchmarks::hashSetBulkLoad},
+        {"frozenStringSetSuggestions", benchmarks::frozenStringSetSuggestions},
+        {"bloomFilterSuggestions", benchmarks::bloomFilterSuggestions},
+        {"wordCheckerCandidates", benchmarks::wordCheckerCandidates},
+        {"trieSuggestions", benchmarks::trieSuggestions},
+        {"deletionIndexSuggestions", benchmarks::deletionIndexSuggestions},
+        {"batchSpellCheck", benchmarks::batchSpellCheck},
+        {"suggestionCacheHitRates", benchmarks::suggestionCacheHitRates},
+        {"rankedSuggestions", benchmarks::rankedSuggestions},
+        {"simdStringLookups", benchmarks::simdStringLookups},
+        {"skipListLayouts", benchmarks::skipListLayouts},
+        {"skipListBulkInsert", benchmarks::skipListBulkInsert},
+        {"concurrentSkipListThroughput", benchmarks::concurrentSkipListThroughput},
+        {"orderedRangeQueries", benchmarks::orderedRangeQueries},
+        {"orderedBulkLoad", benchmarks::orderedBulkLoad},
+        {"mixedSetWorkloads", benchmarks::mixedSetWorkloads}
+    };
 
-    
-    
+    for (const auto& [name, benchmark] : all)
+    {
+        bool selected = argc == 1;
+        for (int i = 1; i < argc; ++i)
+        {
+            selected = selected || name == argv[i];
+        }
+        if (selected)
+        {
+            std::cout << name << std::endl;
+            benchmark();
+            std::cout << std::endl;
+        }
+    }
 
     return 0;
 }
-
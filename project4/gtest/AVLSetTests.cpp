@@ -0,0 +1,353 @@
+// AVLSetTests.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for AVLSet beyond the sanity checks.
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <gtest/gtest.h>
+#include "AVLSet.hpp"
+
+
+TEST(AVLSetTests, addingDuplicatesHasNoEffect)
+{
+    AVLSet<int> balanced;
+    AVLSet<int> unbalanced{false};
+    for (int i = 0; i < 10; ++i)
+    {
+        balanced.add(i % 5);
+        unbalanced.add(i % 5);
+    }
+
+    EXPECT_EQ(5, balanced.size());
+    EXPECT_EQ(5, unbalanced.size());
+}
+
+
+TEST(AVLSetTests, copyAssignmentReplacesTheContents)
+{
+    AVLSet<int> s;
+    AVLSet<int> t{false};
+    for (int i = 0; i < 10; ++i)
+    {
+        s.add(i);
+        t.add(100 + i);
+    }
+
+    t = s;
+    EXPECT_EQ(10, t.size());
+    EXPECT_EQ(s.height(), t.height());
+    EXPECT_TRUE(t.contains(5));
+    EXPECT_FALSE(t.contains(105));
+    EXPECT_EQ(std::vector<int>(s.begin(), s.end()), std::vector<int>(t.begin(), t.end()));
+
+    // The copy is balanced like s, and doesn't share its nodes.
+    for (int i = 10; i < 100; ++i)
+    {
+        t.add(i);
+    }
+    EXPECT_LE(t.height(), 9);
+    EXPECT_EQ(10, s.size());
+    EXPECT_FALSE(s.contains(50));
+
+    const AVLSet<int>& same = t;
+    t = same;
+    EXPECT_EQ(100, t.size());
+    EXPECT_EQ(99, *t.lowerBound(99));
+}
+
+
+TEST(AVLSetTests, canMoveEmplaceAndLookUpViews)
+{
+    AVLSet<std::string> s;
+    std::string word(40, 'A');
+    s.add(std::move(word));
+    s.emplace(3, 'B');
+    s.emplace("CAT");
+
+    std::string_view text = "BBB CAT DOG";
+    EXPECT_EQ(3, s.size());
+    EXPECT_TRUE(s.contains(text.substr(0, 3)));
+    EXPECT_TRUE(s.contains(text.substr(4, 3)));
+    EXPECT_FALSE(s.contains(text.substr(8)));
+    EXPECT_TRUE(s.contains(std::string(40, 'A')));
+}
+
+
+TEST(AVLSetTests, iteratorsVisitElementsInAscendingOrder)
+{
+    std::vector<int> numbers;
+    for (int i = 0; i < 1000; ++i)
+    {
+        numbers.push_back(i * 2);
+    }
+    std::shuffle(numbers.begin(), numbers.end(), std::default_random_engine{46});
+
+    AVLSet<int> balanced;
+    AVLSet<int> unbalanced{false};
+    for (int n : numbers)
+    {
+        balanced.add(n);
+        unbalanced.add(n);
+    }
+
+    std::vector<int> expected;
+    for (int i = 0; i < 1000; ++i)
+    {
+        expected.push_back(i * 2);
+    }
+    EXPECT_EQ(expected, std::vector<int>(balanced.begin(), balanced.end()));
+    EXPECT_EQ(expected, std::vector<int>(unbalanced.begin(), unbalanced.end()));
+
+    AVLSet<int> copy{balanced};
+    EXPECT_EQ(expected, std::vector<int>(copy.begin(), copy.end()));
+
+    AVLSet<int> empty;
+    EXPECT_TRUE(empty.begin() == empty.end());
+}
+
+
+TEST(AVLSetTests, boundsFindTheFirstElementNotBeforeOrAfterAKey)
+{
+    AVLSet<int> s;
+    for (int i = 0; i < 100; i += 10)
+    {
+        s.add(i);
+    }
+
+    EXPECT_EQ(20, *s.lowerBound(20));
+    EXPECT_EQ(30, *s.upperBound(20));
+    EXPECT_EQ(30, *s.lowerBound(21));
+    EXPECT_EQ(30, *s.upperBound(21));
+    EXPECT_EQ(0, *s.lowerBound(-5));
+    EXPECT_TRUE(s.lowerBound(91) == s.end());
+    EXPECT_TRUE(s.upperBound(90) == s.end());
+}
+
+
+TEST(AVLSetTests, rangesIncludeTheirLowerBoundButNotTheirUpperOne)
+{
+    AVLSet<int> s;
+    for (int i = 0; i < 100; ++i)
+    {
+        s.add(i);
+    }
+
+    std::vector<int> found;
+    for (int n : s.range(25, 30))
+    {
+        found.push_back(n);
+    }
+    EXPECT_EQ((std::vector<int>{25, 26, 27, 28, 29}), found);
+
+    EXPECT_TRUE(s.range(30, 30).empty());
+    EXPECT_TRUE(s.range(30, 25).empty());
+    EXPECT_TRUE(s.range(200, 300).empty());
+    EXPECT_EQ(100, std::distance(s.range(-1, 100).begin(), s.range(-1, 100).end()));
+}
+
+
+TEST(AVLSetTests, viewsCanBoundAPrefixScan)
+{
+    AVLSet<std::string> s;
+    for (const char* word : {"CAR", "CART", "CARTON", "CAT", "CARD", "BOO", "DOG"})
+    {
+        s.add(word);
+    }
+
+    std::string_view text = "CARS";
+    std::vector<std::string> found;
+    for (const std::string& word : s.range(text.substr(0, 3), std::string_view{"CAS"}))
+    {
+        found.push_back(word);
+    }
+    EXPECT_EQ((std::vector<std::string>{"CAR", "CARD", "CART", "CARTON"}), found);
+}
+
+
+TEST(AVLSetTests, addingKeepsTheStoredHeightsExact)
+{
+    // Adding 2^k - 1 ascending elements to an AVL tree leaves it perfectly
+    // balanced, which only happens if every rotation leaves the heights it
+    // stores exactly right.
+    AVLSet<int> ascending;
+    for (int i = 0; i < 1023; ++i)
+    {
+        ascending.add(i);
+    }
+    EXPECT_EQ(9, ascending.height());
+
+    AVLSet<int> descending;
+    for (int i = 1022; i >= 0; --i)
+    {
+        descending.add(i);
+    }
+    EXPECT_EQ(9, descending.height());
+
+    // Shuffled adds need double rotations, too.
+    std::vector<int> numbers;
+    for (int i = 0; i < 4096; ++i)
+    {
+        numbers.push_back(i);
+    }
+    std::shuffle(numbers.begin(), numbers.end(), std::mt19937{46});
+
+    AVLSet<int> shuffled;
+    for (int n : numbers)
+    {
+        shuffled.add(n);
+    }
+    EXPECT_EQ(4096, shuffled.size());
+    EXPECT_LE(shuffled.height(), 16);
+    EXPECT_EQ(numbers.size(), std::distance(shuffled.begin(), shuffled.end()));
+}
+
+
+TEST(AVLSetTests, fromSortedBuildsAPerfectlyBalancedTree)
+{
+    std::vector<int> numbers;
+    for (int i = 0; i < 1023; ++i)
+    {
+        numbers.push_back(i);
+        numbers.push_back(i);
+    }
+
+    AVLSet<int> s = AVLSet<int>::fromSorted(numbers.begin(), numbers.end());
+    EXPECT_EQ(1023, s.size());
+    EXPECT_EQ(9, s.height());
+
+    std::vector<int> expected;
+    for (int i = 0; i < 1023; ++i)
+    {
+        expected.push_back(i);
+    }
+    EXPECT_EQ(expected, std::vector<int>(s.begin(), s.end()));
+
+    // The tree keeps balancing itself as more elements are added.
+    for (int i = 1023; i < 2047; ++i)
+    {
+        s.add(i);
+    }
+    EXPECT_EQ(2047, s.size());
+    EXPECT_LE(s.height(), 15);
+    EXPECT_EQ(1500, *s.lowerBound(1500));
+}
+
+
+TEST(AVLSetTests, fromSortedAddsElementsThatAreOutOfOrderAnyway)
+{
+    std::vector<std::string> words{"AND", "BOO", "DAY", "CAT", "EVERY", "ANT", "HAPPY"};
+    AVLSet<std::string> s = AVLSet<std::string>::fromSorted(words.begin(), words.end());
+
+    EXPECT_EQ(7, s.size());
+    EXPECT_EQ(
+        (std::vector<std::string>{"AND", "ANT", "BOO", "CAT", "DAY", "EVERY", "HAPPY"}),
+        std::vector<std::string>(s.begin(), s.end()));
+
+    AVLSet<std::string> empty = AVLSet<std::string>::fromSorted(words.end(), words.end());
+    EXPECT_EQ(0, empty.size());
+    EXPECT_EQ(-1, empty.height());
+}
+
+
+TEST(AVLSetTests, removingKeepsTheTreeOrderedAndBalanced)
+{
+    for (bool shouldBalance : {true, false})
+    {
+        AVLSet<int> s{shouldBalance};
+        std::set<int> expected;
+        std::default_random_engine engine{46};
+        std::uniform_int_distribution<int> number{0, 999};
+
+        for (int i = 0; i < 20000; ++i)
+        {
+            int n = number(engine);
+            if (i % 3 == 0)
+            {
+                ASSERT_EQ(expected.erase(n) == 1, s.remove(n));
+            }
+            else
+            {
+                s.add(n);
+                expected.insert(n);
+            }
+        }
+
+        EXPECT_EQ(expected.size(), s.size());
+        EXPECT_EQ(std::vector<int>(expected.begin(), expected.end()), std::vector<int>(s.begin(), s.end()));
+        if (shouldBalance)
+        {
+            // An AVL tree's height is less than 1.44 log2(n + 2).
+            EXPECT_LE(s.height(), 14);
+        }
+
+        for (int n : std::vector<int>(expected.begin(), expected.end()))
+        {
+            ASSERT_TRUE(s.remove(n));
+        }
+        EXPECT_EQ(0, s.size());
+        EXPECT_EQ(-1, s.height());
+        EXPECT_TRUE(s.begin() == s.end());
+    }
+}
+
+
+TEST(AVLSetTests, removingFromAscendingTreeRotatesToStayBalanced)
+{
+    AVLSet<int> s;
+    for (int i = 0; i < 1023; ++i)
+    {
+        s.add(i);
+    }
+
+    // Removing the whole left half leaves the right half twice as tall as
+    // what's left of the left, unless the tree rotates.
+    for (int i = 0; i < 511; ++i)
+    {
+        ASSERT_TRUE(s.remove(i));
+    }
+    EXPECT_EQ(512, s.size());
+    EXPECT_LE(s.height(), 10);
+    EXPECT_EQ(511, *s.begin());
+    EXPECT_EQ(600, *s.lowerBound(600));
+
+    std::string_view word = "CAT";
+    AVLSet<std::string> words;
+    words.add("CAT");
+    EXPECT_TRUE(words.remove(word));
+    EXPECT_FALSE(words.contains(word));
+}
+
+
+TEST(AVLSetTests, versionChangesWhenTheElementsDo)
+{
+    AVLSet<int> s;
+    unsigned long long version = s.version();
+
+    s.add(1);
+    EXPECT_NE(version, s.version());
+    version = s.version();
+
+    s.add(1);
+    s.contains(1);
+    s.remove(2);
+    EXPECT_EQ(version, s.version());
+
+    s.remove(1);
+    EXPECT_NE(version, s.version());
+    version = s.version();
+
+    s.add(2);
+    EXPECT_NE(version, s.version());
+    version = s.version();
+
+    AVLSet<int> other{s};
+    s = other;
+    EXPECT_NE(version, s.version());
+}
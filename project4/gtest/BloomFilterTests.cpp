@@ -0,0 +1,65 @@
+// BloomFilterTests.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for BloomFilter, and for WordChecker when it has one.
+
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "BloomFilter.hpp"
+#include "HashFunctions.hpp"
+#include "HashSet.hpp"
+#include "WordChecker.hpp"
+
+
+TEST(BloomFilterTests, neverRejectsWhatWasAdded)
+{
+    std::vector<std::string> words;
+    for (int i = 0; i < 20000; ++i)
+    {
+        words.push_back("WORD" + std::to_string(i));
+    }
+    BloomFilter filter{words};
+
+    for (const std::string& word : words)
+    {
+        ASSERT_TRUE(filter.mightContain(word));
+    }
+}
+
+
+TEST(BloomFilterTests, rejectsMostOfWhatWasntAdded)
+{
+    BloomFilter filter{20000};
+    for (int i = 0; i < 20000; ++i)
+    {
+        filter.add("WORD" + std::to_string(i));
+    }
+
+    int falsePositives = 0;
+    for (int i = 20000; i < 120000; ++i)
+    {
+        falsePositives += filter.mightContain("WORD" + std::to_string(i));
+    }
+    EXPECT_LT(falsePositives, 2000);
+    EXPECT_EQ(25024, filter.sizeInBytes());
+}
+
+
+TEST(BloomFilterTests, wordCheckerGivesTheSameAnswersWithAFilter)
+{
+    std::vector<std::string> words{"BOO", "IS", "HAPPY", "TODAY", "HAP", "PY", "BOOK", "BO"};
+    HashSet<std::string> set{words.begin(), words.end(), hashing::wyhashString};
+    BloomFilter filter{words};
+
+    WordChecker plain{set};
+    WordChecker filtered{set, filter};
+
+    for (const char* word : {"BOO", "BOOO", "HAPY", "HAPPYY", "OBO", "HAPPY", "TODYA"})
+    {
+        EXPECT_EQ(plain.wordExists(word), filtered.wordExists(word));
+        EXPECT_EQ(plain.findSuggestions(word), filtered.findSuggestions(word));
+    }
+}
@@ -0,0 +1,117 @@
+// ConcurrentHashSetTests.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for ConcurrentHashSet, on one thread and on many.
+
+#include <atomic>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "ConcurrentHashSet.hpp"
+#include "HashFunctions.hpp"
+
+
+TEST(ConcurrentHashSetTests, containsExactlyWhatWasAdded)
+{
+    ConcurrentHashSet<int> s{hashing::mixInt};
+    for (int i = 0; i < 1000; i += 2)
+    {
+        s.add(i);
+        s.add(i);
+    }
+
+    EXPECT_EQ(500, s.size());
+    EXPECT_GT(s.capacity(), 500);
+    for (int i = 0; i < 1000; ++i)
+    {
+        ASSERT_EQ(i % 2 == 0, s.contains(i));
+    }
+}
+
+
+TEST(ConcurrentHashSetTests, canMoveElementsInAndLookUpViews)
+{
+    ConcurrentHashSet<std::string, std::string_view> s{hashing::wyhashString};
+    std::string boo{"Boo is happy today"};
+    s.add(std::move(boo));
+
+    EXPECT_TRUE(s.contains(std::string_view{"Boo is happy today"}));
+    EXPECT_TRUE(s.contains(std::string{"Boo is happy today"}));
+    EXPECT_FALSE(s.contains(std::string_view{"Boo"}));
+}
+
+
+TEST(ConcurrentHashSetTests, threadsAddingOverlappingElementsAddEachOnce)
+{
+    ConcurrentHashSet<int> s{hashing::mixInt};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t)
+    {
+        threads.emplace_back([&s, t]()
+        {
+            // Each thread adds 0-9999 in a different order.
+            for (int i = 0; i < 10000; ++i)
+            {
+                s.add((i * 7919 + t * 1237) % 10000);
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(10000, s.size());
+    for (int i = 0; i < 10000; ++i)
+    {
+        ASSERT_TRUE(s.contains(i));
+    }
+}
+
+
+TEST(ConcurrentHashSetTests, readersAlwaysFindWhatHasAlreadyBeenAdded)
+{
+    ConcurrentHashSet<std::string> s{hashing::xxhashString};
+    std::atomic<int> added{0};
+    std::atomic<bool> missing{false};
+
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t)
+    {
+        readers.emplace_back([&]()
+        {
+            while (added.load() < 20000)
+            {
+                int known = added.load();
+                for (int i = known - 1; i >= 0 && i >= known - 50; --i)
+                {
+                    if (!s.contains(std::to_string(i)))
+                    {
+                        missing = true;
+                    }
+                }
+                if (s.contains("not a number"))
+                {
+                    missing = true;
+                }
+            }
+        });
+    }
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        s.add(std::to_string(i));
+        added.store(i + 1);
+    }
+    for (std::thread& reader : readers)
+    {
+        reader.join();
+    }
+
+    EXPECT_FALSE(missing.load());
+    EXPECT_EQ(20000, s.size());
+}
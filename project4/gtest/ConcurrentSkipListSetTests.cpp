@@ -0,0 +1,192 @@
+// ConcurrentSkipListSetTests.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for ConcurrentSkipListSet, on one thread and on many.
+
+#include <atomic>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "ConcurrentSkipListSet.hpp"
+
+
+TEST(ConcurrentSkipListSetTests, containsExactlyWhatWasAddedAndNotRemoved)
+{
+    ConcurrentSkipListSet<int> s;
+    for (int i = 999; i >= 0; --i)
+    {
+        s.add(i);
+        s.add(i);
+    }
+
+    EXPECT_EQ(1000, s.size());
+    EXPECT_GT(s.levelCount(), 1);
+
+    for (int i = 0; i < 1000; i += 3)
+    {
+        EXPECT_TRUE(s.remove(i));
+        EXPECT_FALSE(s.remove(i));
+    }
+    EXPECT_FALSE(s.remove(1000));
+
+    EXPECT_EQ(666, s.size());
+    for (int i = 0; i < 1000; ++i)
+    {
+        ASSERT_EQ(i % 3 != 0, s.contains(i));
+    }
+
+    s.add(0);
+    EXPECT_TRUE(s.contains(0));
+    EXPECT_EQ(667, s.size());
+}
+
+
+TEST(ConcurrentSkipListSetTests, canMoveElementsInAndLookUpViews)
+{
+    ConcurrentSkipListSet<std::string> s;
+    std::string boo{"Boo is happy today"};
+    s.add(std::move(boo));
+    s.add("CAT");
+
+    std::string_view text = "CAT DOG";
+    EXPECT_TRUE(s.contains(std::string_view{"Boo is happy today"}));
+    EXPECT_TRUE(s.contains(text.substr(0, 3)));
+    EXPECT_FALSE(s.contains(text.substr(4)));
+    EXPECT_TRUE(s.remove(text.substr(0, 3)));
+    EXPECT_FALSE(s.contains(std::string{"CAT"}));
+    EXPECT_EQ(1, s.size());
+}
+
+
+TEST(ConcurrentSkipListSetTests, threadsAddingOverlappingElementsAddEachOnce)
+{
+    ConcurrentSkipListSet<int> s;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t)
+    {
+        threads.emplace_back([&s, t]()
+        {
+            // Each thread adds 0-9999 in a different order.
+            for (int i = 0; i < 10000; ++i)
+            {
+                s.add((i * 7919 + t * 1237) % 10000);
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(10000, s.size());
+    for (int i = 0; i < 10000; ++i)
+    {
+        ASSERT_TRUE(s.contains(i));
+    }
+}
+
+
+TEST(ConcurrentSkipListSetTests, eachElementIsRemovedByExactlyOneThread)
+{
+    ConcurrentSkipListSet<int> s;
+    for (int i = 0; i < 20000; ++i)
+    {
+        s.add(i);
+    }
+
+    std::atomic<int> removed{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t)
+    {
+        threads.emplace_back([&s, &removed, t]()
+        {
+            // Every thread tries to remove every odd number, while adding
+            // and removing numbers of its own above 20000.
+            for (int i = 0; i < 10000; ++i)
+            {
+                if (s.remove((i * 7919 + t * 1237) % 10000 * 2 + 1))
+                {
+                    removed++;
+                }
+
+                int mine = 20000 + t * 10000 + i;
+                s.add(mine);
+                if (i % 2 == 0)
+                {
+                    s.remove(mine);
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(10000, removed.load());
+    EXPECT_EQ(10000 + 8 * 5000, s.size());
+    for (int i = 0; i < 20000; ++i)
+    {
+        ASSERT_EQ(i % 2 == 0, s.contains(i));
+    }
+    for (int i = 20000; i < 100000; ++i)
+    {
+        ASSERT_EQ(i % 2 == 1, s.contains(i));
+    }
+}
+
+
+TEST(ConcurrentSkipListSetTests, readersAlwaysFindElementsThatAreNotBeingRemoved)
+{
+    ConcurrentSkipListSet<std::string> s;
+    for (int i = 0; i < 2000; i += 2)
+    {
+        s.add(std::to_string(i));
+    }
+
+    std::atomic<bool> done{false};
+    std::atomic<bool> missing{false};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t)
+    {
+        readers.emplace_back([&]()
+        {
+            while (not done.load())
+            {
+                for (int i = 0; i < 2000; i += 2)
+                {
+                    if (not s.contains(std::to_string(i)))
+                    {
+                        missing = true;
+                    }
+                }
+            }
+        });
+    }
+
+    // The odd numbers, interleaved with the even ones, are added and
+    // removed over and over again.
+    for (int round = 0; round < 20; ++round)
+    {
+        for (int i = 1; i < 2000; i += 2)
+        {
+            s.add(std::to_string(i));
+        }
+        for (int i = 1; i < 2000; i += 2)
+        {
+            s.remove(std::to_string(i));
+        }
+    }
+    done = true;
+    for (std::thread& reader : readers)
+    {
+        reader.join();
+    }
+
+    EXPECT_FALSE(missing.load());
+    EXPECT_EQ(1000, s.size());
+}
@@ -0,0 +1,41 @@
+// CrowdedWords.hpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Random words for the unit tests that compare suggestions against a
+// brute-force search.
+
+#ifndef CROWDEDWORDS_HPP
+#define CROWDEDWORDS_HPP
+
+#include <random>
+#include <string>
+#include <vector>
+
+
+
+// Words over a four-letter alphabet, so that many of them are within an
+// edit or two of one another.  The same seed always gives the same words.
+inline std::vector<std::string> crowdedWords(unsigned int count, unsigned int seed = 46)
+{
+    std::default_random_engine engine{seed};
+    std::uniform_int_distribution<int> length{1, 7};
+    std::uniform_int_distribution<int> letter{'A', 'D'};
+
+    std::vector<std::string> words;
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        std::string word(length(engine), ' ');
+        for (char& c : word)
+        {
+            c = letter(engine);
+        }
+        words.push_back(word);
+    }
+    return words;
+}
+
+
+
+#endif
@@ -0,0 +1,110 @@
+// DeletionIndexTests.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for DeletionIndex, and for WordChecker when it has one.
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "CrowdedWords.hpp"
+#include "DeletionIndex.hpp"
+#include "HashFunctions.hpp"
+#include "HashSet.hpp"
+#include "Trie.hpp"
+#include "WordChecker.hpp"
+
+
+TEST(DeletionIndexTests, findsEachKindOfEdit)
+{
+    DeletionIndex index{{"CAT", "CART", "ACT", "AT", "BAT", "DOG", "CAT"}};
+
+    EXPECT_EQ(6, index.size());
+    EXPECT_EQ((std::vector<std::string>{"ACT", "AT", "BAT", "CART", "CAT"}), index.withinDistance("CAT", 1));
+    EXPECT_EQ((std::vector<std::string>{"CAT"}), index.withinDistance("CAT", 0));
+    EXPECT_EQ((std::vector<std::string>{}), index.withinDistance("ZZZ", 1));
+}
+
+
+TEST(DeletionIndexTests, cannotSearchFurtherThanItWasBuiltFor)
+{
+    DeletionIndex index{{"CAT"}, 1};
+
+    EXPECT_THROW(index.withinDistance("CAT", 2), DeletionIndexException);
+}
+
+
+TEST(DeletionIndexTests, findsTheSameWordsAsATrie)
+{
+    std::vector<std::string> words = crowdedWords(500, 46);
+    Trie t{words};
+
+    for (unsigned int maxDistance : {1u, 2u})
+    {
+        DeletionIndex index{words, maxDistance};
+        for (const std::string& s : crowdedWords(60, 47))
+        {
+            for (unsigned int d = 0; d <= maxDistance; ++d)
+            {
+                ASSERT_EQ(t.withinDistance(s, d), index.withinDistance(s, d)) << s << " " << d;
+            }
+        }
+    }
+}
+
+
+TEST(DeletionIndexTests, wordCheckerFindsTheSameSuggestionsAsWithoutIt)
+{
+    std::vector<std::string> words = crowdedWords(300, 46);
+    HashSet<std::string> h{words.begin(), words.end(), hashing::wyhashString};
+    DeletionIndex index{words};
+
+    WordChecker withIndex{h, index};
+    WordChecker withoutIndex{h};
+
+    for (const std::string& s : crowdedWords(100, 47))
+    {
+        std::vector<std::string> expected = withoutIndex.findSuggestions(s);
+        std::vector<std::string> actual = withIndex.findSuggestions(s);
+
+        std::sort(expected.begin(), expected.end());
+        expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+        std::sort(actual.begin(), actual.end());
+        ASSERT_EQ(expected, actual) << s;
+    }
+}
+
+
+TEST(DeletionIndexTests, wordCheckerOnlySuggestsWhatInsertingOrReplacingAToZWould)
+{
+    std::vector<std::string> words{"DON'T", "C-AT", "DOG", "-"};
+    HashSet<std::string> h{words.begin(), words.end(), hashing::wyhashString};
+    DeletionIndex index{words};
+    Trie t{words};
+
+    // The index and the Trie find words that differ by any character...
+    EXPECT_EQ((std::vector<std::string>{"DON'T"}), index.withinDistance("DONT", 1));
+    EXPECT_EQ((std::vector<std::string>{"DON'T"}), t.withinDistance("DONT", 1));
+
+    // ...but WordChecker only suggests the ones its own edits would make.
+    WordChecker withIndex{h, index};
+    WordChecker withTrie{t};
+    WordChecker withoutEither{h};
+    EXPECT_EQ((std::vector<std::string>{}), withIndex.findSuggestions("DONT"));
+    EXPECT_EQ((std::vector<std::string>{"DON'T"}), withIndex.findSuggestions("DON'X"));
+
+    for (const char* s : {"DONT", "DON'X", "DONT'", "DON'TS", "DON'T", "CAT", "C-T", "C-AT", "-", "--", "'"})
+    {
+        std::vector<std::string> expected = withoutEither.findSuggestions(s);
+        std::vector<std::string> fromIndex = withIndex.findSuggestions(s);
+        std::vector<std::string> fromTrie = withTrie.findSuggestions(s);
+
+        std::sort(expected.begin(), expected.end());
+        std::sort(fromIndex.begin(), fromIndex.end());
+        std::sort(fromTrie.begin(), fromTrie.end());
+        EXPECT_EQ(expected, fromIndex) << s;
+        EXPECT_EQ(expected, fromTrie) << s;
+    }
+}
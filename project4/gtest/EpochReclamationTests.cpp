@@ -0,0 +1,107 @@
+// EpochReclamationTests.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the epochs in EpochReclamation.hpp.
+
+#include <atomic>
+#include <thread>
+#include <gtest/gtest.h>
+#include "EpochReclamation.hpp"
+
+
+namespace
+{
+    std::atomic<int> deleted{0};
+
+    void countDeletion(void* node)
+    {
+        deleted++;
+        delete static_cast<int*>(node);
+    }
+}
+
+
+TEST(EpochReclamationTests, nodesAreDeletedOnlyOnceNoGuardCouldSeeThem)
+{
+    epochs::collect();
+    deleted = 0;
+
+    std::atomic<bool> guarded{false};
+    std::atomic<bool> release{false};
+    std::thread reader{[&]()
+    {
+        epochs::Guard guard;
+        guarded = true;
+        while (not release.load())
+        {
+            std::this_thread::yield();
+        }
+    }};
+
+    while (not guarded.load())
+    {
+        std::this_thread::yield();
+    }
+
+    for (int i = 0; i < 10; ++i)
+    {
+        epochs::retire(new int{i}, &countDeletion);
+    }
+
+    // The reader's Guard holds back the epoch, however often it's tried.
+    for (int i = 0; i < 5; ++i)
+    {
+        epochs::collect();
+    }
+    EXPECT_EQ(0, deleted.load());
+    EXPECT_EQ(10, epochs::retiredCount());
+
+    release = true;
+    reader.join();
+
+    epochs::collect();
+    EXPECT_EQ(10, deleted.load());
+    EXPECT_EQ(0, epochs::retiredCount());
+}
+
+
+TEST(EpochReclamationTests, nodesRetiredByExitedThreadsAreStillDeleted)
+{
+    epochs::collect();
+    deleted = 0;
+
+    std::thread retirer{[]()
+    {
+        epochs::Guard guard;
+        epochs::retire(new int{46}, &countDeletion);
+    }};
+    retirer.join();
+
+    epochs::collect();
+    EXPECT_EQ(1, deleted.load());
+}
+
+
+TEST(EpochReclamationTests, guardsCanBeNested)
+{
+    epochs::collect();
+    deleted = 0;
+
+    {
+        epochs::Guard outer;
+        {
+            epochs::Guard inner;
+            epochs::retire(new int{1}, &countDeletion);
+        }
+
+        // The outer Guard is still held, so this thread could still be
+        // looking at the node.
+        epochs::collect();
+        EXPECT_EQ(0, deleted.load());
+    }
+
+    epochs::collect();
+    EXPECT_EQ(1, deleted.load());
+}
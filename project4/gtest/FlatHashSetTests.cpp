@@ -0,0 +1,198 @@
+// FlatHashSetTests.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for FlatHashSet, covering growth, collisions, and copying.
+
+#include <string>
+#include <string_view>
+#include <gtest/gtest.h>
+#include "FlatHashSet.hpp"
+
+
+namespace
+{
+    template <typename T>
+    unsigned int zeroHash(const T&)
+    {
+        return 0;
+    }
+
+    unsigned int identityHash(const int& i)
+    {
+        return i;
+    }
+}
+
+
+TEST(FlatHashSetTests, containsExactlyWhatWasAdded)
+{
+    FlatHashSet<int> s{identityHash};
+    for (int i = 0; i < 1000; i += 2)
+    {
+        s.add(i);
+    }
+
+    EXPECT_EQ(500, s.size());
+    for (int i = 0; i < 1000; ++i)
+    {
+        EXPECT_EQ(i % 2 == 0, s.contains(i));
+    }
+}
+
+
+TEST(FlatHashSetTests, addingDuplicatesHasNoEffect)
+{
+    FlatHashSet<std::string> s{zeroHash<std::string>};
+    s.add("Boo");
+    s.add("is");
+    s.add("Boo");
+
+    EXPECT_EQ(2, s.size());
+    EXPECT_TRUE(s.contains("Boo"));
+    EXPECT_FALSE(s.contains("happy"));
+}
+
+
+TEST(FlatHashSetTests, survivesEveryElementColliding)
+{
+    FlatHashSet<int> s{zeroHash<int>};
+    for (int i = 0; i < 300; ++i)
+    {
+        s.add(i);
+    }
+
+    EXPECT_EQ(300, s.size());
+    EXPECT_TRUE(s.contains(0));
+    EXPECT_TRUE(s.contains(299));
+    EXPECT_FALSE(s.contains(300));
+}
+
+
+TEST(FlatHashSetTests, growsBeforeBecomingTooFull)
+{
+    FlatHashSet<int> s{identityHash};
+    for (int i = 0; i < 100; ++i)
+    {
+        s.add(i);
+        EXPECT_LE(s.size() * 8, s.capacity() * 7);
+    }
+}
+
+
+TEST(FlatHashSetTests, copiesAreIndependent)
+{
+    FlatHashSet<std::string> s1{zeroHash<std::string>};
+    s1.add("Boo");
+
+    FlatHashSet<std::string> s2{s1};
+    s2.add("Alex");
+
+    FlatHashSet<std::string> s3{zeroHash<std::string>};
+    s3 = s2;
+    s3.add("Thrissy");
+
+    EXPECT_FALSE(s1.contains("Alex"));
+    EXPECT_TRUE(s2.contains("Boo"));
+    EXPECT_FALSE(s2.contains("Thrissy"));
+    EXPECT_EQ(3, s3.size());
+
+    FlatHashSet<std::string> s4{std::move(s3)};
+    EXPECT_TRUE(s4.contains("Thrissy"));
+}
+
+
+TEST(FlatHashSetTests, canMoveEmplaceAndLookUpViews)
+{
+    FlatHashSet<std::string, std::string_view> s{[](const std::string_view& e) {return static_cast<unsigned int>(e.size());}};
+    std::string word(40, 'A');
+    s.add(std::move(word));
+    s.emplace(3, 'B');
+
+    std::string_view text = "BBB AAAA";
+    EXPECT_EQ(2, s.size());
+    EXPECT_TRUE(s.contains(text.substr(0, 3)));
+    EXPECT_FALSE(s.contains(text.substr(4)));
+    EXPECT_TRUE(s.contains(std::string(40, 'A')));
+}
+
+
+TEST(FlatHashSetTests, removingShiftsLaterElementsBack)
+{
+    // Every element collides, so they all sit in one run of cells, and
+    // removing any of them has to shift the rest back.
+    FlatHashSet<int> s{zeroHash<int>};
+    for (int i = 0; i < 50; ++i)
+    {
+        s.add(i);
+    }
+
+    for (int i = 0; i < 50; i += 3)
+    {
+        EXPECT_TRUE(s.remove(i));
+        EXPECT_FALSE(s.remove(i));
+    }
+
+    EXPECT_EQ(33, s.size());
+    for (int i = 0; i < 50; ++i)
+    {
+        ASSERT_EQ(i % 3 != 0, s.contains(i));
+    }
+}
+
+
+TEST(FlatHashSetTests, removingKeepsTheRestFindable)
+{
+    FlatHashSet<std::string, std::string_view> s{[](const std::string_view& v) { return static_cast<unsigned int>(v.size() * 31 + v[0]); }};
+    for (int i = 0; i < 2000; ++i)
+    {
+        s.add(std::to_string(i));
+    }
+    unsigned int capacity = s.capacity();
+
+    for (int round = 0; round < 5; ++round)
+    {
+        for (int i = round; i < 2000; i += 5)
+        {
+            ASSERT_TRUE(s.remove(std::string_view{std::to_string(i)}));
+        }
+        for (int i = 0; i < 2000; ++i)
+        {
+            ASSERT_EQ(i % 5 > round, s.contains(std::string_view{std::to_string(i)}));
+        }
+    }
+
+    EXPECT_EQ(0, s.size());
+    EXPECT_EQ(capacity, s.capacity());
+    s.add("again");
+    EXPECT_TRUE(s.contains("again"));
+}
+
+
+TEST(FlatHashSetTests, versionChangesWhenTheElementsDo)
+{
+    FlatHashSet<int> s{identityHash};
+    unsigned long long version = s.version();
+
+    s.add(1);
+    EXPECT_NE(version, s.version());
+    version = s.version();
+
+    s.add(1);
+    s.contains(1);
+    s.remove(2);
+    EXPECT_EQ(version, s.version());
+
+    s.remove(1);
+    EXPECT_NE(version, s.version());
+    version = s.version();
+
+    s.add(2);
+    EXPECT_NE(version, s.version());
+    version = s.version();
+
+    FlatHashSet<int> other{s};
+    s = other;
+    EXPECT_NE(version, s.version());
+}
@@ -0,0 +1,168 @@
+// FrozenStringSetTests.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for FrozenStringSet.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <gtest/gtest.h>
+#include "FrozenStringSet.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    std::vector<std::string> numberWords(unsigned int count)
+    {
+        std::vector<std::string> words;
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            words.push_back("WORD" + std::to_string(i));
+        }
+        return words;
+    }
+
+
+    // Saves a FrozenStringSet of the given number of words, then
+    // overwrites either its first displacement or its second slot with
+    // the given value.
+    void saveCorrupted(const std::string& path, unsigned int wordCount, bool inSlots, std::uint32_t value)
+    {
+        FrozenStringSet{numberWords(wordCount)}.save(path);
+
+        std::string bytes;
+        {
+            std::ifstream in{path, std::ios::binary};
+            bytes.assign(std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{});
+        }
+
+        std::uint32_t bucketCount;
+        std::memcpy(&bucketCount, bytes.data() + 8, sizeof(bucketCount));
+        std::size_t displacementsOffset = 24;
+        std::size_t slotsOffset = displacementsOffset + (sizeof(std::uint32_t) * bucketCount + 7) / 8 * 8;
+
+        std::size_t offset = inSlots ? slotsOffset + sizeof(std::uint32_t) : displacementsOffset;
+        std::memcpy(bytes.data() + offset, &value, sizeof(value));
+
+        std::ofstream{path, std::ios::binary} << bytes;
+    }
+}
+
+
+TEST(FrozenStringSetTests, containsExactlyTheWordsItWasBuiltFrom)
+{
+    std::vector<std::string> words = numberWords(10000);
+    FrozenStringSet s{words};
+
+    EXPECT_EQ(10000, s.size());
+    for (const std::string& word : words)
+    {
+        ASSERT_TRUE(s.contains(word));
+    }
+    for (unsigned int i = 10000; i < 20000; ++i)
+    {
+        ASSERT_FALSE(s.contains("WORD" + std::to_string(i)));
+    }
+    EXPECT_FALSE(s.contains("WORD"));
+    EXPECT_FALSE(s.contains(""));
+}
+
+
+TEST(FrozenStringSetTests, ignoresDuplicatesAndHandlesEmptyStrings)
+{
+    FrozenStringSet s{{"BOO", "", "BOO", "HAPPY", ""}};
+
+    EXPECT_EQ(3, s.size());
+    EXPECT_TRUE(s.contains(""));
+    EXPECT_TRUE(s.contains(std::string_view{"HAPPY"}));
+    EXPECT_FALSE(s.contains(std::string_view{"HAPP"}));
+}
+
+
+TEST(FrozenStringSetTests, emptySetsContainNothing)
+{
+    FrozenStringSet s{std::vector<std::string>{}};
+    EXPECT_EQ(0, s.size());
+    EXPECT_FALSE(s.contains(""));
+}
+
+
+TEST(FrozenStringSetTests, cannotBeAddedTo)
+{
+    FrozenStringSet s{{"BOO"}};
+    EXPECT_THROW(s.add("HAPPY"), FrozenStringSetException);
+}
+
+
+TEST(FrozenStringSetTests, canBeSavedAndLoaded)
+{
+    std::string path = testing::TempDir() + "FrozenStringSetTests.fss";
+    std::vector<std::string> words = numberWords(1000);
+    FrozenStringSet{words}.save(path);
+
+    FrozenStringSet loaded = FrozenStringSet::load(path);
+    EXPECT_EQ(1000, loaded.size());
+    for (const std::string& word : words)
+    {
+        ASSERT_TRUE(loaded.contains(word));
+    }
+    EXPECT_FALSE(loaded.contains("WORD1000"));
+
+    std::string copyPath = path + ".copy";
+    loaded.save(copyPath);
+    EXPECT_TRUE(FrozenStringSet::load(copyPath).contains("WORD999"));
+
+    std::remove(path.c_str());
+    std::remove(copyPath.c_str());
+}
+
+
+TEST(FrozenStringSetTests, loadingSomethingElseThrows)
+{
+    std::string path = testing::TempDir() + "FrozenStringSetTests.txt";
+    std::ofstream{path} << "This is not a FrozenStringSet, but it's long enough to have a header.";
+
+    EXPECT_THROW(FrozenStringSet::load(path), FrozenStringSetException);
+    EXPECT_THROW(FrozenStringSet::load(path + ".missing"), FrozenStringSetException);
+    std::remove(path.c_str());
+}
+
+
+TEST(FrozenStringSetTests, loadingACorruptFileThrows)
+{
+    std::string path = testing::TempDir() + "FrozenStringSetTests.corrupt.fss";
+
+    // A bucket's only word placed in a slot past the last one.
+    saveCorrupted(path, 100, false, 0x80000000u | 100);
+    EXPECT_THROW(FrozenStringSet::load(path), FrozenStringSetException);
+
+    // A word that would end before it starts, past the end of the arena.
+    saveCorrupted(path, 100, true, 0xfffffff0u);
+    EXPECT_THROW(FrozenStringSet::load(path), FrozenStringSetException);
+
+    // A displacement that only sends lookups to the wrong slot is still
+    // safe to load.
+    saveCorrupted(path, 100, false, 0);
+    EXPECT_EQ(100, FrozenStringSet::load(path).size());
+
+    std::remove(path.c_str());
+}
+
+
+TEST(FrozenStringSetTests, worksWithWordChecker)
+{
+    FrozenStringSet s{{"BOO", "IS", "HAPPY", "TODAY"}};
+    WordChecker checker{s};
+
+    EXPECT_TRUE(checker.wordExists("HAPPY"));
+    std::vector<std::string> suggestions = checker.findSuggestions("HAPY");
+    EXPECT_NE(suggestions.end(), std::find(suggestions.begin(), suggestions.end(), "HAPPY"));
+}
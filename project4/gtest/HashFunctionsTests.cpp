@@ -0,0 +1,65 @@
+// HashFunctionsTests.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the ready-made hash functions.
+
+#include <string>
+#include <gtest/gtest.h>
+#include "HashFunctions.hpp"
+#include "HashSet.hpp"
+
+
+TEST(HashFunctionsTests, xxhashMatchesTheReferenceImplementation)
+{
+    EXPECT_EQ(0x02cc5d05u, hashing::xxhashString(""));
+    EXPECT_EQ(0x32d153ffu, hashing::xxhashString("abc"));
+}
+
+
+TEST(HashFunctionsTests, stringHashesDependOnEveryCharacter)
+{
+    // Lengths chosen to exercise each of wyhash's ways of reading input.
+    for (unsigned int length : {1u, 3u, 4u, 8u, 16u, 17u, 48u, 49u, 100u})
+    {
+        std::string s(length, 'A');
+        unsigned int wy = hashing::wyhashString(s);
+        unsigned int xx = hashing::xxhashString(s);
+        for (unsigned int i = 0; i < length; ++i)
+        {
+            std::string changed = s;
+            changed[i] = 'B';
+            ASSERT_NE(wy, hashing::wyhashString(changed)) << length << " " << i;
+            ASSERT_NE(xx, hashing::xxhashString(changed)) << length << " " << i;
+        }
+        ASSERT_EQ(wy, hashing::wyhashString(std::string(length, 'A')));
+    }
+}
+
+
+TEST(HashFunctionsTests, spreadsSimilarIntsEvenly)
+{
+    // Multiples of the capacity all land at index 0 when ints are their
+    // own hashes; mixed, they should spread across the array.
+    HashSet<int> s{hashing::mixInt};
+    for (int i = 0; i < 1000; ++i)
+    {
+        s.add(i * 1024);
+    }
+
+    HashSetStatistics stats = s.statistics();
+    EXPECT_LE(stats.maxChainLength, 8);
+}
+
+
+TEST(HashFunctionsTests, canHashStringsAndViewsInHashSets)
+{
+    HashSet<std::string> strings{hashing::wyhashString};
+    HashSet<std::string, std::string_view> views{hashing::xxhashString};
+    strings.add("Boo");
+    views.add("Boo");
+
+    EXPECT_TRUE(strings.contains("Boo"));
+    EXPECT_TRUE(views.contains(std::string_view{"Boo"}));
+}
@@ -0,0 +1,407 @@
+// HashSetTests.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for HashSet beyond the sanity checks, mostly around resizing.
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <gtest/gtest.h>
+#include "HashSet.hpp"
+#include "NodePool.hpp"
+
+
+namespace
+{
+    unsigned int identityHash(const int& i)
+    {
+        return i;
+    }
+}
+
+
+TEST(HashSetTests, containsEverythingWhileResizing)
+{
+    HashSet<int> s{identityHash};
+    for (int i = 0; i < 500; ++i)
+    {
+        s.add(i);
+        for (int j = 0; j <= i; j += 7)
+        {
+            ASSERT_TRUE(s.contains(j));
+        }
+        ASSERT_FALSE(s.contains(i + 1));
+    }
+    EXPECT_EQ(500, s.size());
+}
+
+
+TEST(HashSetTests, addingDuplicatesWhileResizingHasNoEffect)
+{
+    HashSet<int> s{identityHash};
+    for (int i = 0; i < 100; ++i)
+    {
+        s.add(i);
+        s.add(i / 2);
+    }
+    EXPECT_EQ(100, s.size());
+}
+
+
+TEST(HashSetTests, indicesReflectNewCapacityImmediately)
+{
+    // The 9th element pushes the size past 80% of 10, so the capacity
+    // becomes 21 even though most elements haven't moved yet.
+    HashSet<int> s{identityHash};
+    for (int i = 0; i < 9; ++i)
+    {
+        s.add(i);
+    }
+    s.add(30);
+
+    EXPECT_EQ(1, s.elementsAtIndex(0));
+    EXPECT_EQ(1, s.elementsAtIndex(8));
+    EXPECT_EQ(1, s.elementsAtIndex(9));
+    EXPECT_TRUE(s.isElementAtIndex(30, 9));
+    EXPECT_FALSE(s.isElementAtIndex(30, 10));
+}
+
+
+TEST(HashSetTests, copiesTakenWhileResizingAreComplete)
+{
+    HashSet<int> s{identityHash};
+    for (int i = 0; i < 9; ++i)
+    {
+        s.add(i);
+    }
+
+    HashSet<int> copy{s};
+    HashSet<int> assigned{identityHash};
+    assigned = s;
+    for (int i = 0; i < 9; ++i)
+    {
+        EXPECT_TRUE(copy.contains(i));
+        EXPECT_TRUE(assigned.contains(i));
+    }
+    EXPECT_EQ(9, copy.size());
+    EXPECT_EQ(1, copy.elementsAtIndex(8));
+}
+
+
+TEST(HashSetTests, canMoveAndEmplaceElements)
+{
+    HashSet<std::string> s{[](const std::string& e) {return static_cast<unsigned int>(e.size());}};
+    std::string word(40, 'A');
+    s.add(std::move(word));
+    s.emplace(3, 'B');
+    s.emplace("CAT");
+
+    EXPECT_EQ(3, s.size());
+    EXPECT_TRUE(s.contains(std::string(40, 'A')));
+    EXPECT_TRUE(s.contains("BBB"));
+    EXPECT_TRUE(s.contains("CAT"));
+}
+
+
+TEST(HashSetTests, canLookUpStringViewsWhenHashingThem)
+{
+    HashSet<std::string, std::string_view> s{[](const std::string_view& e) {return static_cast<unsigned int>(e.size());}};
+    s.add("BOO");
+    s.add("THRISSY");
+
+    std::string_view text = "BOO AND THRISSY";
+    EXPECT_TRUE(s.contains(text.substr(0, 3)));
+    EXPECT_TRUE(s.contains(text.substr(8)));
+    EXPECT_FALSE(s.contains(text.substr(4, 3)));
+}
+
+
+TEST(HashSetTests, copiesAndAssignmentsOwnTheirOwnNodes)
+{
+    HashSet<std::string> s1{[](const std::string& s) { return s.size(); }};
+    for (int i = 0; i < 100; ++i)
+    {
+        s1.add(std::to_string(i));
+    }
+
+    HashSet<std::string> s2{s1};
+    HashSet<std::string> s3{[](const std::string&) { return 0u; }};
+    s3.add("gone");
+    s3 = s1;
+    s1 = HashSet<std::string>{[](const std::string&) { return 0u; }};
+
+    EXPECT_EQ(0, s1.size());
+    for (int i = 0; i < 100; ++i)
+    {
+        ASSERT_TRUE(s2.contains(std::to_string(i)));
+        ASSERT_TRUE(s3.contains(std::to_string(i)));
+    }
+    EXPECT_FALSE(s3.contains("gone"));
+}
+
+
+TEST(HashSetTests, canAllocateNodesOneAtATime)
+{
+    HashSet<int, int, NewDeleteNodeAllocator> s{identityHash};
+    for (int i = 0; i < 100; ++i)
+    {
+        s.add(i);
+    }
+
+    HashSet<int, int, NewDeleteNodeAllocator> copy{s};
+    EXPECT_EQ(100, copy.size());
+    EXPECT_TRUE(copy.contains(99));
+}
+
+
+TEST(HashSetTests, statisticsDescribeChainsAndLookups)
+{
+    HashSet<int, int, NodePool, CountLookups> s{[](const int& i) { return i < 4 ? 0u : static_cast<unsigned int>(i); }};
+    for (int i = 0; i < 6; ++i)
+    {
+        s.add(i);
+    }
+
+    EXPECT_TRUE(s.contains(0));
+    EXPECT_TRUE(s.contains(3));
+    EXPECT_FALSE(s.contains(10));
+    EXPECT_FALSE(s.contains(8));
+
+    // 0-3 share index 0, each added at the front of its list, so finding
+    // 3 takes one probe and finding 0 takes four.  Looking for 10 searches
+    // that whole list, while 8 lands on an empty one.
+    HashSetStatistics stats = s.statistics();
+    EXPECT_EQ(6, stats.size);
+    EXPECT_EQ(10, stats.capacity);
+    EXPECT_DOUBLE_EQ(0.6, stats.loadFactor);
+    EXPECT_EQ(4, stats.maxChainLength);
+    ASSERT_EQ(5, stats.chainLengthCounts.size());
+    EXPECT_EQ(7, stats.chainLengthCounts[0]);
+    EXPECT_EQ(2, stats.chainLengthCounts[1]);
+    EXPECT_EQ(1, stats.chainLengthCounts[4]);
+    EXPECT_EQ(2, stats.hits);
+    EXPECT_EQ(5, stats.hitProbes);
+    EXPECT_DOUBLE_EQ(2.5, stats.averageProbesPerHit());
+    EXPECT_EQ(2, stats.misses);
+    EXPECT_EQ(4, stats.missProbes);
+    EXPECT_DOUBLE_EQ(2.0, stats.averageProbesPerMiss());
+    EXPECT_EQ(0, stats.resizeCount);
+
+    s.resetStatistics();
+    EXPECT_EQ(0, s.statistics().hits);
+}
+
+
+TEST(HashSetTests, lookupsAreOnlyCountedWhenAskedFor)
+{
+    HashSet<int> s{identityHash};
+    s.add(1);
+    EXPECT_TRUE(s.contains(1));
+    EXPECT_FALSE(s.contains(2));
+
+    HashSetStatistics stats = s.statistics();
+    EXPECT_EQ(0, stats.hits);
+    EXPECT_EQ(0, stats.misses);
+    EXPECT_EQ(0, stats.hitProbes);
+    EXPECT_EQ(1, stats.size);
+
+    HashSet<int, int, NodePool, CountLookups> counted{identityHash};
+    counted.add(1);
+    counted.contains(1);
+    HashSet<int, int, NodePool, CountLookups> moved{std::move(counted)};
+    EXPECT_EQ(1, moved.statistics().hits);
+}
+
+
+TEST(HashSetTests, statisticsCountResizes)
+{
+    HashSet<int> s{identityHash};
+    for (int i = 0; i < 100; ++i)
+    {
+        s.add(i);
+    }
+
+    // The capacity goes 10, 21, 43, 87, 175.
+    HashSetStatistics stats = s.statistics();
+    EXPECT_EQ(4, stats.resizeCount);
+    EXPECT_EQ(175, stats.capacity);
+    EXPECT_EQ(1, stats.maxChainLength);
+    EXPECT_EQ(100, stats.chainLengthCounts[1]);
+    EXPECT_GE(stats.resizeMilliseconds, 0.0);
+}
+
+
+TEST(HashSetTests, reservingRoomAvoidsLaterResizes)
+{
+    HashSet<int> s{identityHash};
+    s.reserve(1000);
+    unsigned int capacity = s.statistics().capacity;
+    EXPECT_EQ(1251, capacity);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        s.add(i);
+    }
+    HashSetStatistics stats = s.statistics();
+    EXPECT_EQ(capacity, stats.capacity);
+    EXPECT_EQ(1, stats.resizeCount);
+
+    s.reserve(10);
+    EXPECT_EQ(capacity, s.statistics().capacity);
+}
+
+
+TEST(HashSetTests, reservingDuringAResizeFinishesIt)
+{
+    HashSet<int> s{identityHash};
+    for (int i = 0; i < 9; ++i)
+    {
+        s.add(i);
+    }
+    s.reserve(100);
+
+    EXPECT_EQ(125, s.statistics().capacity);
+    for (int i = 0; i < 9; ++i)
+    {
+        ASSERT_TRUE(s.isElementAtIndex(i, i));
+        ASSERT_EQ(1, s.elementsAtIndex(i));
+    }
+}
+
+
+TEST(HashSetTests, canBeBuiltFromARange)
+{
+    std::vector<std::string> words{"Boo", "is", "happy", "today", "Boo"};
+    HashSet<std::string> s{words.begin(), words.end(), [](const std::string& s) { return s.size(); }};
+
+    EXPECT_EQ(4, s.size());
+    EXPECT_EQ(HashSet<std::string>::DEFAULT_CAPACITY, s.statistics().capacity);
+    for (const std::string& word : words)
+    {
+        EXPECT_TRUE(s.contains(word));
+    }
+}
+
+
+TEST(HashSetTests, addAllAddsOnlyWhatsMissing)
+{
+    HashSet<int> s{identityHash};
+    s.add(3);
+    std::vector<int> more;
+    for (int i = 0; i < 20; ++i)
+    {
+        more.push_back(i);
+    }
+    s.addAll(more.begin(), more.end());
+
+    // There's room for the 21 elements there might have been, so the one
+    // resize was the reserve() up front.
+    HashSetStatistics stats = s.statistics();
+    EXPECT_EQ(20, s.size());
+    EXPECT_EQ(27, stats.capacity);
+    EXPECT_EQ(1, stats.resizeCount);
+    for (int i = 0; i < 20; ++i)
+    {
+        EXPECT_TRUE(s.contains(i));
+    }
+}
+
+
+TEST(HashSetTests, shrinkingToFitKeepsEveryElement)
+{
+    HashSet<int> s{identityHash};
+    s.reserve(10000);
+    for (int i = 0; i < 100; ++i)
+    {
+        s.add(i * 3);
+    }
+    s.shrink_to_fit();
+
+    EXPECT_EQ(125, s.statistics().capacity);
+    EXPECT_EQ(100, s.size());
+    for (int i = 0; i < 300; ++i)
+    {
+        ASSERT_EQ(i % 3 == 0, s.contains(i));
+    }
+}
+
+
+TEST(HashSetTests, removingUnlinksElementsEvenWhileResizing)
+{
+    HashSet<int> s{identityHash};
+    for (int i = 0; i < 500; ++i)
+    {
+        s.add(i);
+    }
+
+    // The last add() started a resize, so some elements are still in the
+    // old array.
+    for (int i = 0; i < 500; i += 2)
+    {
+        EXPECT_TRUE(s.remove(i));
+        EXPECT_FALSE(s.remove(i));
+    }
+
+    EXPECT_EQ(250, s.size());
+    unsigned int total = 0;
+    for (unsigned int i = 0; i < s.statistics().capacity; ++i)
+    {
+        total += s.elementsAtIndex(i);
+    }
+    EXPECT_EQ(250, total);
+    for (int i = 0; i < 500; ++i)
+    {
+        ASSERT_EQ(i % 2 == 1, s.contains(i));
+    }
+
+    for (int i = 0; i < 500; i += 2)
+    {
+        s.add(i);
+    }
+    EXPECT_EQ(500, s.size());
+}
+
+
+TEST(HashSetTests, canRemoveStringViewsWhenHashingThem)
+{
+    HashSet<std::string, std::string_view> s{[](const std::string_view& v) { return static_cast<unsigned int>(v.size()); }};
+    s.add("BOO");
+    s.add("CAT");
+
+    std::string_view text = "CAT DOG";
+    EXPECT_TRUE(s.remove(text.substr(0, 3)));
+    EXPECT_FALSE(s.remove(text.substr(4)));
+    EXPECT_FALSE(s.contains(std::string{"CAT"}));
+    EXPECT_TRUE(s.contains(std::string{"BOO"}));
+    EXPECT_EQ(1, s.size());
+}
+
+
+TEST(HashSetTests, versionChangesWhenTheElementsDo)
+{
+    HashSet<int> s{identityHash};
+    unsigned long long version = s.version();
+
+    s.add(1);
+    EXPECT_NE(version, s.version());
+    version = s.version();
+
+    s.add(1);
+    s.contains(1);
+    s.remove(2);
+    EXPECT_EQ(version, s.version());
+
+    s.remove(1);
+    EXPECT_NE(version, s.version());
+    version = s.version();
+
+    s.add(2);
+    EXPECT_NE(version, s.version());
+    version = s.version();
+
+    HashSet<int> other{s};
+    s = other;
+    EXPECT_NE(version, s.version());
+}
@@ -0,0 +1,131 @@
+// NodePoolTests.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for NodePool and NodeArena.
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <gtest/gtest.h>
+#include "NodePool.hpp"
+
+
+namespace
+{
+    struct Node
+    {
+        std::string value;
+        Node* next;
+    };
+}
+
+
+TEST(NodePoolTests, nodesMadeInARowAreAdjacent)
+{
+    NodePool<Node> pool;
+    Node* first = pool.create("first", nullptr);
+    Node* second = pool.create("second", first);
+
+    EXPECT_EQ("first", first->value);
+    EXPECT_EQ(first, second->next);
+    EXPECT_EQ(first + 1, second);
+
+    pool.destroy(second);
+    pool.destroy(first);
+}
+
+
+TEST(NodePoolTests, destroyedNodesAreReused)
+{
+    NodePool<Node> pool;
+    Node* first = pool.create("first", nullptr);
+    pool.destroy(first);
+
+    Node* second = pool.create("second", nullptr);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ("second", second->value);
+    pool.destroy(second);
+}
+
+
+TEST(NodePoolTests, slabsGrowUntilTheyReachTheMaximumSize)
+{
+    NodePool<int> pool;
+    int created = 0;
+    unsigned int expectedSlabs = 0;
+    for (unsigned int slabNodes = NodePool<int>::FIRST_SLAB_NODES;
+        slabNodes <= NodePool<int>::MAX_SLAB_NODES; slabNodes *= 2)
+    {
+        for (unsigned int i = 0; i < slabNodes; ++i)
+        {
+            pool.create(created++);
+        }
+        ++expectedSlabs;
+        ASSERT_EQ(expectedSlabs, pool.slabCount());
+    }
+
+    for (unsigned int i = 0; i < NodePool<int>::MAX_SLAB_NODES; ++i)
+    {
+        pool.create(created++);
+    }
+    EXPECT_EQ(expectedSlabs + 1, pool.slabCount());
+
+    pool.releaseAll();
+    EXPECT_EQ(0, pool.slabCount());
+}
+
+
+TEST(NodePoolTests, movingTransfersOwnershipOfTheNodes)
+{
+    NodePool<int> pool;
+    int* node = pool.create(46);
+
+    NodePool<int> moved{std::move(pool)};
+    EXPECT_EQ(0, pool.slabCount());
+    EXPECT_EQ(1, moved.slabCount());
+    EXPECT_EQ(46, *node);
+}
+
+
+TEST(NodePoolTests, arenasHandOutAlignedMemoryOfAnySize)
+{
+    NodeArena arena;
+    unsigned char* previous = nullptr;
+    for (std::size_t size : {1u, 3u, 24u, 7u, 100u})
+    {
+        unsigned char* p = static_cast<unsigned char*>(arena.allocate(size, 8));
+        EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(p) % 8);
+        if (previous != nullptr)
+        {
+            EXPECT_LT(previous, p);
+        }
+        std::fill(p, p + size, 0xab);
+        previous = p;
+    }
+    EXPECT_EQ(1, arena.slabCount());
+
+    void* aligned = arena.allocate(64, 64);
+    EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(aligned) % 64);
+}
+
+
+TEST(NodePoolTests, arenasGiveLargeAllocationsTheirOwnSlabs)
+{
+    NodeArena arena;
+    arena.allocate(16, 8);
+    arena.allocate(NodeArena::MAX_SLAB_BYTES * 2, 8);
+
+    EXPECT_EQ(2, arena.slabCount());
+    EXPECT_GE(arena.slabBytes(), NodeArena::FIRST_SLAB_BYTES + NodeArena::MAX_SLAB_BYTES * 2);
+
+    NodeArena moved{std::move(arena)};
+    EXPECT_EQ(2, moved.slabCount());
+    EXPECT_EQ(0, arena.slabCount());
+
+    moved.releaseAll();
+    EXPECT_EQ(0, moved.slabCount());
+    EXPECT_EQ(0, moved.slabBytes());
+}
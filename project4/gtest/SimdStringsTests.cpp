@@ -0,0 +1,155 @@
+// SimdStringsTests.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the vectorized string functions, which are checked
+// against their scalar equivalents at every length up to a few blocks
+// past the widest SIMD register, so that every combination of full
+// blocks and leftover bytes is covered.
+
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+#include <gtest/gtest.h>
+#include "AVLSet.hpp"
+#include "HashSet.hpp"
+#include "SimdStrings.hpp"
+#include "SkipListSet.hpp"
+
+
+namespace
+{
+    constexpr unsigned int MAX_LENGTH = 100;
+
+
+    int sign(int n)
+    {
+        return n < 0 ? -1 : (n > 0 ? 1 : 0);
+    }
+}
+
+
+TEST(SimdStringsTests, hashMatchesTheScalarHash)
+{
+    for (unsigned int length = 0; length <= MAX_LENGTH; ++length)
+    {
+        std::string s;
+        for (unsigned int i = 0; i < length; ++i)
+        {
+            s.push_back(static_cast<char>('A' + (i * 7) % 26));
+        }
+        ASSERT_EQ(simd::hashStringScalar(s), simd::hashString(s)) << length;
+    }
+}
+
+
+TEST(SimdStringsTests, hashDependsOnEveryCharacterAndTheLength)
+{
+    for (unsigned int length = 1; length <= MAX_LENGTH; ++length)
+    {
+        std::string s(length, 'A');
+        unsigned int hash = simd::hashString(s);
+        for (unsigned int i = 0; i < length; ++i)
+        {
+            std::string changed = s;
+            changed[i] = 'B';
+            ASSERT_NE(hash, simd::hashString(changed)) << length << " " << i;
+        }
+
+        // A trailing zero byte isn't the same as no byte at all.
+        ASSERT_NE(hash, simd::hashString(s + '\0')) << length;
+    }
+}
+
+
+TEST(SimdStringsTests, hashHasNoCollisionsAmongSimilarWords)
+{
+    std::unordered_set<unsigned int> hashes;
+    for (unsigned int i = 0; i < 100000; ++i)
+    {
+        hashes.insert(simd::hashString("WORD" + std::to_string(i)));
+    }
+    EXPECT_GE(hashes.size(), 99990);
+}
+
+
+TEST(SimdStringsTests, comparisonsMatchTheStandardLibrary)
+{
+    for (unsigned int length = 0; length <= MAX_LENGTH; ++length)
+    {
+        std::string s(length, 'M');
+        for (unsigned int i = 0; i <= length; ++i)
+        {
+            // The same but for one character (lower, higher or, past the
+            // end, an extra one), and a copy cut short at i.
+            std::string lower = s, higher = s;
+            if (i < length)
+            {
+                lower[i] = 'A';
+                higher[i] = static_cast<char>(0xe9);
+            }
+            else
+            {
+                higher.push_back('A');
+            }
+            std::string shorter = s.substr(0, i);
+
+            for (const std::string& other : {s, lower, higher, shorter})
+            {
+                ASSERT_EQ(s == other, simd::equal(s, other)) << length << " " << i;
+                ASSERT_EQ(sign(s.compare(other)), sign(simd::compare(s, other))) << length << " " << i;
+                ASSERT_EQ(sign(other.compare(s)), sign(simd::compare(other, s))) << length << " " << i;
+                ASSERT_EQ(other.compare(0, s.size(), s) == 0, simd::startsWith(other, s));
+            }
+
+            ASSERT_EQ(i, simd::commonPrefixLength(s, lower)) << length;
+            ASSERT_EQ(i, simd::commonPrefixLength(s, higher)) << length;
+            ASSERT_EQ(i, simd::commonPrefixLength(shorter, s)) << length;
+        }
+    }
+}
+
+
+TEST(SimdStringsTests, canHashWordsInHashSets)
+{
+    HashSet<std::string, std::string_view> s{simd::hashString};
+    s.add("BOO");
+    s.add("HAPPY");
+
+    EXPECT_TRUE(s.contains(std::string_view{"HAPPY"}));
+    EXPECT_FALSE(s.contains(std::string_view{"HAPP"}));
+}
+
+
+TEST(SimdStringsTests, canOrderAVLSetsAndSkipListSets)
+{
+    std::vector<std::string> words{
+        "PEAR", "APPLE", "A", "APPLESAUCE", "APPLE", "BANANARAMA-BANANARAMA-BANANARAMA", "BANANA", ""};
+
+    AVLSet<std::string, SimdStringCompare> avl;
+    SkipListSet<std::string, SimdStringCompare> skipList;
+    for (const std::string& word : words)
+    {
+        avl.add(word);
+        skipList.add(word);
+    }
+
+    EXPECT_EQ(7, avl.size());
+    EXPECT_EQ(7, skipList.size());
+    for (const std::string& word : words)
+    {
+        EXPECT_TRUE(avl.contains(word));
+        EXPECT_TRUE(skipList.contains(std::string_view{word}));
+    }
+    EXPECT_FALSE(avl.contains(std::string_view{"APPLES"}));
+    EXPECT_FALSE(skipList.contains("BANANARAMA"));
+
+    std::vector<std::string> inorder;
+    avl.inorder([&](const std::string& word) { inorder.push_back(word); });
+    EXPECT_EQ(
+        (std::vector<std::string>{
+            "", "A", "APPLE", "APPLESAUCE", "BANANA", "BANANARAMA-BANANARAMA-BANANARAMA", "PEAR"}),
+        inorder);
+}
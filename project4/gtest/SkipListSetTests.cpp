@@ -0,0 +1,377 @@
+// SkipListSetTests.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for SkipListSet beyond the sanity checks.
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <gtest/gtest.h>
+#include "SkipListSet.hpp"
+
+
+namespace
+{
+    // Sends every key up exactly one level.
+    template <typename ElementType>
+    class TwoLevelTester : public SkipListLevelTester<ElementType>
+    {
+    public:
+        bool shouldOccupyNextLevel(const ElementType&) override
+        {
+            flipped = not flipped;
+            return flipped;
+        }
+
+        std::unique_ptr<SkipListLevelTester<ElementType>> clone() override
+        {
+            return std::make_unique<TwoLevelTester<ElementType>>();
+        }
+
+    private:
+        bool flipped = false;
+    };
+}
+
+
+TEST(SkipListSetTests, canMoveEmplaceAndLookUpViews)
+{
+    SkipListSet<std::string> s{std::make_unique<TwoLevelTester<std::string>>()};
+    std::string word(40, 'A');
+    s.add(std::move(word));
+    s.emplace(3, 'B');
+    s.emplace("CAT");
+
+    std::string_view text = "BBB CAT DOG";
+    EXPECT_EQ(3, s.size());
+    EXPECT_EQ(2, s.levelCount());
+    EXPECT_TRUE(s.isElementOnLevel("CAT", 1));
+    EXPECT_TRUE(s.contains(text.substr(0, 3)));
+    EXPECT_TRUE(s.contains(text.substr(4, 3)));
+    EXPECT_FALSE(s.contains(text.substr(8)));
+    EXPECT_TRUE(s.contains(std::string(40, 'A')));
+}
+
+
+TEST(SkipListSetTests, elementsOccupyEveryLevelOfTheirTowers)
+{
+    SkipListSet<int> s{std::make_unique<TwoLevelTester<int>>()};
+    for (int i = 0; i < 10; ++i)
+    {
+        s.add(i);
+    }
+
+    // Every element's tower is two tall, so it's on both levels.
+    EXPECT_EQ(2, s.levelCount());
+    EXPECT_EQ(10, s.elementsOnLevel(0));
+    EXPECT_EQ(10, s.elementsOnLevel(1));
+    EXPECT_EQ(0, s.elementsOnLevel(2));
+    for (int i = 0; i < 10; ++i)
+    {
+        EXPECT_TRUE(s.isElementOnLevel(i, 0));
+        EXPECT_TRUE(s.isElementOnLevel(i, 1));
+        EXPECT_FALSE(s.isElementOnLevel(i, 2));
+    }
+    EXPECT_FALSE(s.isElementOnLevel(10, 0));
+}
+
+
+TEST(SkipListSetTests, containsExactlyWhatWasAddedInAnyOrder)
+{
+    std::vector<int> numbers;
+    for (int i = 0; i < 5000; ++i)
+    {
+        numbers.push_back(i * 2);
+    }
+    std::shuffle(numbers.begin(), numbers.end(), std::default_random_engine{46});
+
+    SkipListSet<int> s;
+    for (int n : numbers)
+    {
+        s.add(n);
+        s.add(n);
+    }
+
+    EXPECT_EQ(5000, s.size());
+    for (int i = 0; i < 5000; ++i)
+    {
+        ASSERT_TRUE(s.contains(i * 2));
+        ASSERT_FALSE(s.contains(i * 2 + 1));
+    }
+
+    unsigned int total = 0;
+    for (unsigned int level = 0; level < s.levelCount(); ++level)
+    {
+        ASSERT_LE(s.elementsOnLevel(level + 1), s.elementsOnLevel(level));
+        total += s.elementsOnLevel(level);
+    }
+    EXPECT_LT(total, 5000 * 3);
+}
+
+
+TEST(SkipListSetTests, insertionMakesLogarithmicallyManyComparisons)
+{
+    unsigned long long comparisons = 0;
+    auto countingCompare = [&comparisons](int a, int b)
+    {
+        comparisons++;
+        return a < b ? -1 : (a > b ? 1 : 0);
+    };
+
+    // In ascending order, every element goes at the end of every level,
+    // which is where searching each level from its front is slowest.
+    const int count = 100000;
+    SkipListSet<int, decltype(countingCompare)> s{
+        std::make_unique<RandomSkipListLevelTester<int>>(), countingCompare};
+    for (int i = 0; i < count; ++i)
+    {
+        s.add(i);
+    }
+
+    EXPECT_EQ(count, s.size());
+    EXPECT_LT(comparisons, count * 60ull);
+}
+
+
+TEST(SkipListSetTests, copiesAreIndependentAndKeepTheirShape)
+{
+    SkipListSet<std::string> s{std::make_unique<TwoLevelTester<std::string>>()};
+    for (const char* word : {"BOO", "IS", "HAPPY", "TODAY", "AND", "EVERY", "DAY"})
+    {
+        s.add(word);
+    }
+
+    SkipListSet<std::string> copy{s};
+    copy.add("TOMORROW");
+    EXPECT_EQ(7, s.size());
+    EXPECT_EQ(8, copy.size());
+    EXPECT_FALSE(s.contains("TOMORROW"));
+    for (const char* word : {"BOO", "IS", "HAPPY", "TODAY", "AND", "EVERY", "DAY"})
+    {
+        EXPECT_TRUE(copy.contains(word));
+        EXPECT_EQ(s.isElementOnLevel(word, 1), copy.isElementOnLevel(word, 1));
+    }
+
+    SkipListSet<std::string> moved{std::move(copy)};
+    EXPECT_EQ(8, moved.size());
+    EXPECT_TRUE(moved.contains("TOMORROW"));
+
+    s = moved;
+    EXPECT_EQ(8, s.size());
+    moved = SkipListSet<std::string>{};
+    EXPECT_EQ(0, moved.size());
+    EXPECT_EQ(0, moved.levelCount());
+    EXPECT_TRUE(s.contains("TOMORROW"));
+}
+
+
+TEST(SkipListSetTests, iteratorsVisitElementsInAscendingOrder)
+{
+    std::vector<int> numbers;
+    for (int i = 0; i < 1000; ++i)
+    {
+        numbers.push_back(i * 2);
+    }
+    std::shuffle(numbers.begin(), numbers.end(), std::default_random_engine{46});
+
+    SkipListSet<int> s;
+    for (int n : numbers)
+    {
+        s.add(n);
+    }
+
+    std::vector<int> expected;
+    for (int i = 0; i < 1000; ++i)
+    {
+        expected.push_back(i * 2);
+    }
+    EXPECT_EQ(expected, std::vector<int>(s.begin(), s.end()));
+
+    SkipListSet<int> empty;
+    EXPECT_TRUE(empty.begin() == empty.end());
+    EXPECT_TRUE(empty.lowerBound(0) == empty.end());
+}
+
+
+TEST(SkipListSetTests, boundsAndRangesFindTheElementsBetweenKeys)
+{
+    SkipListSet<int> s;
+    for (int i = 0; i < 100; i += 10)
+    {
+        s.add(i);
+    }
+
+    EXPECT_EQ(20, *s.lowerBound(20));
+    EXPECT_EQ(30, *s.upperBound(20));
+    EXPECT_EQ(30, *s.lowerBound(21));
+    EXPECT_EQ(0, *s.lowerBound(-5));
+    EXPECT_TRUE(s.lowerBound(91) == s.end());
+    EXPECT_TRUE(s.upperBound(90) == s.end());
+
+    std::vector<int> found;
+    for (int n : s.range(15, 50))
+    {
+        found.push_back(n);
+    }
+    EXPECT_EQ((std::vector<int>{20, 30, 40}), found);
+    EXPECT_TRUE(s.range(50, 15).empty());
+}
+
+
+TEST(SkipListSetTests, viewsCanBoundAPrefixScan)
+{
+    SkipListSet<std::string> s;
+    for (const char* word : {"CAR", "CART", "CARTON", "CAT", "CARD", "BOO", "DOG"})
+    {
+        s.add(word);
+    }
+
+    std::string_view text = "CARS";
+    std::vector<std::string> found;
+    for (const std::string& word : s.range(text.substr(0, 3), std::string_view{"CAS"}))
+    {
+        found.push_back(word);
+    }
+    EXPECT_EQ((std::vector<std::string>{"CAR", "CARD", "CART", "CARTON"}), found);
+}
+
+
+TEST(SkipListSetTests, fromSortedBuildsEveryLevelInOrder)
+{
+    std::vector<int> numbers;
+    for (int i = 0; i < 10; ++i)
+    {
+        numbers.push_back(i);
+        numbers.push_back(i);
+    }
+
+    SkipListSet<int> s = SkipListSet<int>::fromSorted(
+        numbers.begin(), numbers.end(), std::make_unique<TwoLevelTester<int>>());
+
+    EXPECT_EQ(10, s.size());
+    EXPECT_EQ(2, s.levelCount());
+    EXPECT_EQ(10, s.elementsOnLevel(0));
+    EXPECT_EQ(10, s.elementsOnLevel(1));
+    for (int i = 0; i < 10; ++i)
+    {
+        EXPECT_TRUE(s.isElementOnLevel(i, 1));
+    }
+    EXPECT_EQ((std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}), std::vector<int>(s.begin(), s.end()));
+
+    s.add(-1);
+    s.add(20);
+    EXPECT_EQ(-1, *s.begin());
+    EXPECT_EQ(20, *s.upperBound(9));
+}
+
+
+TEST(SkipListSetTests, fromSortedAddsElementsThatAreOutOfOrderAnyway)
+{
+    std::vector<std::string> words{"AND", "BOO", "DAY", "CAT", "EVERY", "ANT", "HAPPY"};
+    SkipListSet<std::string> s = SkipListSet<std::string>::fromSorted(words.begin(), words.end());
+
+    EXPECT_EQ(7, s.size());
+    EXPECT_EQ(
+        (std::vector<std::string>{"AND", "ANT", "BOO", "CAT", "DAY", "EVERY", "HAPPY"}),
+        std::vector<std::string>(s.begin(), s.end()));
+
+    unsigned int total = 0;
+    for (unsigned int level = 0; level < s.levelCount(); ++level)
+    {
+        total += s.elementsOnLevel(level);
+    }
+    EXPECT_GE(total, 7);
+}
+
+
+TEST(SkipListSetTests, removingUnlinksElementsFromEveryLevel)
+{
+    SkipListSet<int> s{std::make_unique<TwoLevelTester<int>>()};
+    for (int i = 0; i < 10; ++i)
+    {
+        s.add(i);
+    }
+
+    EXPECT_TRUE(s.remove(4));
+    EXPECT_FALSE(s.remove(4));
+    EXPECT_FALSE(s.isElementOnLevel(4, 0));
+    EXPECT_EQ(9, s.elementsOnLevel(0));
+    EXPECT_EQ(9, s.elementsOnLevel(1));
+    EXPECT_EQ((std::vector<int>{0, 1, 2, 3, 5, 6, 7, 8, 9}), std::vector<int>(s.begin(), s.end()));
+
+    for (int i = 0; i < 10; ++i)
+    {
+        s.remove(i);
+    }
+    EXPECT_EQ(0, s.size());
+    EXPECT_EQ(0, s.levelCount());
+
+    // Removed nodes' memory is reused.
+    s.add(46);
+    EXPECT_TRUE(s.contains(46));
+    EXPECT_EQ(2, s.levelCount());
+}
+
+
+TEST(SkipListSetTests, removingAndAddingMatchesAStdSet)
+{
+    SkipListSet<std::string> s;
+    std::set<std::string> expected;
+    std::default_random_engine engine{46};
+    std::uniform_int_distribution<int> number{0, 999};
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        std::string word = std::to_string(number(engine));
+        if (i % 3 == 0)
+        {
+            ASSERT_EQ(expected.erase(word) == 1, s.remove(std::string_view{word}));
+        }
+        else
+        {
+            s.add(word);
+            expected.insert(word);
+        }
+    }
+
+    EXPECT_EQ(expected.size(), s.size());
+    EXPECT_EQ(std::vector<std::string>(expected.begin(), expected.end()),
+        std::vector<std::string>(s.begin(), s.end()));
+
+    SkipListSet<std::string> copy{s};
+    EXPECT_EQ(s.size(), copy.size());
+}
+
+
+TEST(SkipListSetTests, versionChangesWhenTheElementsDo)
+{
+    SkipListSet<int> s;
+    unsigned long long version = s.version();
+
+    s.add(1);
+    EXPECT_NE(version, s.version());
+    version = s.version();
+
+    s.add(1);
+    s.contains(1);
+    s.remove(2);
+    EXPECT_EQ(version, s.version());
+
+    s.remove(1);
+    EXPECT_NE(version, s.version());
+    version = s.version();
+
+    s.add(2);
+    EXPECT_NE(version, s.version());
+    version = s.version();
+
+    SkipListSet<int> other{s};
+    s = other;
+    EXPECT_NE(version, s.version());
+}
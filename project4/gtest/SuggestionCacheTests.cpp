@@ -0,0 +1,156 @@
+// SuggestionCacheTests.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for SuggestionCache, and for WordChecker when it has one.
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "HashFunctions.hpp"
+#include "HashSet.hpp"
+#include "SuggestionCache.hpp"
+#include "WordChecker.hpp"
+
+
+TEST(SuggestionCacheTests, findsWhatWasInsertedAndCountsHitsAndMisses)
+{
+    SuggestionCache cache{10};
+    std::vector<std::string> suggestions;
+
+    EXPECT_FALSE(cache.find("CAY", 1, suggestions));
+    cache.insert("CAY", 1, {"CAT", "CAY"});
+    ASSERT_TRUE(cache.find("CAY", 1, suggestions));
+    EXPECT_EQ((std::vector<std::string>{"CAT", "CAY"}), suggestions);
+
+    SuggestionCacheStatistics stats = cache.statistics();
+    EXPECT_EQ(1, stats.size);
+    EXPECT_EQ(10, stats.capacity);
+    EXPECT_EQ(1, stats.hits);
+    EXPECT_EQ(1, stats.misses);
+    EXPECT_DOUBLE_EQ(0.5, stats.hitRate());
+}
+
+
+TEST(SuggestionCacheTests, evictsTheLeastRecentlyUsedWord)
+{
+    SuggestionCache cache{2, 1};
+    std::vector<std::string> suggestions;
+
+    cache.insert("A", 1, {"1"});
+    cache.insert("B", 1, {"2"});
+    ASSERT_TRUE(cache.find("A", 1, suggestions));
+    cache.insert("C", 1, {"3"});
+
+    EXPECT_TRUE(cache.find("A", 1, suggestions));
+    EXPECT_FALSE(cache.find("B", 1, suggestions));
+    EXPECT_TRUE(cache.find("C", 1, suggestions));
+    EXPECT_EQ(1, cache.statistics().evictions);
+    EXPECT_EQ(2, cache.statistics().size);
+}
+
+
+TEST(SuggestionCacheTests, ignoresEntriesWithAnotherStampUntilReplaced)
+{
+    SuggestionCache cache{10};
+    std::vector<std::string> suggestions;
+
+    cache.insert("CAY", 1, {"CAT"});
+    EXPECT_FALSE(cache.find("CAY", 2, suggestions));
+    EXPECT_EQ(1, cache.statistics().stale);
+
+    cache.insert("CAY", 2, {"CAT", "CAY"});
+    ASSERT_TRUE(cache.find("CAY", 2, suggestions));
+    EXPECT_EQ(2, suggestions.size());
+    EXPECT_EQ(1, cache.statistics().size);
+
+    cache.clear();
+    EXPECT_FALSE(cache.find("CAY", 2, suggestions));
+    EXPECT_EQ(0, cache.statistics().size);
+}
+
+
+TEST(SuggestionCacheTests, wordCheckerSeesWordsAddedAfterItCached)
+{
+    HashSet<std::string> set{hashing::wyhashString};
+    set.add("CAT");
+
+    SuggestionCache cache{100};
+    WordChecker checker{set};
+    checker.setCache(&cache, [&set]() { return set.version(); });
+
+    EXPECT_EQ((std::vector<std::string>{"CAT"}), checker.findSuggestions("CAY"));
+    EXPECT_EQ((std::vector<std::string>{"CAT"}), checker.findSuggestions("CAY"));
+    EXPECT_EQ(1, cache.statistics().hits);
+
+    set.add("CAB");
+    EXPECT_EQ((std::vector<std::string>{"CAB", "CAT"}), checker.findSuggestions("CAY"));
+}
+
+
+TEST(SuggestionCacheTests, wordCheckerSeesChangesThatKeepTheSize)
+{
+    HashSet<std::string> set{hashing::wyhashString};
+    set.add("CAT");
+    set.add("DOG");
+
+    SuggestionCache cache{100};
+    WordChecker checker{set};
+    checker.setCache(&cache, [&set]() { return set.version(); });
+    EXPECT_EQ((std::vector<std::string>{"CAT"}), checker.findSuggestions("CAY"));
+
+    // A remove and an add leave the size as it was.
+    set.remove("CAT");
+    set.add("BAY");
+    EXPECT_EQ((std::vector<std::string>{"BAY"}), checker.findSuggestions("CAY"));
+
+    set.add("CAT");
+    set.remove("BAY");
+    EXPECT_EQ((std::vector<std::string>{"CAT"}), checker.findSuggestions("CAY"));
+
+    EXPECT_THROW(checker.setCache(&cache), std::invalid_argument);
+    checker.setCache(nullptr);
+    EXPECT_EQ((std::vector<std::string>{"CAT"}), checker.findSuggestions("CAY"));
+}
+
+
+TEST(SuggestionCacheTests, canBeSharedByManyThreads)
+{
+    std::vector<std::string> dictionary;
+    for (int i = 0; i < 1000; ++i)
+    {
+        dictionary.push_back("WORD" + std::to_string(i));
+    }
+    HashSet<std::string> set{dictionary.begin(), dictionary.end(), hashing::wyhashString};
+
+    SuggestionCache cache{50};
+    WordChecker checker{set};
+    checker.setCache(&cache, [&set]() { return set.version(); });
+    WordChecker uncached{set};
+
+    std::vector<std::thread> threads;
+    std::vector<int> mismatches(4, 0);
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&, t]()
+        {
+            for (int i = 0; i < 2000; ++i)
+            {
+                std::string typo = "WROD" + std::to_string((i * (t + 1)) % 200);
+                mismatches[t] += checker.findSuggestions(typo) != uncached.findSuggestions(typo);
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ((std::vector<int>{0, 0, 0, 0}), mismatches);
+    SuggestionCacheStatistics stats = cache.statistics();
+    EXPECT_EQ(8000, stats.hits + stats.misses);
+    EXPECT_LE(stats.size, stats.capacity);
+}
@@ -0,0 +1,164 @@
+// TrieTests.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for Trie, and for WordChecker when its words are in one.
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <gtest/gtest.h>
+#include "CrowdedWords.hpp"
+#include "HashFunctions.hpp"
+#include "HashSet.hpp"
+#include "Trie.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    // The optimal string alignment distance, computed the usual way.
+    unsigned int distance(std::string_view a, std::string_view b)
+    {
+        std::vector<std::vector<unsigned int>> d(a.size() + 1, std::vector<unsigned int>(b.size() + 1));
+        for (std::size_t i = 0; i <= a.size(); ++i)
+        {
+            for (std::size_t j = 0; j <= b.size(); ++j)
+            {
+                if (i == 0 || j == 0)
+                {
+                    d[i][j] = i + j;
+                    continue;
+                }
+                d[i][j] = std::min({d[i - 1][j] + 1, d[i][j - 1] + 1, d[i - 1][j - 1] + (a[i - 1] != b[j - 1])});
+                if (i >= 2 && j >= 2 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1])
+                {
+                    d[i][j] = std::min(d[i][j], d[i - 2][j - 2] + 1);
+                }
+            }
+        }
+        return d[a.size()][b.size()];
+    }
+}
+
+
+TEST(TrieTests, containsOnlyWordsNotTheirPrefixes)
+{
+    Trie t;
+    t.add("CAR");
+    t.add("CART");
+    t.add("CAR");
+    t.add("DOG");
+
+    EXPECT_EQ(3, t.size());
+    EXPECT_TRUE(t.contains("CAR"));
+    EXPECT_TRUE(t.contains(std::string_view{"CART"}));
+    EXPECT_FALSE(t.contains("CA"));
+    EXPECT_FALSE(t.contains("CARTS"));
+    EXPECT_FALSE(t.contains(""));
+    EXPECT_FALSE(t.contains("BAT"));
+
+    t.add("");
+    EXPECT_TRUE(t.contains(""));
+    EXPECT_EQ(4, t.size());
+}
+
+
+TEST(TrieTests, sharesNodesForSharedPrefixes)
+{
+    Trie t{{"TEA", "TEN", "TO", "TOO"}};
+
+    // The root, T, E, A, N, O and the second O.
+    EXPECT_EQ(7, t.nodeCount());
+}
+
+
+TEST(TrieTests, withinDistanceFindsExactlyTheCloseWordsInOrder)
+{
+    std::vector<std::string> words = crowdedWords(500);
+    Trie t{words};
+
+    std::sort(words.begin(), words.end());
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+
+    for (const std::string& s : crowdedWords(60))
+    {
+        for (unsigned int maxDistance : {0u, 1u, 2u})
+        {
+            std::vector<std::string> expected;
+            for (const std::string& word : words)
+            {
+                if (distance(s, word) <= maxDistance)
+                {
+                    expected.push_back(word);
+                }
+            }
+            ASSERT_EQ(expected, t.withinDistance(s, maxDistance)) << s << " " << maxDistance;
+        }
+    }
+}
+
+
+TEST(TrieTests, canAddToATrieBuiltFromWords)
+{
+    Trie t{{"TEA", "TEN", "TO"}};
+    t.add("TOO");
+    t.add("TEAM");
+    t.add("A");
+
+    EXPECT_EQ(6, t.size());
+    EXPECT_TRUE(t.contains("TEAM"));
+    EXPECT_TRUE(t.contains("TEN"));
+    EXPECT_EQ((std::vector<std::string>{"TEA", "TEAM", "TEN"}), t.withinDistance("TEA", 1));
+}
+
+
+TEST(TrieTests, withinDistanceCountsSwapsAsOneEdit)
+{
+    Trie t{{"ABCD", "BACD"}};
+
+    EXPECT_EQ((std::vector<std::string>{"ABCD"}), t.withinDistance("ABDC", 1));
+    EXPECT_EQ((std::vector<std::string>{"ABCD", "BACD"}), t.withinDistance("ABDC", 2));
+    EXPECT_EQ((std::vector<std::string>{}), t.withinDistance("", 2));
+}
+
+
+TEST(TrieTests, withinDistanceOfTheEmptyStringFindsOnlyShortWords)
+{
+    Trie t{{"A", "B"}};
+
+    EXPECT_EQ((std::vector<std::string>{}), t.withinDistance("", 0));
+    EXPECT_EQ((std::vector<std::string>{"A", "B"}), t.withinDistance("", 1));
+
+    t.add("");
+    EXPECT_EQ((std::vector<std::string>{""}), t.withinDistance("", 0));
+}
+
+
+TEST(TrieTests, wordCheckerFindsTheSameSuggestionsAsWithOtherSets)
+{
+    std::vector<std::string> words = crowdedWords(300);
+    Trie t{words};
+    HashSet<std::string> h{words.begin(), words.end(), hashing::wyhashString};
+
+    WordChecker fromTrie{t};
+    WordChecker fromHashSet{h};
+
+    for (const std::string& s : crowdedWords(100))
+    {
+        std::vector<std::string> expected = fromHashSet.findSuggestions(s);
+        std::vector<std::string> actual = fromTrie.findSuggestions(s);
+
+        // Splits come first either way.
+        auto notSplit = [](const std::string& suggestion) { return suggestion.find(' ') == std::string::npos; };
+        ASSERT_TRUE(std::is_partitioned(actual.begin(), actual.end(), [&](const std::string& x) { return not notSplit(x); }));
+        ASSERT_TRUE(std::is_sorted(std::find_if(actual.begin(), actual.end(), notSplit), actual.end()));
+
+        std::sort(expected.begin(), expected.end());
+        expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+        std::sort(actual.begin(), actual.end());
+        ASSERT_EQ(expected, actual) << s;
+    }
+}
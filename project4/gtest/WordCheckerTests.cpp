@@ -0,0 +1,181 @@
+// WordCheckerTests.cpp
+//
+// ICS 46 Spring 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for WordChecker's suggestions, beyond the sanity checks.
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "HashFunctions.hpp"
+#include "HashSet.hpp"
+#include "VectorSet.hpp"
+#include "WordChecker.hpp"
+
+
+TEST(WordCheckerTests, emptyAndOneLetterWordsHaveSuggestions)
+{
+    VectorSet<std::string> set;
+    set.add("A");
+    set.add("I");
+
+    WordChecker checker{set};
+
+    EXPECT_EQ((std::vector<std::string>{"A", "I"}), checker.findSuggestions(""));
+    EXPECT_EQ((std::vector<std::string>{"A", "I"}), checker.findSuggestions("X"));
+}
+
+
+TEST(WordCheckerTests, suggestionsComeInTheOrderTheyAreTried)
+{
+    VectorSet<std::string> set;
+    for (const char* word : {"BAT", "CAT", "CART", "ACT", "AT", "C"})
+    {
+        set.add(word);
+    }
+
+    WordChecker checker{set};
+
+    // Splits, then replacements, insertions, swaps and deletions.
+    EXPECT_EQ((std::vector<std::string>{"C AT", "BAT", "CAT", "CART", "ACT", "AT"}),
+        checker.findSuggestions("CAT"));
+}
+
+
+TEST(WordCheckerTests, suggestionsFoundMoreThanOnceAreListedOnce)
+{
+    VectorSet<std::string> set;
+    set.add("CAT");
+    set.add("EAT");
+
+    WordChecker checker{set};
+
+    // Replacing any of CAT's letters with itself gives CAT, with EAT
+    // found in between.
+    EXPECT_EQ((std::vector<std::string>{"CAT", "EAT"}), checker.findSuggestions("CAT"));
+}
+
+
+TEST(WordCheckerTests, bestSuggestionsAreRankedByKindOfTypo)
+{
+    VectorSet<std::string> set;
+    for (const char* word : {"C", "AT", "ACT", "BAT", "CART"})
+    {
+        set.add(word);
+    }
+
+    WordChecker checker{set};
+
+    EXPECT_EQ((std::vector<std::string>{"ACT", "BAT", "CART", "AT", "C AT"}), checker.findBestSuggestions("CAT", 10));
+    EXPECT_EQ((std::vector<std::string>{"ACT", "BAT"}), checker.findBestSuggestions("CAT", 2));
+    EXPECT_TRUE(checker.findBestSuggestions("CAT", 0).empty());
+}
+
+
+TEST(WordCheckerTests, bestSuggestionsFavorCommonWords)
+{
+    VectorSet<std::string> set;
+    for (const char* word : {"BAT", "HAT", "RAT", "EAT"})
+    {
+        set.add(word);
+    }
+
+    WordChecker checker{set};
+    checker.setFrequencies([](const std::string& word)
+    {
+        return word == "EAT" ? 100.0 : word == "RAT" ? 10.0 : 1.0;
+    });
+
+    // Ties keep the order findSuggestions() found them in.
+    EXPECT_EQ((std::vector<std::string>{"EAT", "RAT", "BAT", "HAT"}), checker.findBestSuggestions("FAT", 4));
+    EXPECT_EQ((std::vector<std::string>{"EAT"}), checker.findBestSuggestions("FAT", 1));
+}
+
+
+TEST(WordCheckerTests, longWordsChangeInPlaceCorrectly)
+{
+    VectorSet<std::string> set;
+    set.add("CHARACTERISTICALLY");
+    set.add("UNCHARACTERISTICALLY");
+
+    WordChecker checker{set};
+
+    EXPECT_EQ((std::vector<std::string>{"CHARACTERISTICALLY"}), checker.findSuggestions("CHARACTERISTICALY"));
+    EXPECT_EQ((std::vector<std::string>{"CHARACTERISTICALLY"}), checker.findSuggestions("CHARACTERISTCIALLY"));
+    EXPECT_EQ((std::vector<std::string>{"UNCHARACTERISTICALLY"}), checker.findSuggestions("UNCHARACTERISTICALLLY"));
+}
+
+
+TEST(WordCheckerTests, checkWordsChecksEachDistinctWordOnceInOrder)
+{
+    VectorSet<std::string> set;
+    set.add("THE");
+    set.add("CAT");
+    set.add("SAT");
+
+    WordChecker checker{set};
+
+    std::vector<WordCheck> checks = checker.checkWords({"THE", "CAT", "SAT", "THE", "CAY", "CAY", "THE"}, 1);
+
+    ASSERT_EQ(4, checks.size());
+    EXPECT_EQ("THE", checks[0].word);
+    EXPECT_EQ(3, checks[0].occurrences);
+    EXPECT_TRUE(checks[0].exists);
+    EXPECT_TRUE(checks[0].suggestions.empty());
+    EXPECT_EQ("CAT", checks[1].word);
+    EXPECT_EQ("SAT", checks[2].word);
+    EXPECT_EQ("CAY", checks[3].word);
+    EXPECT_EQ(2, checks[3].occurrences);
+    EXPECT_FALSE(checks[3].exists);
+    EXPECT_EQ((std::vector<std::string>{"CAT"}), checks[3].suggestions);
+}
+
+
+TEST(WordCheckerTests, checkWordsGivesTheSameResultsOnAnyNumberOfThreads)
+{
+    std::vector<std::string> dictionary;
+    std::vector<std::string> document;
+    for (int i = 0; i < 2000; ++i)
+    {
+        dictionary.push_back("WORD" + std::to_string(i));
+        document.push_back("WORD" + std::to_string(i % 2500));
+        document.push_back("WROD" + std::to_string(i % 300));
+    }
+    HashSet<std::string> set{dictionary.begin(), dictionary.end(), hashing::wyhashString};
+
+    WordChecker checker{set};
+    std::vector<WordCheck> expected = checker.checkWords(document, 1);
+
+    for (unsigned int threadCount : {0u, 2u, 8u})
+    {
+        std::vector<WordCheck> checks = checker.checkWords(document, threadCount);
+        ASSERT_EQ(expected.size(), checks.size());
+        for (std::size_t i = 0; i < checks.size(); ++i)
+        {
+            ASSERT_EQ(expected[i].word, checks[i].word);
+            ASSERT_EQ(expected[i].occurrences, checks[i].occurrences);
+            ASSERT_EQ(expected[i].exists, checks[i].exists);
+            ASSERT_EQ(checker.wordExists(checks[i].word), checks[i].exists);
+            ASSERT_EQ(expected[i].suggestions, checks[i].suggestions);
+        }
+    }
+}
+
+
+TEST(WordCheckerTests, checkWordsCanReadAStream)
+{
+    VectorSet<std::string> set;
+    set.add("HELLO");
+
+    WordChecker checker{set};
+    std::istringstream in{"HELLO  HELO\nHELLO\n"};
+
+    std::vector<WordCheck> checks = checker.checkWords(in, 2);
+
+    ASSERT_EQ(2, checks.size());
+    EXPECT_EQ(2, checks[0].occurrences);
+    EXPECT_EQ("HELO", checks[1].word);
+    EXPECT_EQ((std::vector<std::string>{"HELLO"}), checks[1].suggestions);
+}
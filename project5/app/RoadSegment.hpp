@@ -7,6 +7,11 @@
 // about a segment of road, namely the distance (in miles) that the
 // segment spans and the speed (in miles per hour) that traffic is
 // currently travelling on that road.
+//
+// A segment may also name a shared SpeedProfile (see SpeedProfile.hpp),
+// in which case milesPerHour is its free-flow speed and the profile scales
+// it by time of day.  SpeedProfileTable::NO_PROFILE means the speed is
+// constant.
 
 #ifndef ROADSEGMENT_HPP
 #define ROADSEGMENT_HPP
@@ -17,6 +22,7 @@ struct RoadSegment
 {
     double miles;
     double milesPerHour;
+    int speedProfile = -1;
 };
 
 
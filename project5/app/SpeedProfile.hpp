@@ -0,0 +1,267 @@
+// SpeedProfile.hpp
+//
+// ICS 46 Spring 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// A SpeedProfile describes how the speed of traffic on a road varies over
+// the course of a day.  It is a piecewise-linear function from the time of
+// day (in hours, from 0 up to 24) to a "speed factor" that scales a road's
+// free-flow milesPerHour; between breakpoints the factor is interpolated
+// linearly, and the profile wraps around at midnight.
+//
+// Most roads follow one of a handful of traffic patterns, so profiles are
+// stored once in a SpeedProfileTable and each RoadSegment refers to one by
+// its index, rather than every segment carrying its own copy.
+
+#ifndef SPEEDPROFILE_HPP
+#define SPEEDPROFILE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "RoadSegment.hpp"
+
+
+
+struct SpeedBreakpoint
+{
+    double hour;
+    double speedFactor;
+};
+
+
+
+class SpeedProfile
+{
+public:
+    static constexpr double HOURS_PER_DAY = 24.0;
+
+    // Initializes a SpeedProfile from its breakpoints, which must be
+    // nonempty, have distinct hours in [0, 24), and have positive speed
+    // factors; otherwise, a std::invalid_argument is thrown.  They don't
+    // need to be given in order.
+    explicit SpeedProfile(std::vector<SpeedBreakpoint> breakpoints);
+
+    // speedFactorAt() returns the speed factor at the given time, which
+    // can be any number of hours (e.g., 30.0 is 6am on the second day).
+    double speedFactorAt(double hour) const;
+
+    // travelTime() returns the number of hours it takes to drive the given
+    // number of miles, leaving at the given time, on a road whose free-flow
+    // speed is milesPerHour.  The speed is integrated over the trip, so the
+    // result respects FIFO: leaving later never means arriving earlier.
+    // A trip that can never end -- at a speed that isn't positive, or over
+    // a distance or from a time that isn't finite -- takes infinitely long,
+    // as it would at a constant speed.
+    double travelTime(double miles, double milesPerHour, double departureHour) const;
+
+private:
+    std::vector<SpeedBreakpoint> breakpoints;
+
+    // Finds the linear piece containing the given absolute time, returning
+    // the index of the breakpoint that starts it and the absolute time at
+    // which that breakpoint's day starts.
+    void find_piece(double hour, unsigned int& index, double& day_start) const;
+
+    // Returns the absolute start and end times of the piece that starts at
+    // the given breakpoint on the given day, and the factors at both ends.
+    void piece_bounds(unsigned int index, double day_start, double& start_hour,
+        double& end_hour, double& start_factor, double& end_factor) const;
+};
+
+
+
+class SpeedProfileTable
+{
+public:
+    static constexpr int NO_PROFILE = -1;
+
+    // addProfile() stores a profile in the table and returns the index
+    // that RoadSegments should use to refer to it.
+    int addProfile(const SpeedProfile& profile);
+
+    // profileCount() returns the number of profiles in the table.
+    int profileCount() const noexcept;
+
+    // travelTime() returns the number of hours it takes to drive the given
+    // segment, leaving at the given time.  Segments without a profile are
+    // driven at a constant milesPerHour.  If the segment names a profile
+    // that isn't in the table, a std::out_of_range is thrown.
+    double travelTime(const RoadSegment& segment, double departureHour) const;
+
+private:
+    std::vector<SpeedProfile> profiles;
+};
+
+
+
+inline SpeedProfile::SpeedProfile(std::vector<SpeedBreakpoint> breakpoints)
+    : breakpoints{std::move(breakpoints)}
+{
+    if(this->breakpoints.empty())
+    {
+        throw std::invalid_argument{"SpeedProfile needs at least one breakpoint"};
+    }
+
+    std::sort(this->breakpoints.begin(), this->breakpoints.end(),
+        [](const SpeedBreakpoint& a, const SpeedBreakpoint& b) {return a.hour < b.hour;});
+
+    for(unsigned int i = 0; i < this->breakpoints.size(); i++)
+    {
+        const SpeedBreakpoint& b = this->breakpoints[i];
+        if(b.hour < 0.0 || b.hour >= HOURS_PER_DAY || b.speedFactor <= 0.0
+            || (i > 0 && b.hour == this->breakpoints[i-1].hour))
+        {
+            throw std::invalid_argument{"SpeedProfile breakpoint out of range"};
+        }
+    }
+}
+
+
+inline double SpeedProfile::speedFactorAt(double hour) const
+{
+    unsigned int index;
+    double day_start;
+    find_piece(hour, index, day_start);
+
+    double start_hour, end_hour, start_factor, end_factor;
+    piece_bounds(index, day_start, start_hour, end_hour, start_factor, end_factor);
+
+    if(end_hour <= start_hour)
+    {
+        return start_factor;
+    }
+    return start_factor + (end_factor - start_factor) * (hour - start_hour) / (end_hour - start_hour);
+}
+
+
+inline double SpeedProfile::travelTime(double miles, double milesPerHour, double departureHour) const
+{
+    // Written so that NaNs fail the test, too.  Any of these would keep
+    // the loop below from ever covering the distance.
+    if(!(milesPerHour > 0.0) || !std::isfinite(miles) || !std::isfinite(departureHour))
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    double remaining = miles;
+    double now = departureHour;
+
+    // The piece containing the departure time is found by searching, but
+    // after that we step from one breakpoint to the next by index.  Finding
+    // each piece again from the current time would be subject to rounding:
+    // now - day_start can land just short of the breakpoint we've reached,
+    // bringing back the piece we just finished, which never ends the loop.
+    unsigned int index;
+    double day_start;
+    find_piece(now, index, day_start);
+
+    while(remaining > 0.0)
+    {
+        double start_hour, end_hour, start_factor, end_factor;
+        piece_bounds(index, day_start, start_hour, end_hour, start_factor, end_factor);
+
+        double piece_hours = end_hour - now;
+
+        if(piece_hours > 0.0)
+        {
+            // Within one piece the speed is linear in time, v(t) = speed + slope * t,
+            // so the distance covered in t hours is speed * t + slope * t^2 / 2.
+            double slope = milesPerHour * (end_factor - start_factor) / (end_hour - start_hour);
+            double speed = milesPerHour * start_factor + slope * (now - start_hour);
+            double piece_miles = speed * piece_hours + slope * piece_hours * piece_hours / 2.0;
+
+            if(piece_miles >= remaining)
+            {
+                if(std::abs(slope) < 1e-12)
+                {
+                    now += remaining / speed;
+                }
+                else
+                {
+                    now += (std::sqrt(speed * speed + 2.0 * slope * remaining) - speed) / slope;
+                }
+                break;
+            }
+
+            remaining -= piece_miles;
+            now = end_hour;
+        }
+
+        if(++index == breakpoints.size())
+        {
+            index = 0;
+            day_start += HOURS_PER_DAY;
+        }
+    }
+
+    return now - departureHour;
+}
+
+
+inline void SpeedProfile::find_piece(double hour, unsigned int& index, double& day_start) const
+{
+    day_start = std::floor(hour / HOURS_PER_DAY) * HOURS_PER_DAY;
+    double time_of_day = hour - day_start;
+
+    auto after = std::upper_bound(breakpoints.begin(), breakpoints.end(), time_of_day,
+        [](double h, const SpeedBreakpoint& b) {return h < b.hour;});
+
+    // Before the first breakpoint of the day, we're still on the piece
+    // that started at the last breakpoint of the previous day.
+    if(after == breakpoints.begin())
+    {
+        index = breakpoints.size() - 1;
+        day_start -= HOURS_PER_DAY;
+    }
+    else
+    {
+        index = (after - breakpoints.begin()) - 1;
+    }
+}
+
+
+inline void SpeedProfile::piece_bounds(unsigned int index, double day_start, double& start_hour,
+    double& end_hour, double& start_factor, double& end_factor) const
+{
+    const SpeedBreakpoint& first = breakpoints[index];
+    bool wraps = index + 1 == breakpoints.size();
+    const SpeedBreakpoint& second = wraps ? breakpoints.front() : breakpoints[index + 1];
+
+    // The end of the last piece of one day is computed the same way as the
+    // start of the first piece of the next, so that the two agree exactly.
+    start_hour = day_start + first.hour;
+    end_hour = (wraps ? day_start + HOURS_PER_DAY : day_start) + second.hour;
+    start_factor = first.speedFactor;
+    end_factor = second.speedFactor;
+}
+
+
+inline int SpeedProfileTable::addProfile(const SpeedProfile& profile)
+{
+    profiles.push_back(profile);
+    return profiles.size() - 1;
+}
+
+
+inline int SpeedProfileTable::profileCount() const noexcept
+{
+    return profiles.size();
+}
+
+
+inline double SpeedProfileTable::travelTime(const RoadSegment& segment, double departureHour) const
+{
+    if(segment.speedProfile == NO_PROFILE)
+    {
+        return segment.miles / segment.milesPerHour;
+    }
+    return profiles.at(segment.speedProfile).travelTime(segment.miles, segment.milesPerHour, departureHour);
+}
+
+
+
+#endif
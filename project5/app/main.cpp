@@ -37,6 +37,64 @@ namespace
         }
         
     }
+
+
+    // trace_route() follows the predecessor map returned by findShortestPaths()
+    // back from the end vertex, producing the same ("from", "to") edge sequence
+    // that findKShortestPaths() returns for each of its routes.
+    std::vector<std::pair<int, int>> trace_route(const std::map<int, int>& predecessors, int start_vertex, int end_vertex)
+    {
+        std::stack<std::pair<int, int>> reversed_route;
+        int curr_vertex = end_vertex;
+        while(curr_vertex != start_vertex)
+        {
+            reversed_route.push(std::make_pair(predecessors.at(curr_vertex), curr_vertex));
+            curr_vertex = predecessors.at(curr_vertex);
+        }
+
+        std::vector<std::pair<int, int>> route;
+        while(not reversed_route.empty())
+        {
+            route.push_back(reversed_route.top());
+            reversed_route.pop();
+        }
+        return route;
+    }
+
+
+    void print_distance_route(const RoadMap& roadmap, int start_vertex, const std::vector<std::pair<int, int>>& route)
+    {
+        double total_dist = 0.0;
+        std::cout << "  Begin at " << roadmap.vertexInfo(start_vertex) << std::endl;
+        for(const auto& [from_vertex, to_vertex]: route)
+        {
+            RoadSegment curr_road = roadmap.edgeInfo(from_vertex, to_vertex);
+            std::cout << "  Continue to " << roadmap.vertexInfo(to_vertex);
+            printf(" (%.1f miles)\n", curr_road.miles);
+            total_dist+=curr_road.miles;
+        }
+        printf("Total distance: %.1f miles\n", total_dist);
+    }
+
+
+    void print_time_route(const RoadMap& roadmap, int start_vertex, const std::vector<std::pair<int, int>>& route)
+    {
+        double total_time = 0.0;
+        double time;
+        std::cout << "  Begin at " << roadmap.vertexInfo(start_vertex) << std::endl;
+        for(const auto& [from_vertex, to_vertex]: route)
+        {
+            RoadSegment curr_road = roadmap.edgeInfo(from_vertex, to_vertex);
+            std::cout << "  Continue to " << roadmap.vertexInfo(to_vertex);
+            printf(" (%.1f miles @ %.1fmph = ", curr_road.miles, curr_road.milesPerHour);
+            time = curr_road.miles/curr_road.milesPerHour;
+            total_time+=time;
+            print_converted_time(time); std::cout << ")" << std::endl;
+        }
+
+        std::cout << "Total time: ";
+        print_converted_time(total_time); std::cout << std::endl;
+    }
 }
 
 int main()
@@ -50,7 +108,6 @@ int main()
     std::vector<Trip> trip_vec = trip_reader.readTrips(reader);
     if(roadmap.isStronglyConnected())
     {
-        std::stack<int> shortest_path;
         for(const auto& t: trip_vec)
         {
             // std::cout << "Start Vertex: " << t.startVertex; 
@@ -61,57 +118,15 @@ int main()
             //     std::cout << " Trip Metric: Time" << std::endl; 
             if(t.metric == TripMetric::Distance)
             {
-                double total_dist = 0.0;
                 std::map<int, int> dist_map = roadmap.findShortestPaths(t.startVertex, [](RoadSegment r) {return r.miles;});
                 std::cout << "Shortest distance from " << roadmap.vertexInfo(t.startVertex) << " to " << roadmap.vertexInfo(t.endVertex) << std::endl;
-                std::cout << "  Begin at " << roadmap.vertexInfo(t.startVertex) << std::endl;
-                int curr_vertex = dist_map[t.endVertex];
-                shortest_path.push(t.endVertex);
-                while(roadmap.vertexInfo(curr_vertex) != roadmap.vertexInfo(t.startVertex))
-                {
-                    shortest_path.push(curr_vertex);
-                    curr_vertex = dist_map[curr_vertex];
-                }
-                
-                while(not shortest_path.empty())
-                {
-                    curr_vertex = shortest_path.top();
-                    std::cout << "  Continue to " << roadmap.vertexInfo(curr_vertex);
-                    printf(" (%.1f miles)\n", roadmap.edgeInfo(dist_map[curr_vertex], curr_vertex).miles);
-                    total_dist+=roadmap.edgeInfo(dist_map[curr_vertex], curr_vertex).miles;
-                    shortest_path.pop();
-                }
-                printf("Total distance: %.1f miles\n", total_dist);
+                print_distance_route(roadmap, t.startVertex, trace_route(dist_map, t.startVertex, t.endVertex));
             }
             else if (t.metric == TripMetric::Time)
             {
-                double total_time = 0.0;
                 std::map<int, int> time_map = roadmap.findShortestPaths(t.startVertex, [](RoadSegment r){return r.miles/r.milesPerHour;});
                 std::cout << "Shortest driving time from " << roadmap.vertexInfo(t.startVertex) << " to " << roadmap.vertexInfo(t.endVertex) << std::endl;
-                std::cout << "  Begin at " << roadmap.vertexInfo(t.startVertex) << std::endl;
-                int curr_vertex = time_map[t.endVertex];
-                double time;
-                shortest_path.push(t.endVertex);
-                while(roadmap.vertexInfo(curr_vertex) != roadmap.vertexInfo(t.startVertex))
-                {
-                    shortest_path.push(curr_vertex);
-                    curr_vertex = time_map[curr_vertex];
-                }
-
-                while(not shortest_path.empty())
-                {
-                    curr_vertex = shortest_path.top();
-                    std::cout << "  Continue to " << roadmap.vertexInfo(curr_vertex);
-                    RoadSegment curr_road = roadmap.edgeInfo(time_map[curr_vertex], curr_vertex);
-                    printf(" (%.1f miles @ %.1fmph = ", curr_road.miles, curr_road.milesPerHour);
-                    time = curr_road.miles/curr_road.milesPerHour;
-                    total_time+=time;
-                    print_converted_time(time); std::cout << ")" << std::endl;
-                    shortest_path.pop();
-                }
-
-                std::cout << "Total time: ";
-                print_converted_time(total_time); std::cout << std::endl;
+                print_time_route(roadmap, t.startVertex, trace_route(time_map, t.startVertex, t.endVertex));
             }
             std::cout << std::endl;
         }
@@ -124,4 +139,3 @@ int main()
 
     return 0;
 }
-
@@ -30,6 +30,8 @@
 #include <string>
 #include <limits>
 #include <queue>
+#include <set>
+#include <algorithm>
 
 
 
@@ -244,6 +246,35 @@ public:
         int startVertex,
         std::function<double(const EdgeInfo&)> edgeWeightFunc) const;
 
+    // findKShortestPaths() returns up to k loopless paths from the start
+    // vertex to the end vertex, ordered from shortest to longest according
+    // to the given edge weight function (Yen's algorithm).  Each path is a
+    // std::vector of ("from", "to") vertex number pairs, one per edge, in
+    // the order they are travelled.  Fewer than k paths are returned if
+    // the graph doesn't have that many; none are returned if the end
+    // vertex is unreachable.  If either vertex does not exist, a
+    // DigraphException is thrown instead.
+    //
+    // A single shortest-path tree toward the end vertex is built up front
+    // and reused by every spur search: whenever a spur vertex's tree path
+    // avoids the edges and vertices Yen's algorithm has ruled out, it is
+    // used directly, and otherwise its distances guide an A* search.
+    std::vector<std::vector<std::pair<int, int>>> findKShortestPaths(
+        int startVertex, int endVertex, unsigned int k,
+        std::function<double(const EdgeInfo&)> edgeWeightFunc) const;
+
+    // findEarliestArrivals() is the time-dependent counterpart of
+    // findShortestPaths().  Leaving the start vertex at the given departure
+    // time, it determines the earliest time at which every other vertex can
+    // be reached, where travelTimeFunc(einfo, t) returns the time needed to
+    // traverse an edge entered at time t.  The travel times must respect
+    // FIFO (entering an edge later never means leaving it earlier), which
+    // is what keeps Dijkstra's algorithm correct.  The result is a map of
+    // predecessors in the same form findShortestPaths() returns.
+    std::map<int, int> findEarliestArrivals(
+        int startVertex, double departureTime,
+        std::function<double(const EdgeInfo&, double)> travelTimeFunc) const;
+
 
 private:
     // Add whatever member variables you think you need here.  One
@@ -261,6 +292,14 @@ private:
     int count_reachable_vertices(std::map<int, DigraphVertex<VertexInfo, EdgeInfo>>& copy_adj_list, int vertex) const;
     void set_up_copy_map(std::map<int, DigraphVertex<VertexInfo,EdgeInfo>>& copy_map, int startVertex) const;
 
+    double edge_weight(int fromVertex, int toVertex, const std::function<double(const EdgeInfo&)>& edgeWeightFunc) const;
+    void build_tree_to_end(int endVertex, const std::function<double(const EdgeInfo&)>& edgeWeightFunc,
+        std::map<int, double>& dist_to_end, std::map<int, int>& next_toward_end) const;
+    bool find_spur_path(int spurVertex, int endVertex, const std::set<int>& blocked_vertices,
+        const std::set<std::pair<int, int>>& blocked_edges, const std::map<int, double>& dist_to_end,
+        const std::map<int, int>& next_toward_end, const std::function<double(const EdgeInfo&)>& edgeWeightFunc,
+        std::vector<int>& spur_path, double& spur_cost) const;
+
 
 };
 
@@ -322,6 +361,143 @@ int Digraph<VertexInfo, EdgeInfo>::count_reachable_vertices(std::map<int, Digrap
 
 }
 
+template<typename VertexInfo, typename EdgeInfo>
+double Digraph<VertexInfo, EdgeInfo>::edge_weight(int fromVertex, int toVertex, const std::function<double(const EdgeInfo&)>& edgeWeightFunc) const
+{
+    for(const DigraphEdge<EdgeInfo>& e: adj_list.at(fromVertex).edges)
+    {
+        if(e.toVertex == toVertex)
+            return edgeWeightFunc(e.einfo);
+    }
+    throw DigraphException("Edge not found");
+}
+
+// Runs Dijkstra's algorithm backward from the end vertex, so dist_to_end
+// holds each vertex's distance to the end vertex and next_toward_end holds
+// the next vertex along that shortest path.  Vertices that can't reach the
+// end vertex are left out of both maps.
+template<typename VertexInfo, typename EdgeInfo>
+void Digraph<VertexInfo, EdgeInfo>::build_tree_to_end(int endVertex, const std::function<double(const EdgeInfo&)>& edgeWeightFunc,
+    std::map<int, double>& dist_to_end, std::map<int, int>& next_toward_end) const
+{
+    std::map<int, std::vector<std::pair<int, double>>> reverse_edges;
+    for(const auto& [key, value]: adj_list)
+    {
+        for(const DigraphEdge<EdgeInfo>& e: value.edges)
+        {
+            reverse_edges[e.toVertex].push_back(std::make_pair(key, edgeWeightFunc(e.einfo)));
+        }
+    }
+
+    using QueueEntry = std::pair<double, int>;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> pq;
+    std::set<int> done;
+    dist_to_end[endVertex] = 0.0;
+    pq.push(std::make_pair(0.0, endVertex));
+
+    while(not pq.empty())
+    {
+        auto [dist, key] = pq.top();
+        pq.pop();
+        if(not done.insert(key).second)
+            continue;
+
+        for(const auto& [from, weight]: reverse_edges[key])
+        {
+            auto found = dist_to_end.find(from);
+            if(found == dist_to_end.end() || found->second > dist + weight)
+            {
+                dist_to_end[from] = dist + weight;
+                next_toward_end[from] = key;
+                pq.push(std::make_pair(dist + weight, from));
+            }
+        }
+    }
+}
+
+// Finds the shortest path from the spur vertex to the end vertex that
+// avoids the blocked vertices and edges.  The tree path is tried first,
+// since it's optimal whenever nothing on it is blocked; otherwise an A*
+// search runs, with the tree distances as its (consistent) heuristic.
+template<typename VertexInfo, typename EdgeInfo>
+bool Digraph<VertexInfo, EdgeInfo>::find_spur_path(int spurVertex, int endVertex, const std::set<int>& blocked_vertices,
+    const std::set<std::pair<int, int>>& blocked_edges, const std::map<int, double>& dist_to_end,
+    const std::map<int, int>& next_toward_end, const std::function<double(const EdgeInfo&)>& edgeWeightFunc,
+    std::vector<int>& spur_path, double& spur_cost) const
+{
+    spur_path.clear();
+    if(dist_to_end.count(spurVertex) == 0)
+        return false;
+
+    bool tree_path_usable = true;
+    spur_path.push_back(spurVertex);
+    for(int curr = spurVertex; curr != endVertex; )
+    {
+        int next = next_toward_end.at(curr);
+        if(blocked_vertices.count(next) || blocked_edges.count(std::make_pair(curr, next)))
+        {
+            tree_path_usable = false;
+            break;
+        }
+        spur_path.push_back(next);
+        curr = next;
+    }
+    if(tree_path_usable)
+    {
+        spur_cost = dist_to_end.at(spurVertex);
+        return true;
+    }
+
+    using QueueEntry = std::pair<double, int>;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> pq;
+    std::map<int, double> dist_from_spur;
+    std::map<int, int> previous;
+    std::set<int> done;
+    dist_from_spur[spurVertex] = 0.0;
+    pq.push(std::make_pair(dist_to_end.at(spurVertex), spurVertex));
+
+    while(not pq.empty())
+    {
+        int key = pq.top().second;
+        pq.pop();
+        if(not done.insert(key).second)
+            continue;
+        if(key == endVertex)
+            break;
+
+        double dist = dist_from_spur[key];
+        for(const DigraphEdge<EdgeInfo>& e: adj_list.at(key).edges)
+        {
+            auto estimate = dist_to_end.find(e.toVertex);
+            if(estimate == dist_to_end.end() || blocked_vertices.count(e.toVertex)
+                || blocked_edges.count(std::make_pair(key, e.toVertex)))
+                continue;
+
+            double new_dist = dist + edgeWeightFunc(e.einfo);
+            auto found = dist_from_spur.find(e.toVertex);
+            if(found == dist_from_spur.end() || found->second > new_dist)
+            {
+                dist_from_spur[e.toVertex] = new_dist;
+                previous[e.toVertex] = key;
+                pq.push(std::make_pair(new_dist + estimate->second, e.toVertex));
+            }
+        }
+    }
+
+    if(done.count(endVertex) == 0)
+        return false;
+
+    spur_path.clear();
+    for(int curr = endVertex; curr != spurVertex; curr = previous.at(curr))
+    {
+        spur_path.push_back(curr);
+    }
+    spur_path.push_back(spurVertex);
+    std::reverse(spur_path.begin(), spur_path.end());
+    spur_cost = dist_from_spur.at(endVertex);
+    return true;
+}
+
 
 
 // You'll need to implement the member functions below.  There's enough
@@ -610,6 +786,117 @@ std::map<int, int> Digraph<VertexInfo, EdgeInfo>::findShortestPaths(
 }
 
 
+template <typename VertexInfo, typename EdgeInfo>
+std::vector<std::vector<std::pair<int, int>>> Digraph<VertexInfo, EdgeInfo>::findKShortestPaths(
+    int startVertex, int endVertex, unsigned int k,
+    std::function<double(const EdgeInfo&)> edgeWeightFunc) const
+{
+    check_vertex_existence(startVertex);
+    check_vertex_existence(endVertex);
+    std::vector<std::vector<std::pair<int, int>>> results;
+
+    std::map<int, double> dist_to_end;
+    std::map<int, int> next_toward_end;
+    build_tree_to_end(endVertex, edgeWeightFunc, dist_to_end, next_toward_end);
+
+    std::vector<int> first_path;
+    double first_cost;
+    if(k == 0 || not find_spur_path(startVertex, endVertex, {}, {}, dist_to_end, next_toward_end, edgeWeightFunc, first_path, first_cost))
+        return results;
+
+    std::vector<std::vector<int>> paths{first_path};
+    std::set<std::vector<int>> found_paths{first_path};
+    std::set<std::pair<double, std::vector<int>>> candidates;
+
+    while(paths.size() < k)
+    {
+        const std::vector<int> last = paths.back();
+        double root_cost = 0.0;
+        for(unsigned int i = 0; i + 1 < last.size(); i++)
+        {
+            std::set<std::pair<int, int>> blocked_edges;
+            for(const std::vector<int>& p: paths)
+            {
+                if(p.size() > i + 1 && std::equal(last.begin(), last.begin() + i + 1, p.begin()))
+                    blocked_edges.insert(std::make_pair(p[i], p[i+1]));
+            }
+            std::set<int> blocked_vertices(last.begin(), last.begin() + i);
+
+            std::vector<int> spur_path;
+            double spur_cost;
+            if(find_spur_path(last[i], endVertex, blocked_vertices, blocked_edges, dist_to_end, next_toward_end, edgeWeightFunc, spur_path, spur_cost))
+            {
+                std::vector<int> candidate(last.begin(), last.begin() + i);
+                candidate.insert(candidate.end(), spur_path.begin(), spur_path.end());
+                if(found_paths.count(candidate) == 0)
+                    candidates.insert(std::make_pair(root_cost + spur_cost, candidate));
+            }
+            root_cost += edge_weight(last[i], last[i+1], edgeWeightFunc);
+        }
+
+        if(candidates.empty())
+            break;
+        paths.push_back(candidates.begin()->second);
+        found_paths.insert(candidates.begin()->second);
+        candidates.erase(candidates.begin());
+    }
+
+    for(const std::vector<int>& p: paths)
+    {
+        std::vector<std::pair<int, int>> edge_path;
+        for(unsigned int i = 0; i + 1 < p.size(); i++)
+        {
+            edge_path.push_back(std::make_pair(p[i], p[i+1]));
+        }
+        results.push_back(edge_path);
+    }
+    return results;
+}
+
+
+
+template <typename VertexInfo, typename EdgeInfo>
+std::map<int, int> Digraph<VertexInfo, EdgeInfo>::findEarliestArrivals(
+    int startVertex, double departureTime,
+    std::function<double(const EdgeInfo&, double)> travelTimeFunc) const
+{
+    check_vertex_existence(startVertex);
+    std::map<int, int> results;
+    for(const auto& [key, value]: adj_list)
+    {
+        results[key] = key;
+    }
+
+    using QueueEntry = std::pair<double, int>;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> pq;
+    std::map<int, double> arrival;
+    std::set<int> done;
+    arrival[startVertex] = departureTime;
+    pq.push(std::make_pair(departureTime, startVertex));
+
+    while(not pq.empty())
+    {
+        auto [time, key] = pq.top();
+        pq.pop();
+        if(not done.insert(key).second)
+            continue;
+
+        for(const DigraphEdge<EdgeInfo>& e: adj_list.at(key).edges)
+        {
+            double new_arrival = time + travelTimeFunc(e.einfo, time);
+            auto found = arrival.find(e.toVertex);
+            if(found == arrival.end() || found->second > new_arrival)
+            {
+                arrival[e.toVertex] = new_arrival;
+                results[e.toVertex] = key;
+                pq.push(std::make_pair(new_arrival, e.toVertex));
+            }
+        }
+    }
+    return results;
+}
+
+
 
 #endif
 
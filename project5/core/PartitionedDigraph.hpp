@@ -0,0 +1,830 @@
+// PartitionedDigraph.hpp
+//
+// ICS 46 Spring 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// A PartitionedDigraph is a read-only directed graph that lives on disk
+// rather than in memory, for graphs too large to hold in a Digraph.  The
+// vertices are split into "cells" by vertex number (so vertices numbered
+// close together, which on a road map usually means geographically close
+// together, share a cell), each with its outgoing edges, and each cell is
+// stored in its own file.  Cells are memory-mapped on demand and kept in
+// a least-recently-used cache of a fixed number of cells, so only the
+// part of the graph a search is actually touching needs to be resident.
+//
+// A PartitionedDigraphWriter builds the cell files.  It spills vertices
+// and edges to per-cell files as they're added, buffering no more than a
+// fixed number of bytes across all of them, and then builds the cells one
+// at a time, so it never needs the whole graph in memory either.
+//
+// EdgeInfo must be trivially copyable (it's stored as raw bytes), as must
+// VertexInfo, unless it's a std::string.
+
+#ifndef PARTITIONEDDIGRAPH_HPP
+#define PARTITIONEDDIGRAPH_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <queue>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "Digraph.hpp"
+
+
+
+namespace partitioned::detail
+{
+    // Every cell file begins with this header, followed by one
+    // CellVertexRecord per vertex (sorted by vertex number), then the
+    // edges (a to-vertex and an EdgeInfo each, grouped by from-vertex),
+    // then the encoded VertexInfo objects.
+    struct CellHeader
+    {
+        std::uint32_t magic;
+        std::uint32_t vertexCount;
+        std::uint32_t edgeCount;
+        std::uint32_t reserved;
+    };
+
+    struct CellVertexRecord
+    {
+        std::int32_t vertex;
+        std::uint32_t firstEdge;
+        std::uint32_t edgeCount;
+        std::uint32_t infoOffset;
+    };
+
+    constexpr std::uint32_t MAGIC = 0x44434c31;
+
+
+    template <typename T>
+    void encode(std::string& out, const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>,
+            "PartitionedDigraph can only store trivially copyable types and std::string");
+        out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    inline void encode(std::string& out, const std::string& value)
+    {
+        std::uint32_t length = value.size();
+        encode(out, length);
+        out.append(value);
+    }
+
+    template <typename T>
+    void decode(const char*& in, T& value)
+    {
+        std::memcpy(&value, in, sizeof(T));
+        in += sizeof(T);
+    }
+
+    inline void decode(const char*& in, std::string& value)
+    {
+        std::uint32_t length;
+        decode(in, length);
+        value.assign(in, length);
+        in += length;
+    }
+
+    // decodeWithin() is decode() for bytes that may be corrupt: it returns
+    // false, rather than reading anything, if the value would run past end.
+    template <typename T>
+    bool decodeWithin(const char*& in, const char* end, T& value)
+    {
+        if(static_cast<std::size_t>(end - in) < sizeof(T))
+        {
+            return false;
+        }
+        decode(in, value);
+        return true;
+    }
+
+    inline bool decodeWithin(const char*& in, const char* end, std::string& value)
+    {
+        const char* start = in;
+        std::uint32_t length;
+        if(not decodeWithin(in, end, length) || static_cast<std::size_t>(end - in) < length)
+        {
+            in = start;
+            return false;
+        }
+        value.assign(in, length);
+        in += length;
+        return true;
+    }
+
+
+    inline int cellOf(int vertex, int verticesPerCell)
+    {
+        return vertex >= 0 ? vertex / verticesPerCell : -((-(vertex + 1)) / verticesPerCell) - 1;
+    }
+
+    inline std::string cellPath(const std::string& directory, int cell, const std::string& extension)
+    {
+        return directory + "/cell_" + std::to_string(cell) + extension;
+    }
+
+    inline std::string readFile(const std::string& path)
+    {
+        std::ifstream in{path, std::ios::binary};
+        if(not in)
+        {
+            return "";
+        }
+        return std::string{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+    }
+
+
+    // A read-only memory mapping of one cell file, unmapped when destroyed.
+    // The file is checked when it's mapped: its length has to cover the
+    // records and edges its header counts, and every record's edges and
+    // info have to lie within it, or a DigraphException is thrown.
+    class MappedCell
+    {
+    public:
+        MappedCell(const std::string& path, std::size_t edgeRecordSize)
+        {
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if(fd < 0)
+            {
+                throw DigraphException("Cannot open cell file " + path);
+            }
+            struct stat info;
+            if(::fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(CellHeader)))
+            {
+                ::close(fd);
+                throw DigraphException("Cell file is truncated: " + path);
+            }
+            length = info.st_size;
+            void* mapped = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if(mapped == MAP_FAILED)
+            {
+                throw DigraphException("Cannot map cell file " + path);
+            }
+            bytes = static_cast<const char*>(mapped);
+
+            std::memcpy(&header, bytes, sizeof(header));
+            if(header.magic != MAGIC)
+            {
+                ::munmap(const_cast<char*>(bytes), length);
+                throw DigraphException("Not a cell file: " + path);
+            }
+            if(not valid(edgeRecordSize))
+            {
+                ::munmap(const_cast<char*>(bytes), length);
+                throw DigraphException("Cell file is corrupt: " + path);
+            }
+        }
+
+        ~MappedCell() noexcept
+        {
+            ::munmap(const_cast<char*>(bytes), length);
+        }
+
+        MappedCell(const MappedCell&) = delete;
+        MappedCell& operator=(const MappedCell&) = delete;
+
+        const CellVertexRecord* records() const
+        {
+            return reinterpret_cast<const CellVertexRecord*>(bytes + sizeof(header));
+        }
+
+        const CellVertexRecord* findVertex(int vertex) const
+        {
+            const CellVertexRecord* first = records();
+            const CellVertexRecord* last = first + header.vertexCount;
+            const CellVertexRecord* found = std::lower_bound(first, last, vertex,
+                [](const CellVertexRecord& r, int v) {return r.vertex < v;});
+            return (found != last && found->vertex == vertex) ? found : nullptr;
+        }
+
+        const char* edgesBegin() const
+        {
+            return bytes + sizeof(header) + header.vertexCount * sizeof(CellVertexRecord);
+        }
+
+        const char* infosBegin(std::size_t edgeRecordSize) const
+        {
+            return edgesBegin() + header.edgeCount * edgeRecordSize;
+        }
+
+        const char* end() const
+        {
+            return bytes + length;
+        }
+
+    private:
+        const char* bytes;
+        std::size_t length;
+        CellHeader header;
+
+        bool valid(std::size_t edgeRecordSize) const
+        {
+            // The counts are 32 bits, so none of this can overflow 64 bits.
+            std::uint64_t records_end = sizeof(header)
+                + std::uint64_t{header.vertexCount} * sizeof(CellVertexRecord);
+            std::uint64_t edges_end = records_end + std::uint64_t{header.edgeCount} * edgeRecordSize;
+            if(edges_end > length)
+            {
+                return false;
+            }
+
+            std::uint64_t infos_length = length - edges_end;
+            for(std::uint32_t i = 0; i < header.vertexCount; i++)
+            {
+                const CellVertexRecord& r = records()[i];
+                if(std::uint64_t{r.firstEdge} + r.edgeCount > header.edgeCount
+                    || r.infoOffset > infos_length
+                    || (i > 0 && r.vertex <= records()[i-1].vertex))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+}
+
+
+
+// A PartitionedDigraphWriter writes a graph into a directory of cell files
+// that a PartitionedDigraph can open.  Vertices and edges are added in any
+// order; nothing is readable until finish() has been called.
+
+template <typename VertexInfo, typename EdgeInfo>
+class PartitionedDigraphWriter
+{
+public:
+    // The default number of bytes of vertices and edges buffered in
+    // memory, across all cells, before the largest buffer is spilled.
+    static constexpr std::size_t DEFAULT_SPILL_BUDGET = 4 * 1024 * 1024;
+
+    // Initializes a writer that will store the graph in the given
+    // directory, which must already exist and be empty, with
+    // verticesPerCell consecutive vertex numbers in each cell, buffering
+    // at most spillBudget bytes before writing to the per-cell files.
+    PartitionedDigraphWriter(const std::string& directory, int verticesPerCell,
+        std::size_t spillBudget = DEFAULT_SPILL_BUDGET);
+
+    // addVertex() adds a vertex with the given vertex number and VertexInfo.
+    void addVertex(int vertex, const VertexInfo& vinfo);
+
+    // addEdge() adds an edge from the given "from" vertex to the given "to"
+    // vertex.  Edges are stored in the cell of their "from" vertex.
+    void addEdge(int fromVertex, int toVertex, const EdgeInfo& einfo);
+
+    // addDigraph() adds every vertex and edge of an in-memory Digraph.
+    void addDigraph(const Digraph<VertexInfo, EdgeInfo>& d);
+
+    // finish() builds the cell files and the directory's metadata, one cell
+    // at a time.  A DigraphException is thrown if a vertex was added twice,
+    // an edge was added twice, or an edge's "from" vertex was never added.
+    // (Edges to vertices that were never added are kept, but can never be
+    // followed anywhere.)
+    void finish();
+
+    // bufferedBytes() returns the number of bytes of vertices and edges
+    // currently buffered in memory, which never exceeds the spill budget.
+    std::size_t bufferedBytes() const noexcept;
+
+private:
+    // A cell file's buffer is also spilled once it alone reaches this
+    // size, so that busy cells are written in reasonably large pieces.
+    static constexpr std::size_t SPILL_THRESHOLD = 64 * 1024;
+
+    std::string directory;
+    int verticesPerCell;
+    std::size_t spill_budget;
+    int vertex_count;
+    int edge_count;
+    std::set<int> cells;
+
+    // Buffers are kept by path, and also ordered by size (with a pointer
+    // to their path) so the largest can be found when over budget.
+    std::map<std::string, std::string> spill_buffers;
+    std::set<std::pair<std::size_t, const std::string*>> buffers_by_size;
+    std::size_t buffered_bytes;
+
+    void spill(const std::string& path, const std::string& bytes);
+    void flush(std::map<std::string, std::string>::iterator buffer);
+    void build_cell(int cell);
+};
+
+
+
+// A PartitionedDigraph opens a directory written by a PartitionedDigraphWriter.
+// Its member functions behave like their Digraph counterparts, throwing a
+// DigraphException for vertices or edges that don't exist.
+
+template <typename VertexInfo, typename EdgeInfo>
+class PartitionedDigraph
+{
+public:
+    // The default number of cells kept mapped at once.
+    static constexpr unsigned int DEFAULT_CACHED_CELLS = 64;
+
+    // Opens the partitioned graph stored in the given directory, keeping
+    // at most cachedCells cells mapped at any given time.
+    explicit PartitionedDigraph(const std::string& directory, unsigned int cachedCells = DEFAULT_CACHED_CELLS);
+
+    PartitionedDigraph(const PartitionedDigraph& d) = delete;
+    PartitionedDigraph& operator=(const PartitionedDigraph& d) = delete;
+
+    int vertexCount() const noexcept;
+    int edgeCount() const noexcept;
+
+    // cellCount() returns the number of cells the graph is split into.
+    int cellCount() const noexcept;
+
+    VertexInfo vertexInfo(int vertex) const;
+    EdgeInfo edgeInfo(int fromVertex, int toVertex) const;
+    std::vector<std::pair<int, int>> edges(int vertex) const;
+
+    // findShortestPaths() works as it does in Digraph, paging cells in as
+    // the search reaches them.  Since the whole graph may not fit in
+    // memory, the result only includes the vertices the search reached.
+    std::map<int, int> findShortestPaths(
+        int startVertex,
+        std::function<double(const EdgeInfo&)> edgeWeightFunc) const;
+
+    // cacheHits() and cacheMisses() count how many cell lookups were
+    // served by an already-mapped cell and how many had to map one.
+    unsigned long long cacheHits() const noexcept;
+    unsigned long long cacheMisses() const noexcept;
+    void resetCacheStatistics() noexcept;
+
+private:
+    using MappedCell = partitioned::detail::MappedCell;
+    using VertexRecord = partitioned::detail::CellVertexRecord;
+
+    static constexpr std::size_t EDGE_RECORD_SIZE = sizeof(std::int32_t) + sizeof(EdgeInfo);
+
+    std::string directory;
+    unsigned int cachedCells;
+    int verticesPerCell;
+    int vertex_count;
+    int edge_count;
+    std::set<int> cells;
+
+    // The cache is an LRU list of cell numbers, most recently used first,
+    // along with a map from cell number to its mapping and list position.
+    mutable std::list<int> lru_order;
+    mutable std::map<int, std::pair<std::unique_ptr<MappedCell>, std::list<int>::iterator>> cache;
+    mutable unsigned long long hits;
+    mutable unsigned long long misses;
+
+    const MappedCell& get_cell(int cell) const;
+    const VertexRecord& get_vertex(const MappedCell& cell, int vertex) const;
+};
+
+
+
+template <typename VertexInfo, typename EdgeInfo>
+PartitionedDigraphWriter<VertexInfo, EdgeInfo>::PartitionedDigraphWriter(const std::string& directory, int verticesPerCell,
+    std::size_t spillBudget)
+    : directory{directory}, verticesPerCell{verticesPerCell}, spill_budget{spillBudget},
+      vertex_count{0}, edge_count{0}, buffered_bytes{0}
+{
+    static_assert(std::is_trivially_copyable_v<EdgeInfo>, "PartitionedDigraph needs a trivially copyable EdgeInfo");
+    if(verticesPerCell <= 0)
+    {
+        throw DigraphException("verticesPerCell must be positive");
+    }
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+void PartitionedDigraphWriter<VertexInfo, EdgeInfo>::addVertex(int vertex, const VertexInfo& vinfo)
+{
+    int cell = partitioned::detail::cellOf(vertex, verticesPerCell);
+    std::string bytes;
+    partitioned::detail::encode(bytes, vertex);
+    partitioned::detail::encode(bytes, vinfo);
+    spill(partitioned::detail::cellPath(directory, cell, ".vtx"), bytes);
+    cells.insert(cell);
+    vertex_count++;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+void PartitionedDigraphWriter<VertexInfo, EdgeInfo>::addEdge(int fromVertex, int toVertex, const EdgeInfo& einfo)
+{
+    int cell = partitioned::detail::cellOf(fromVertex, verticesPerCell);
+    std::string bytes;
+    partitioned::detail::encode(bytes, fromVertex);
+    partitioned::detail::encode(bytes, toVertex);
+    partitioned::detail::encode(bytes, einfo);
+    spill(partitioned::detail::cellPath(directory, cell, ".edg"), bytes);
+    cells.insert(cell);
+    edge_count++;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+void PartitionedDigraphWriter<VertexInfo, EdgeInfo>::addDigraph(const Digraph<VertexInfo, EdgeInfo>& d)
+{
+    for(int vertex: d.vertices())
+    {
+        addVertex(vertex, d.vertexInfo(vertex));
+    }
+    for(const auto& [from, to]: d.edges())
+    {
+        addEdge(from, to, d.edgeInfo(from, to));
+    }
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+void PartitionedDigraphWriter<VertexInfo, EdgeInfo>::finish()
+{
+    while(not spill_buffers.empty())
+    {
+        flush(spill_buffers.begin());
+    }
+
+    for(int cell: cells)
+    {
+        build_cell(cell);
+    }
+
+    std::ofstream meta{directory + "/graph.meta"};
+    meta << verticesPerCell << " " << vertex_count << " " << edge_count << " " << cells.size() << std::endl;
+    for(int cell: cells)
+    {
+        meta << cell << std::endl;
+    }
+    if(not meta)
+    {
+        throw DigraphException("Cannot write " + directory + "/graph.meta");
+    }
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+std::size_t PartitionedDigraphWriter<VertexInfo, EdgeInfo>::bufferedBytes() const noexcept
+{
+    return buffered_bytes;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+void PartitionedDigraphWriter<VertexInfo, EdgeInfo>::spill(const std::string& path, const std::string& bytes)
+{
+    auto [buffer, inserted] = spill_buffers.try_emplace(path);
+    if(not inserted)
+    {
+        buffers_by_size.erase(std::make_pair(buffer->second.size(), &buffer->first));
+    }
+    buffer->second += bytes;
+    buffered_bytes += bytes.size();
+
+    if(buffer->second.size() >= SPILL_THRESHOLD)
+    {
+        flush(buffer);
+    }
+    else
+    {
+        buffers_by_size.insert(std::make_pair(buffer->second.size(), &buffer->first));
+    }
+
+    while(buffered_bytes > spill_budget)
+    {
+        flush(spill_buffers.find(*buffers_by_size.rbegin()->second));
+    }
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+void PartitionedDigraphWriter<VertexInfo, EdgeInfo>::flush(std::map<std::string, std::string>::iterator buffer)
+{
+    const std::string& path = buffer->first;
+    std::ofstream out{path, std::ios::binary | std::ios::app};
+    out.write(buffer->second.data(), buffer->second.size());
+    if(not out)
+    {
+        throw DigraphException("Cannot write " + path);
+    }
+
+    // The buffer is erased, not just cleared, so its memory is released.
+    buffers_by_size.erase(std::make_pair(buffer->second.size(), &path));
+    buffered_bytes -= buffer->second.size();
+    spill_buffers.erase(buffer);
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+void PartitionedDigraphWriter<VertexInfo, EdgeInfo>::build_cell(int cell)
+{
+    std::string vertex_path = partitioned::detail::cellPath(directory, cell, ".vtx");
+    std::string edge_path = partitioned::detail::cellPath(directory, cell, ".edg");
+
+    std::vector<std::pair<int, VertexInfo>> cell_vertices;
+    std::string vertex_bytes = partitioned::detail::readFile(vertex_path);
+    for(const char* in = vertex_bytes.data(); in < vertex_bytes.data() + vertex_bytes.size(); )
+    {
+        std::pair<int, VertexInfo> v;
+        partitioned::detail::decode(in, v.first);
+        partitioned::detail::decode(in, v.second);
+        cell_vertices.push_back(std::move(v));
+    }
+    std::sort(cell_vertices.begin(), cell_vertices.end(),
+        [](const auto& a, const auto& b) {return a.first < b.first;});
+
+    std::vector<DigraphEdge<EdgeInfo>> cell_edges;
+    std::string edge_bytes = partitioned::detail::readFile(edge_path);
+    for(const char* in = edge_bytes.data(); in < edge_bytes.data() + edge_bytes.size(); )
+    {
+        DigraphEdge<EdgeInfo> e;
+        partitioned::detail::decode(in, e.fromVertex);
+        partitioned::detail::decode(in, e.toVertex);
+        partitioned::detail::decode(in, e.einfo);
+        cell_edges.push_back(e);
+    }
+    std::stable_sort(cell_edges.begin(), cell_edges.end(),
+        [](const auto& a, const auto& b) {return std::make_pair(a.fromVertex, a.toVertex) < std::make_pair(b.fromVertex, b.toVertex);});
+
+    std::string records;
+    std::string edges;
+    std::string infos;
+    unsigned int edge_index = 0;
+    for(unsigned int i = 0; i < cell_vertices.size(); i++)
+    {
+        if(i > 0 && cell_vertices[i].first == cell_vertices[i-1].first)
+        {
+            throw DigraphException("Vertex number already in Digraph");
+        }
+
+        partitioned::detail::CellVertexRecord record{cell_vertices[i].first, edge_index, 0,
+            static_cast<std::uint32_t>(infos.size())};
+        partitioned::detail::encode(infos, cell_vertices[i].second);
+
+        for(; edge_index < cell_edges.size() && cell_edges[edge_index].fromVertex == record.vertex; edge_index++)
+        {
+            const DigraphEdge<EdgeInfo>& e = cell_edges[edge_index];
+            if(record.edgeCount > 0 && cell_edges[edge_index-1].toVertex == e.toVertex)
+            {
+                throw DigraphException("Edge exists already");
+            }
+            std::int32_t to = e.toVertex;
+            partitioned::detail::encode(edges, to);
+            partitioned::detail::encode(edges, e.einfo);
+            record.edgeCount++;
+        }
+        if(edge_index < cell_edges.size() && cell_edges[edge_index].fromVertex < record.vertex)
+        {
+            throw DigraphException("fromVertex not found");
+        }
+        partitioned::detail::encode(records, record);
+    }
+    if(edge_index < cell_edges.size())
+    {
+        throw DigraphException("fromVertex not found");
+    }
+
+    partitioned::detail::CellHeader header{partitioned::detail::MAGIC,
+        static_cast<std::uint32_t>(cell_vertices.size()), static_cast<std::uint32_t>(cell_edges.size()), 0};
+    std::string cell_path = partitioned::detail::cellPath(directory, cell, ".bin");
+    std::ofstream out{cell_path, std::ios::binary | std::ios::trunc};
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(records.data(), records.size());
+    out.write(edges.data(), edges.size());
+    out.write(infos.data(), infos.size());
+    if(not out)
+    {
+        throw DigraphException("Cannot write " + cell_path);
+    }
+
+    std::remove(vertex_path.c_str());
+    std::remove(edge_path.c_str());
+}
+
+
+
+template <typename VertexInfo, typename EdgeInfo>
+PartitionedDigraph<VertexInfo, EdgeInfo>::PartitionedDigraph(const std::string& directory, unsigned int cachedCells)
+    : directory{directory}, cachedCells{std::max(cachedCells, 1u)}, hits{0}, misses{0}
+{
+    std::ifstream meta{directory + "/graph.meta"};
+    int cell_count;
+    if(not (meta >> verticesPerCell >> vertex_count >> edge_count >> cell_count))
+    {
+        throw DigraphException("Cannot read " + directory + "/graph.meta");
+    }
+    for(int i = 0, cell; i < cell_count && meta >> cell; i++)
+    {
+        cells.insert(cell);
+    }
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+int PartitionedDigraph<VertexInfo, EdgeInfo>::vertexCount() const noexcept
+{
+    return vertex_count;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+int PartitionedDigraph<VertexInfo, EdgeInfo>::edgeCount() const noexcept
+{
+    return edge_count;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+int PartitionedDigraph<VertexInfo, EdgeInfo>::cellCount() const noexcept
+{
+    return cells.size();
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+VertexInfo PartitionedDigraph<VertexInfo, EdgeInfo>::vertexInfo(int vertex) const
+{
+    const MappedCell& cell = get_cell(partitioned::detail::cellOf(vertex, verticesPerCell));
+    const char* in = cell.infosBegin(EDGE_RECORD_SIZE) + get_vertex(cell, vertex).infoOffset;
+    VertexInfo vinfo;
+    if(not partitioned::detail::decodeWithin(in, cell.end(), vinfo))
+    {
+        throw DigraphException("Cell file is corrupt: vertex info runs past the end");
+    }
+    return vinfo;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+EdgeInfo PartitionedDigraph<VertexInfo, EdgeInfo>::edgeInfo(int fromVertex, int toVertex) const
+{
+    const MappedCell& cell = get_cell(partitioned::detail::cellOf(fromVertex, verticesPerCell));
+    const VertexRecord& record = get_vertex(cell, fromVertex);
+    const char* in = cell.edgesBegin() + record.firstEdge * EDGE_RECORD_SIZE;
+    for(unsigned int i = 0; i < record.edgeCount; i++)
+    {
+        std::int32_t to;
+        EdgeInfo einfo;
+        partitioned::detail::decode(in, to);
+        partitioned::detail::decode(in, einfo);
+        if(to == toVertex)
+        {
+            return einfo;
+        }
+    }
+    throw DigraphException("Edge not found");
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+std::vector<std::pair<int, int>> PartitionedDigraph<VertexInfo, EdgeInfo>::edges(int vertex) const
+{
+    const MappedCell& cell = get_cell(partitioned::detail::cellOf(vertex, verticesPerCell));
+    const VertexRecord& record = get_vertex(cell, vertex);
+    std::vector<std::pair<int, int>> edges_vec;
+    const char* in = cell.edgesBegin() + record.firstEdge * EDGE_RECORD_SIZE;
+    for(unsigned int i = 0; i < record.edgeCount; i++, in += EDGE_RECORD_SIZE)
+    {
+        std::int32_t to;
+        std::memcpy(&to, in, sizeof(to));
+        edges_vec.push_back(std::make_pair(vertex, to));
+    }
+    return edges_vec;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+std::map<int, int> PartitionedDigraph<VertexInfo, EdgeInfo>::findShortestPaths(
+    int startVertex,
+    std::function<double(const EdgeInfo&)> edgeWeightFunc) const
+{
+    get_vertex(get_cell(partitioned::detail::cellOf(startVertex, verticesPerCell)), startVertex);
+
+    std::map<int, int> results;
+    std::map<int, double> shortest_path;
+    std::set<int> done;
+    using QueueEntry = std::pair<double, int>;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> pq;
+    results[startVertex] = startVertex;
+    shortest_path[startVertex] = 0.0;
+    pq.push(std::make_pair(0.0, startVertex));
+
+    while(not pq.empty())
+    {
+        auto [dist, key] = pq.top();
+        pq.pop();
+        if(not done.insert(key).second)
+            continue;
+
+        int cell_number = partitioned::detail::cellOf(key, verticesPerCell);
+        if(cells.count(cell_number) == 0)
+            continue;
+        const MappedCell& cell = get_cell(cell_number);
+        const VertexRecord* record = cell.findVertex(key);
+        if(record == nullptr)
+            continue;
+
+        const char* in = cell.edgesBegin() + record->firstEdge * EDGE_RECORD_SIZE;
+        for(unsigned int i = 0; i < record->edgeCount; i++)
+        {
+            std::int32_t to;
+            EdgeInfo einfo;
+            partitioned::detail::decode(in, to);
+            partitioned::detail::decode(in, einfo);
+
+            double new_dist = dist + edgeWeightFunc(einfo);
+            auto found = shortest_path.find(to);
+            if(found == shortest_path.end() || found->second > new_dist)
+            {
+                shortest_path[to] = new_dist;
+                results[to] = key;
+                pq.push(std::make_pair(new_dist, to));
+            }
+        }
+    }
+    return results;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+unsigned long long PartitionedDigraph<VertexInfo, EdgeInfo>::cacheHits() const noexcept
+{
+    return hits;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+unsigned long long PartitionedDigraph<VertexInfo, EdgeInfo>::cacheMisses() const noexcept
+{
+    return misses;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+void PartitionedDigraph<VertexInfo, EdgeInfo>::resetCacheStatistics() noexcept
+{
+    hits = 0;
+    misses = 0;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+const partitioned::detail::MappedCell& PartitionedDigraph<VertexInfo, EdgeInfo>::get_cell(int cell) const
+{
+    auto found = cache.find(cell);
+    if(found != cache.end())
+    {
+        hits++;
+        lru_order.splice(lru_order.begin(), lru_order, found->second.second);
+        return *found->second.first;
+    }
+
+    if(cells.count(cell) == 0)
+    {
+        throw DigraphException("Vertex not found");
+    }
+
+    misses++;
+    std::unique_ptr<MappedCell> mapped = std::make_unique<MappedCell>(
+        partitioned::detail::cellPath(directory, cell, ".bin"), EDGE_RECORD_SIZE);
+    if(cache.size() >= cachedCells)
+    {
+        cache.erase(lru_order.back());
+        lru_order.pop_back();
+    }
+    lru_order.push_front(cell);
+    auto& entry = cache[cell];
+    entry.first = std::move(mapped);
+    entry.second = lru_order.begin();
+    return *entry.first;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+const partitioned::detail::CellVertexRecord& PartitionedDigraph<VertexInfo, EdgeInfo>::get_vertex(const MappedCell& cell, int vertex) const
+{
+    const VertexRecord* record = cell.findVertex(vertex);
+    if(record == nullptr)
+    {
+        throw DigraphException("Vertex not found");
+    }
+    return *record;
+}
+
+
+
+#endif
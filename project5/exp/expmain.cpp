@@ -7,11 +7,156 @@
 // with your code, outside of the context of the broader program or Google
 // Test.
 
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string>
+#include "../app/RoadMap.hpp"
+#include "../app/SpeedProfile.hpp"
+#include "PartitionedDigraph.hpp"
+
+
+namespace
+{
+    // Builds a width x height grid of two-way roads with random lengths
+    // and speeds, which is a reasonable stand-in for a large city map.
+    RoadMap build_grid_map(int width, int height)
+    {
+        std::default_random_engine engine{46};
+        std::uniform_real_distribution<double> miles{0.1, 2.0};
+        std::uniform_real_distribution<double> speed{25.0, 65.0};
+
+        RoadMap roadmap;
+        for(int i = 0; i < width * height; i++)
+        {
+            roadmap.addVertex(i, "Intersection " + std::to_string(i));
+        }
+        for(int row = 0; row < height; row++)
+        {
+            for(int col = 0; col < width; col++)
+            {
+                int v = row * width + col;
+                if(col + 1 < width)
+                {
+                    RoadSegment r{miles(engine), speed(engine)};
+                    roadmap.addEdge(v, v + 1, r);
+                    roadmap.addEdge(v + 1, v, r);
+                }
+                if(row + 1 < height)
+                {
+                    RoadSegment r{miles(engine), speed(engine)};
+                    roadmap.addEdge(v, v + width, r);
+                    roadmap.addEdge(v + width, v, r);
+                }
+            }
+        }
+        return roadmap;
+    }
+
+
+    void benchmark_k_shortest_paths(const RoadMap& roadmap, int start_vertex, int end_vertex)
+    {
+        for(unsigned int k = 3; k <= 10; k++)
+        {
+            auto start = std::chrono::steady_clock::now();
+            auto routes = roadmap.findKShortestPaths(start_vertex, end_vertex, k,
+                [](const RoadSegment& r) {return r.miles/r.milesPerHour;});
+            auto end = std::chrono::steady_clock::now();
+            std::cout << "k = " << k << ": " << routes.size() << " routes in "
+                << std::chrono::duration<double, std::milli>(end - start).count() << " ms" << std::endl;
+        }
+    }
+
+
+    // Assigns every road one of a few shared speed profiles and compares
+    // time-dependent routing at several departure times against the static
+    // miles/milesPerHour weights.
+    void benchmark_time_dependent(RoadMap roadmap, int start_vertex)
+    {
+        SpeedProfileTable profiles;
+        profiles.addProfile(SpeedProfile{{{0.0, 1.0}}});
+        profiles.addProfile(SpeedProfile{{{0.0, 1.0}, {7.0, 1.0}, {8.0, 0.4}, {10.0, 1.0}, {16.0, 1.0}, {17.5, 0.3}, {19.0, 1.0}}});
+        profiles.addProfile(SpeedProfile{{{3.0, 1.1}, {12.0, 0.7}, {20.0, 0.9}}});
+
+        std::default_random_engine engine{46};
+        std::uniform_int_distribution<int> pick{0, profiles.profileCount() - 1};
+        RoadMap td_roadmap;
+        for(int v: roadmap.vertices())
+        {
+            td_roadmap.addVertex(v, roadmap.vertexInfo(v));
+        }
+        for(const auto& [from, to]: roadmap.edges())
+        {
+            RoadSegment r = roadmap.edgeInfo(from, to);
+            r.speedProfile = pick(engine);
+            td_roadmap.addEdge(from, to, r);
+        }
+        std::cout << profiles.profileCount() << " shared profiles for " << td_roadmap.edgeCount()
+            << " segments (" << sizeof(RoadSegment) << " bytes per segment)" << std::endl;
+
+        auto start = std::chrono::steady_clock::now();
+        td_roadmap.findShortestPaths(start_vertex, [](const RoadSegment& r) {return r.miles/r.milesPerHour;});
+        auto end = std::chrono::steady_clock::now();
+        std::cout << "static: " << std::chrono::duration<double, std::milli>(end - start).count() << " ms" << std::endl;
+
+        for(double departure: {3.0, 7.5, 17.0})
+        {
+            start = std::chrono::steady_clock::now();
+            td_roadmap.findEarliestArrivals(start_vertex, departure,
+                [&profiles](const RoadSegment& r, double t) {return profiles.travelTime(r, t);});
+            end = std::chrono::steady_clock::now();
+            std::cout << "departing at " << departure << ": "
+                << std::chrono::duration<double, std::milli>(end - start).count() << " ms" << std::endl;
+        }
+    }
+
+
+    // Writes the map out as cells and routes across it with caches of
+    // different sizes, reporting the time and cache behavior of each.
+    void benchmark_partitioned(const RoadMap& roadmap, int start_vertex, int vertices_per_cell)
+    {
+        std::filesystem::path dir = std::filesystem::temp_directory_path() / "partitioned_roadmap";
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir);
+
+        auto start = std::chrono::steady_clock::now();
+        PartitionedDigraphWriter<std::string, RoadSegment> writer{dir.string(), vertices_per_cell};
+        writer.addDigraph(roadmap);
+        writer.finish();
+        auto end = std::chrono::steady_clock::now();
+        std::cout << "wrote cells in " << std::chrono::duration<double, std::milli>(end - start).count() << " ms" << std::endl;
+
+        auto by_time = [](const RoadSegment& r) {return r.miles/r.milesPerHour;};
+        for(unsigned int cached_cells: {1u, 4u, 16u, 1000u})
+        {
+            PartitionedDigraph<std::string, RoadSegment> partitioned{dir.string(), cached_cells};
+            start = std::chrono::steady_clock::now();
+            partitioned.findShortestPaths(start_vertex, by_time);
+            end = std::chrono::steady_clock::now();
+            std::cout << cached_cells << " of " << partitioned.cellCount() << " cells cached: "
+                << std::chrono::duration<double, std::milli>(end - start).count() << " ms, "
+                << partitioned.cacheHits() << " hits, " << partitioned.cacheMisses() << " misses" << std::endl;
+        }
+        std::filesystem::remove_all(dir);
+    }
+}
+
 
 int main()
 {
+    // Building a grid map is slow (addVertex() and addEdge() are linear in
+    // the number of vertices), so keep it modest.
+    const int side = 60;
+    RoadMap roadmap = build_grid_map(side, side);
+    std::cout << "k-shortest routes corner to corner on a " << side << "x" << side << " grid" << std::endl;
+    benchmark_k_shortest_paths(roadmap, 0, side * side - 1);
 
+    std::cout << std::endl << "Time-dependent routing from one corner of the same grid" << std::endl;
+    benchmark_time_dependent(roadmap, 0);
+
+    std::cout << std::endl << "Routing over the same grid stored as cells of " << side * 4 << " vertices" << std::endl;
+    benchmark_partitioned(roadmap, 0, side * 4);
 
     return 0;
 }
-
@@ -0,0 +1,104 @@
+// Digraph_RoutingTests.cpp
+//
+// ICS 46 Spring 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// Unit tests for the routing features layered on top of Digraph, beyond
+// the single shortest path that findShortestPaths() produces.
+
+#include <map>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "Digraph.hpp"
+
+
+namespace
+{
+    // A small "ladder" with three distinct routes from 0 to 3:
+    //     0 -> 1 -> 3   (cost 2)
+    //     0 -> 2 -> 3   (cost 4)
+    //     0 -> 1 -> 2 -> 3   (cost 5)
+    Digraph<int, double> buildLadder()
+    {
+        Digraph<int, double> d;
+        for (int i = 0; i < 4; ++i)
+        {
+            d.addVertex(i, i);
+        }
+        d.addEdge(0, 1, 1.0);
+        d.addEdge(1, 3, 1.0);
+        d.addEdge(0, 2, 2.0);
+        d.addEdge(2, 3, 2.0);
+        d.addEdge(1, 2, 2.0);
+        return d;
+    }
+
+    double weight(const double& w)
+    {
+        return w;
+    }
+}
+
+
+TEST(Digraph_RoutingTests, kShortestPathsAreInOrderOfCost)
+{
+    Digraph<int, double> d = buildLadder();
+    std::vector<std::vector<std::pair<int, int>>> paths = d.findKShortestPaths(0, 3, 3, weight);
+
+    ASSERT_EQ(3, paths.size());
+
+    std::vector<std::pair<int, int>> first{{0, 1}, {1, 3}};
+    std::vector<std::pair<int, int>> second{{0, 2}, {2, 3}};
+    std::vector<std::pair<int, int>> third{{0, 1}, {1, 2}, {2, 3}};
+    EXPECT_EQ(first, paths[0]);
+    EXPECT_EQ(second, paths[1]);
+    EXPECT_EQ(third, paths[2]);
+}
+
+
+TEST(Digraph_RoutingTests, kShortestPathsStopsWhenRoutesRunOut)
+{
+    Digraph<int, double> d = buildLadder();
+    EXPECT_EQ(3, d.findKShortestPaths(0, 3, 10, weight).size());
+    EXPECT_EQ(0, d.findKShortestPaths(3, 0, 10, weight).size());
+    EXPECT_EQ(0, d.findKShortestPaths(0, 3, 0, weight).size());
+}
+
+
+TEST(Digraph_RoutingTests, kShortestPathsRejectsMissingVertices)
+{
+    Digraph<int, double> d = buildLadder();
+    EXPECT_THROW(d.findKShortestPaths(0, 9, 3, weight), DigraphException);
+}
+
+
+TEST(Digraph_RoutingTests, earliestArrivalsDependOnDepartureTime)
+{
+    // The direct edge 0 -> 2 is fast before time 10 and very slow after;
+    // the detour through 1 always takes 4.
+    Digraph<int, int> d;
+    d.addVertex(0, 0);
+    d.addVertex(1, 1);
+    d.addVertex(2, 2);
+    d.addEdge(0, 2, 0);
+    d.addEdge(0, 1, 1);
+    d.addEdge(1, 2, 1);
+
+    auto travelTime = [](const int& kind, double t)
+    {
+        if (kind == 0)
+        {
+            return t < 10.0 ? 1.0 : 20.0;
+        }
+        return 2.0;
+    };
+
+    std::map<int, int> early = d.findEarliestArrivals(0, 0.0, travelTime);
+    EXPECT_EQ(0, early[2]);
+    EXPECT_EQ(0, early[0]);
+
+    std::map<int, int> late = d.findEarliestArrivals(0, 12.0, travelTime);
+    EXPECT_EQ(1, late[2]);
+    EXPECT_EQ(0, late[1]);
+}
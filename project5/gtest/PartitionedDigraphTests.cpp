@@ -0,0 +1,214 @@
+// PartitionedDigraphTests.cpp
+//
+// ICS 46 Spring 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// Unit tests for PartitionedDigraph, checking that a graph written to
+// cell files reads back the same as the Digraph it came from.
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <system_error>
+#include <gtest/gtest.h>
+#include "Digraph.hpp"
+#include "PartitionedDigraph.hpp"
+
+
+namespace
+{
+    struct Road
+    {
+        double miles;
+        double speed;
+    };
+
+
+    // A fresh, empty directory that's removed, along with everything in
+    // it, at the end of the test.
+    class TemporaryDirectory
+    {
+    public:
+        explicit TemporaryDirectory(const std::string& name)
+            : dir{std::filesystem::temp_directory_path() / name}
+        {
+            std::filesystem::remove_all(dir);
+            std::filesystem::create_directories(dir);
+        }
+
+        ~TemporaryDirectory()
+        {
+            std::error_code ignored;
+            std::filesystem::remove_all(dir, ignored);
+        }
+
+        TemporaryDirectory(const TemporaryDirectory&) = delete;
+        TemporaryDirectory& operator=(const TemporaryDirectory&) = delete;
+
+        const std::filesystem::path& path() const
+        {
+            return dir;
+        }
+
+        std::string string() const
+        {
+            return dir.string();
+        }
+
+    private:
+        std::filesystem::path dir;
+    };
+
+
+    // Builds a one-way ring of n vertices with a shortcut from 0 to n/2,
+    // written out with two vertices per cell into the given directory.
+    std::string writeRing(const TemporaryDirectory& dir, int n, Digraph<std::string, Road>& d)
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            d.addVertex(i, "v" + std::to_string(i));
+        }
+        for (int i = 0; i < n; ++i)
+        {
+            d.addEdge(i, (i + 1) % n, Road{1.0, 10.0});
+        }
+        d.addEdge(0, n / 2, Road{2.0, 1.0});
+
+        PartitionedDigraphWriter<std::string, Road> writer{dir.string(), 2};
+        writer.addDigraph(d);
+        writer.finish();
+        return dir.string();
+    }
+}
+
+
+TEST(PartitionedDigraphTests, readsBackWhatWasWritten)
+{
+    TemporaryDirectory dir{"pd_readsBack"};
+    Digraph<std::string, Road> d;
+    PartitionedDigraph<std::string, Road> p{writeRing(dir, 9, d)};
+
+    EXPECT_EQ(9, p.vertexCount());
+    EXPECT_EQ(10, p.edgeCount());
+    EXPECT_EQ(5, p.cellCount());
+    EXPECT_EQ("v7", p.vertexInfo(7));
+    EXPECT_EQ(2.0, p.edgeInfo(0, 4).miles);
+    EXPECT_EQ(2, p.edges(0).size());
+    EXPECT_THROW(p.vertexInfo(42), DigraphException);
+    EXPECT_THROW(p.edgeInfo(1, 5), DigraphException);
+}
+
+
+TEST(PartitionedDigraphTests, shortestPathsMatchInMemoryDigraph)
+{
+    TemporaryDirectory dir{"pd_shortestPaths"};
+    Digraph<std::string, Road> d;
+    PartitionedDigraph<std::string, Road> p{writeRing(dir, 12, d), 2};
+
+    auto byTime = [](const Road& r) {return r.miles / r.speed;};
+    EXPECT_EQ(d.findShortestPaths(0, byTime), p.findShortestPaths(0, byTime));
+
+    auto byDistance = [](const Road& r) {return r.miles;};
+    EXPECT_EQ(d.findShortestPaths(3, byDistance), p.findShortestPaths(3, byDistance));
+
+    EXPECT_GT(p.cacheMisses(), 0);
+    EXPECT_GT(p.cacheHits(), 0);
+}
+
+
+TEST(PartitionedDigraphTests, writerRejectsDuplicateVertices)
+{
+    TemporaryDirectory dir{"pd_duplicates"};
+
+    PartitionedDigraphWriter<int, Road> writer{dir.string(), 4};
+    writer.addVertex(1, 1);
+    writer.addVertex(1, 2);
+    EXPECT_THROW(writer.finish(), DigraphException);
+}
+
+
+TEST(PartitionedDigraphTests, writerBuffersNoMoreThanItsBudget)
+{
+    TemporaryDirectory dir{"pd_budget"};
+
+    // Every cell's buffer stays far below the per-cell threshold, so only
+    // the budget makes the writer spill before finish().
+    Digraph<std::string, Road> d;
+    PartitionedDigraphWriter<std::string, Road> writer{dir.string(), 1, 1024};
+    for (int i = 0; i < 300; ++i)
+    {
+        d.addVertex(i, "vertex number " + std::to_string(i));
+        writer.addVertex(i, d.vertexInfo(i));
+        ASSERT_LE(writer.bufferedBytes(), 1024);
+    }
+    for (int i = 0; i < 300; ++i)
+    {
+        for (int j : {1, 7, 31})
+        {
+            d.addEdge(i, (i + j) % 300, Road{static_cast<double>(j), 10.0});
+            writer.addEdge(i, (i + j) % 300, d.edgeInfo(i, (i + j) % 300));
+            ASSERT_LE(writer.bufferedBytes(), 1024);
+        }
+    }
+    EXPECT_FALSE(std::filesystem::is_empty(dir.path()));
+
+    writer.finish();
+    EXPECT_EQ(0, writer.bufferedBytes());
+
+    PartitionedDigraph<std::string, Road> p{dir.string(), 8};
+    EXPECT_EQ(300, p.vertexCount());
+    EXPECT_EQ(900, p.edgeCount());
+    EXPECT_EQ("vertex number 123", p.vertexInfo(123));
+
+    auto byDistance = [](const Road& r) {return r.miles;};
+    EXPECT_EQ(d.findShortestPaths(5, byDistance), p.findShortestPaths(5, byDistance));
+}
+
+
+TEST(PartitionedDigraphTests, corruptCellFilesAreRejected)
+{
+    TemporaryDirectory dir{"pd_corrupt"};
+    Digraph<std::string, Road> d;
+    writeRing(dir, 4, d);
+    std::filesystem::path cell = dir.path() / "cell_0.bin";
+    std::string original = partitioned::detail::readFile(cell.string());
+
+    auto rewrite = [&cell](const std::string& bytes)
+    {
+        std::ofstream out{cell, std::ios::binary | std::ios::trunc};
+        out.write(bytes.data(), bytes.size());
+    };
+
+    // Cut off in the middle of the edges.
+    rewrite(original.substr(0, sizeof(partitioned::detail::CellHeader) + 40));
+    {
+        PartitionedDigraph<std::string, Road> p{dir.string()};
+        EXPECT_THROW(p.edges(0), DigraphException);
+    }
+
+    // Cut off in the middle of the last vertex's info.
+    rewrite(original.substr(0, original.size() - 1));
+    {
+        PartitionedDigraph<std::string, Road> p{dir.string()};
+        EXPECT_EQ("v0", p.vertexInfo(0));
+        EXPECT_THROW(p.vertexInfo(1), DigraphException);
+    }
+
+    // A header that claims far more edges than the file holds.
+    std::string inflated = original;
+    partitioned::detail::CellHeader header;
+    std::memcpy(&header, inflated.data(), sizeof(header));
+    header.edgeCount = 1000000;
+    std::memcpy(&inflated[0], &header, sizeof(header));
+    rewrite(inflated);
+    {
+        PartitionedDigraph<std::string, Road> p{dir.string()};
+        EXPECT_THROW(p.vertexInfo(0), DigraphException);
+    }
+
+    rewrite(original);
+    PartitionedDigraph<std::string, Road> p{dir.string()};
+    EXPECT_EQ("v1", p.vertexInfo(1));
+}
@@ -0,0 +1,179 @@
+// SpeedProfileTests.cpp
+//
+// ICS 46 Spring 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// Unit tests for SpeedProfile and SpeedProfileTable.
+
+#include <cmath>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+#include "Digraph.hpp"
+#include "RoadSegment.hpp"
+#include "SpeedProfile.hpp"
+
+
+namespace
+{
+    // Free-flow until 7am, half speed at 8am, back to free-flow by 10am.
+    SpeedProfile rushHour()
+    {
+        return SpeedProfile{{{0.0, 1.0}, {7.0, 1.0}, {8.0, 0.5}, {10.0, 1.0}}};
+    }
+}
+
+
+TEST(SpeedProfileTests, rejectsBadBreakpoints)
+{
+    EXPECT_THROW(SpeedProfile{{}}, std::invalid_argument);
+    EXPECT_THROW((SpeedProfile{{{24.0, 1.0}}}), std::invalid_argument);
+    EXPECT_THROW((SpeedProfile{{{-1.0, 1.0}}}), std::invalid_argument);
+    EXPECT_THROW((SpeedProfile{{{3.0, 0.0}}}), std::invalid_argument);
+    EXPECT_THROW((SpeedProfile{{{3.0, 1.0}, {3.0, 0.5}}}), std::invalid_argument);
+}
+
+
+TEST(SpeedProfileTests, speedFactorIsInterpolatedBetweenBreakpoints)
+{
+    SpeedProfile p = rushHour();
+    EXPECT_DOUBLE_EQ(1.0, p.speedFactorAt(3.0));
+    EXPECT_DOUBLE_EQ(1.0, p.speedFactorAt(7.0));
+    EXPECT_DOUBLE_EQ(0.75, p.speedFactorAt(7.5));
+    EXPECT_DOUBLE_EQ(0.5, p.speedFactorAt(8.0));
+    EXPECT_DOUBLE_EQ(0.75, p.speedFactorAt(9.0));
+    EXPECT_DOUBLE_EQ(0.75, p.speedFactorAt(24.0 * 3 + 9.0));
+}
+
+
+TEST(SpeedProfileTests, speedFactorWrapsAroundAtMidnight)
+{
+    // From 0.5 at 10pm to 1.0 at 2am the next day.
+    SpeedProfile p{{{2.0, 1.0}, {22.0, 0.5}}};
+    EXPECT_DOUBLE_EQ(0.5, p.speedFactorAt(22.0));
+    EXPECT_DOUBLE_EQ(0.75, p.speedFactorAt(24.0));
+    EXPECT_DOUBLE_EQ(0.75, p.speedFactorAt(0.0));
+    EXPECT_DOUBLE_EQ(0.875, p.speedFactorAt(1.0));
+    EXPECT_DOUBLE_EQ(0.625, p.speedFactorAt(23.0));
+
+    // A trip across midnight is slower than the same trip from 2am.
+    EXPECT_GT(p.travelTime(10.0, 10.0, 23.0), 1.0);
+    EXPECT_GT(p.travelTime(10.0, 10.0, 23.0), p.travelTime(10.0, 10.0, 2.0));
+}
+
+
+TEST(SpeedProfileTests, singleBreakpointIsConstant)
+{
+    SpeedProfile p{{{5.0, 0.5}}};
+    EXPECT_DOUBLE_EQ(0.5, p.speedFactorAt(0.0));
+    EXPECT_DOUBLE_EQ(0.5, p.speedFactorAt(5.0));
+    EXPECT_DOUBLE_EQ(0.5, p.speedFactorAt(100.0));
+
+    // 150 miles at 30 mph * 0.5 takes 10 hours, across several pieces.
+    EXPECT_NEAR(10.0, p.travelTime(150.0, 30.0, 0.0), 1e-9);
+    EXPECT_NEAR(200.0, p.travelTime(3000.0, 30.0, 4.0), 1e-9);
+}
+
+
+TEST(SpeedProfileTests, travelTimeIntegratesTheSpeed)
+{
+    SpeedProfile p = rushHour();
+
+    // Free-flow all the way.
+    EXPECT_DOUBLE_EQ(1.0, p.travelTime(60.0, 60.0, 12.0));
+
+    // From 8am the factor rises from 0.5 to 1.0 over two hours, covering
+    // 60 * 0.75 * 2 = 90 miles.
+    EXPECT_NEAR(2.0, p.travelTime(90.0, 60.0, 8.0), 1e-9);
+}
+
+
+TEST(SpeedProfileTests, travelTimeEndsWithFractionalBreakpointsDaysLater)
+{
+    // Leaving 48.1 hours in, the trip crosses breakpoints whose absolute
+    // times don't round to the same value as their time of day.
+    SpeedProfile p{{{0.1001, 1.0}, {7.4001, 0.5}}};
+    double hours = p.travelTime(5.0, 30.0, 48.1);
+    EXPECT_GT(hours, 5.0 / 30.0);
+    EXPECT_LT(hours, 5.0 / 15.0);
+
+    for (double departure = 24.0 * 5; departure < 24.0 * 8; departure += 0.37)
+    {
+        double t = p.travelTime(500.0, 30.0, departure);
+        ASSERT_GT(t, 500.0 / 30.0);
+        ASSERT_LT(t, 500.0 / 15.0);
+    }
+}
+
+
+TEST(SpeedProfileTests, tripsThatCanNeverEndTakeForever)
+{
+    SpeedProfile profile = rushHour();
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double inf = std::numeric_limits<double>::infinity();
+
+    EXPECT_TRUE(std::isinf(profile.travelTime(10.0, 0.0, 7.5)));
+    EXPECT_TRUE(std::isinf(profile.travelTime(10.0, -60.0, 7.5)));
+    EXPECT_TRUE(std::isinf(profile.travelTime(10.0, nan, 7.5)));
+    EXPECT_TRUE(std::isinf(profile.travelTime(nan, 60.0, 7.5)));
+    EXPECT_TRUE(std::isinf(profile.travelTime(inf, 60.0, 7.5)));
+    EXPECT_TRUE(std::isinf(profile.travelTime(10.0, 60.0, inf)));
+}
+
+
+TEST(SpeedProfileTests, leavingLaterNeverArrivesEarlier)
+{
+    SpeedProfile p{{{0.1001, 1.0}, {7.4001, 0.2}, {9.25, 1.3}, {17.0, 0.3}, {19.5, 1.0}}};
+
+    double lastArrival = 0.0;
+    for (double departure = 0.0; departure < 24.0 * 3; departure += 0.05)
+    {
+        double arrival = departure + p.travelTime(25.0, 50.0, departure);
+        ASSERT_GE(arrival, lastArrival - 1e-9);
+        lastArrival = arrival;
+    }
+}
+
+
+TEST(SpeedProfileTests, tableUsesEachSegmentsProfile)
+{
+    SpeedProfileTable table;
+    EXPECT_EQ(0, table.addProfile(SpeedProfile{{{0.0, 0.5}}}));
+    EXPECT_EQ(1, table.addProfile(rushHour()));
+    EXPECT_EQ(2, table.profileCount());
+
+    EXPECT_DOUBLE_EQ(2.0, table.travelTime(RoadSegment{60.0, 30.0}, 8.0));
+    EXPECT_DOUBLE_EQ(4.0, table.travelTime(RoadSegment{60.0, 30.0, 0}, 8.0));
+    EXPECT_NEAR(2.0, table.travelTime(RoadSegment{90.0, 60.0, 1}, 8.0), 1e-9);
+    EXPECT_THROW(table.travelTime(RoadSegment{1.0, 1.0, 2}, 0.0), std::out_of_range);
+}
+
+
+TEST(SpeedProfileTests, earliestArrivalsFollowTheProfiles)
+{
+    // The direct road 0 -> 2 crawls during rush hour; the detour through
+    // 1 is longer but always free-flowing.
+    SpeedProfileTable table;
+    int jammed = table.addProfile(SpeedProfile{{{0.0, 1.0}, {7.0, 1.0}, {7.5, 0.1}, {9.5, 0.1}, {10.0, 1.0}}});
+
+    Digraph<int, RoadSegment> d;
+    d.addVertex(0, 0);
+    d.addVertex(1, 1);
+    d.addVertex(2, 2);
+    d.addEdge(0, 2, RoadSegment{30.0, 60.0, jammed});
+    d.addEdge(0, 1, RoadSegment{25.0, 60.0});
+    d.addEdge(1, 2, RoadSegment{25.0, 60.0});
+
+    auto travelTime = [&table](const RoadSegment& segment, double t)
+    {
+        return table.travelTime(segment, t);
+    };
+
+    std::map<int, int> night = d.findEarliestArrivals(0, 48.1, travelTime);
+    EXPECT_EQ(0, night[2]);
+
+    std::map<int, int> rush = d.findEarliestArrivals(0, 48.0 + 8.0, travelTime);
+    EXPECT_EQ(1, rush[2]);
+}